@@ -1,11 +1,21 @@
 #include "MonitorPanel.h"
 #include "CoffeeEngine/Core/DataStructures/CircularBuffer.h"
+#include "CoffeeEngine/Core/FileDialog.h"
+#include "CoffeeEngine/Core/FrameProfiler.h"
+#include "CoffeeEngine/Core/MemoryTracker.h"
 #include "CoffeeEngine/Core/SystemInfo.h"
+#include "CoffeeEngine/Core/TelemetrySampler.h"
 #include "CoffeeEngine/Core/Application.h"
 #include "CoffeeEngine/Core/Timer.h"
+#include <algorithm>
 #include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <iterator>
 #include <imgui.h>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace Coffee {
 
@@ -72,6 +82,119 @@ namespace Coffee {
             ImGui::EndTable();
             ImGui::TreePop();
         }
+        // Memory per subsystem
+        if(ImGui::TreeNode("Memory Tags")) {
+            ImGui::Checkbox("Plot Memory Tags", &m_ShowMemoryTags);
+            if (!MemoryTracker::IsAllocatorTracked())
+                ImGui::TextDisabled("operator new is not tracked (COFFEE_MEMORY_TRACKING is off)");
+
+            ImGui::BeginTable("MemoryTagsTable", 5, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_BordersOuterV | ImGuiTableFlags_RowBg);
+            ImGui::TableSetupColumn("Tag", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Live (MB)", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Peak (MB)", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("GPU (MB)", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Allocs/s", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableHeadersRow();
+            for (size_t i = 0; i < m_MemoryTagHistory.size(); i++)
+            {
+                const MemoryTag tag = static_cast<MemoryTag>(i);
+                const MemoryTagStats stats = MemoryTracker::GetStats(tag);
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(MemoryTracker::GetTagName(tag));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", stats.LiveBytes / (1024.0f * 1024.0f));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", stats.PeakBytes / (1024.0f * 1024.0f));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f", stats.GPUBytes / (1024.0f * 1024.0f));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.0f", m_MemoryTagHistory[i].AllocationRate);
+            }
+            ImGui::EndTable();
+            ImGui::TreePop();
+        }
+        // Telemetry
+        if(ImGui::TreeNode("Telemetry")) {
+            ImGui::Checkbox("Plot Telemetry", &m_ShowTelemetry);
+            ImGui::SetNextItemWidth(-FLT_MIN);
+            ImGui::Combo("##TelemetryWindow", &m_TelemetryWindow, "Last 1 s\0Last 10 s\0Last 60 s\0Whole history\0");
+
+            ImGui::BeginTable("TelemetryTable", 4, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_BordersOuterV | ImGuiTableFlags_RowBg);
+            ImGui::TableSetupColumn("Series", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Min", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Avg", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Max", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableHeadersRow();
+            const size_t window = GetTelemetryWindowSize();
+            TelemetrySampler::ReadHistory([window](const std::vector<TelemetrySeries>& series) {
+                for (const TelemetrySeries& s : series)
+                {
+                    const TelemetryWindow stats = s.GetWindow(window);
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%s %s", s.GetName().c_str(), s.GetUnit().c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.2f", stats.Min);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.2f", stats.Avg);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.2f", stats.Max);
+                }
+            });
+            ImGui::EndTable();
+
+            if (ImGui::Button("Export CSV"))
+            {
+                FileDialogArgs args;
+                args.Filters = {{"CSV", "csv"}};
+                args.DefaultName = "telemetry.csv";
+                const std::filesystem::path& path = FileDialog::SaveFile(args);
+
+                if (!path.empty())
+                    TelemetrySampler::ExportCSV(path);
+            }
+            ImGui::TreePop();
+        }
+        // Profiler
+        if(ImGui::TreeNode("Profiler")) {
+            ImGui::BeginTable("ProfilerTable", 2, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_BordersOuterV | ImGuiTableFlags_RowBg);
+            ImGui::TableSetupColumn("ProfilerColumn1", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("ProfilerColumn2", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Checkbox("Flame Graph", &m_ShowFlameGraph);
+            ImGui::TableNextColumn();
+            ImGui::Text("%u frames", FrameProfiler::GetFrameCount());
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            bool recording = FrameProfiler::IsEnabled();
+            if (ImGui::Checkbox("Record", &recording))
+                FrameProfiler::SetEnabled(recording);
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu dropped", (unsigned long long)FrameProfiler::GetDroppedZoneCount());
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Text("Spike Threshold");
+            ImGui::TableNextColumn();
+            float spikeThreshold = FrameProfiler::GetSpikeThreshold();
+            ImGui::SetNextItemWidth(-FLT_MIN);
+            if (ImGui::DragFloat("##SpikeThreshold", &spikeThreshold, 0.5f, 0.0f, 1000.0f, spikeThreshold > 0.0f ? "%.1f ms" : "Off"))
+                FrameProfiler::SetSpikeThreshold(spikeThreshold);
+            ImGui::EndTable();
+
+            if (ImGui::Button("Export Chrome Trace"))
+            {
+                FileDialogArgs args;
+                args.Filters = {{"Chrome Trace", "json"}};
+                args.DefaultName = "trace.json";
+                const std::filesystem::path& path = FileDialog::SaveFile(args);
+
+                if (!path.empty())
+                    FrameProfiler::ExportChromeTrace(path);
+            }
+            ImGui::TreePop();
+        }
         ImGui::EndChild();
 
         ImGui::NextColumn();
@@ -79,53 +202,179 @@ namespace Coffee {
         ImGui::BeginChild("RightColumn", {0,0}, ImGuiChildFlags_Border);
 
         // Second column
-        if (m_ShowFPS)
-        {
-            ImGui::Text("FPS");
-            std::string FPSoverlay = "FPS: " + std::to_string((int)FPS);
-            ImGui::PlotLines("##FPS", [](void* data, int idx) -> float {
-                return FPS;
-            }, NULL, 100, 0, FPSoverlay.c_str(), FLT_MIN, FLT_MAX, ImVec2(0, 80)); // Minimum height of 80
-        }
+        const size_t window = GetTelemetryWindowSize();
+        TelemetrySampler::ReadHistory([&](const std::vector<TelemetrySeries>& series) {
+            if (m_ShowFPS)
+                DrawTelemetrySeries(series[static_cast<size_t>(TelemetryChannel::FPS)], window);
+            if (m_ShowFrameTime)
+                DrawTelemetrySeries(series[static_cast<size_t>(TelemetryChannel::FrameTime)], window);
+            if (m_MemoryUsage)
+                DrawTelemetrySeries(series[static_cast<size_t>(TelemetryChannel::ResidentMemory)], window);
 
-        if (m_ShowFrameTime)
+            if (m_ShowTelemetry)
+            {
+                for (size_t i = static_cast<size_t>(TelemetryChannel::FrameTimeMax); i < series.size(); i++)
+                {
+                    if (i != static_cast<size_t>(TelemetryChannel::FPS) &&
+                        i != static_cast<size_t>(TelemetryChannel::ResidentMemory))
+                        DrawTelemetrySeries(series[i], window);
+                }
+            }
+        });
+
+        if (m_ShowMemoryTags)
         {
-            ImGui::Text("Frame Time");
-            std::string FrameTimeOverlay = "Frame Time: " + std::to_string(FrameTime) + " ms";
-            ImGui::PlotLines("##FrameTime", [](void* data, int idx) -> float {
-                return FrameTime;
-            }, NULL, 100, 0, FrameTimeOverlay.c_str(), FLT_MIN, FLT_MAX, ImVec2(0, 80)); // Minimum height of 80
+            ImGui::Text("Memory Tags");
+
+            for (size_t i = 0; i < m_MemoryTagHistory.size(); i++)
+            {
+                MemoryTagHistory& history = m_MemoryTagHistory[i];
+                if (history.MegaBytes.empty() || history.MegaBytes.back() <= 0.0f)
+                    continue;
+
+                char overlay[128];
+                snprintf(overlay, sizeof(overlay), "%s: %.2f MB, %.0f allocs/s", MemoryTracker::GetTagName(static_cast<MemoryTag>(i)),
+                         history.MegaBytes.back(), history.AllocationRate);
+
+                ImGui::PushID(static_cast<int>(i));
+                ImGui::PlotLines("##MemoryTag", [](void* data, int idx) -> float {
+                    return (*(CircularBuffer<float>*)data)[idx];
+                }, &history.MegaBytes, history.MegaBytes.size(), 0, overlay, 0.0f, FLT_MAX, ImVec2(0, 60));
+                ImGui::PopID();
+            }
         }
 
-        if (m_MemoryUsage)
+        const int frameCount = FrameProfiler::GetFrameCount();
+        if (m_ShowFlameGraph && frameCount > 0)
         {
-            ImGui::Text("Memory Usage");
+            ImGui::Text("Flame Graph");
 
-            //Test if this is better or is better to update the memory usage every x time
-            static CircularBuffer<uint64_t> memoryUsage(10000);
-
-            static Timer timer(0.5f, true, false, [&]() {
-                memoryUsage.push_back(MemoryUsage);
-            });
+            // While recording the history moves every frame, so only a stopped profiler keeps the selection.
+            if (FrameProfiler::IsEnabled() || m_SelectedFrame >= frameCount)
+                m_SelectedFrame = -1;
+            const int selected = m_SelectedFrame < 0 ? frameCount - 1 : m_SelectedFrame;
+            const ProfileFrame& frame = FrameProfiler::GetFrame(selected);
 
-            static float yMin = 0.0f;
-            static float yMax = 0.0f;
+            std::string FrameOverlay = "Frame " + std::to_string(frame.Number) + ": " +
+                                       std::to_string(FrameProfiler::ToMilliseconds(frame.End - frame.Start)) + " ms";
+            ImGui::PlotHistogram("##FrameHistory", [](void* data, int idx) -> float {
+                const ProfileFrame& frame = FrameProfiler::GetFrame(idx);
+                return FrameProfiler::ToMilliseconds(frame.End - frame.Start);
+            }, nullptr, frameCount, 0, FrameOverlay.c_str(), 0.0f, FLT_MAX, ImVec2(-FLT_MIN, 60));
 
-            std::string MemoryUsageOverlay = "";
-            if(memoryUsage.size() > 0)
+            // Clicking a bar selects its frame and stops recording so it stays in the history.
+            if (ImGui::IsItemClicked())
             {
-                MemoryUsageOverlay = "Memory Usage: " + std::to_string(memoryUsage.back()) + " MB";
+                const float x = (ImGui::GetMousePos().x - ImGui::GetItemRectMin().x) / ImGui::GetItemRectSize().x;
+                m_SelectedFrame = std::clamp((int)(x * frameCount), 0, frameCount - 1);
+                FrameProfiler::SetEnabled(false);
             }
-            ImGui::PlotLines("##MemoryUsage", [](void* data, int idx) -> float {
-                auto& memoryUsage = *(CircularBuffer<uint64_t>*)data;
-                uint64_t& mu = memoryUsage[idx];
-                if (mu > yMax - 100) yMax = mu + 100;
-                return mu;
-            }, &memoryUsage, memoryUsage.size(), 0, MemoryUsageOverlay.c_str(), yMin, yMax, ImVec2(0, 80)); // Minimum height of 80
+
+            DrawFlameGraph(frame);
         }
         ImGui::EndChild();
 
         ImGui::End();
     }
 
+    size_t MonitorPanel::GetTelemetryWindowSize() const
+    {
+        static constexpr double WindowSeconds[] = {1.0, 10.0, 60.0};
+        if (m_TelemetryWindow < 0 || m_TelemetryWindow >= (int)std::size(WindowSeconds))
+            return SIZE_MAX;
+        return std::max<size_t>((size_t)(WindowSeconds[m_TelemetryWindow] / TelemetrySampler::GetInterval()), 1);
+    }
+
+    void MonitorPanel::DrawTelemetrySeries(const TelemetrySeries& series, size_t window)
+    {
+        const size_t count = std::min(window, series.GetSize());
+        if (count == 0)
+            return;
+
+        const TelemetryWindow stats = series.GetWindow(count);
+        char overlay[160];
+        snprintf(overlay, sizeof(overlay), "%s: %.2f %s (min %.2f, avg %.2f, max %.2f)", series.GetName().c_str(),
+                 series.GetLast(), series.GetUnit().c_str(), stats.Min, stats.Avg, stats.Max);
+
+        // The getter only gets an index, so pass the series and the first sample of the window together.
+        struct PlotData
+        {
+            const TelemetrySeries* Series;
+            size_t First;
+        } data = {&series, series.GetSize() - count};
+
+        ImGui::PushID(series.GetName().c_str());
+        ImGui::PlotLines("##Telemetry", [](void* data, int idx) -> float {
+            const PlotData& plot = *(const PlotData*)data;
+            return (*plot.Series)[plot.First + idx];
+        }, &data, (int)count, 0, overlay, std::min(stats.Min, 0.0f), stats.Max * 1.1f, ImVec2(0, 80)); // Minimum height of 80
+        ImGui::PopID();
+    }
+
+    void MonitorPanel::SampleMemoryTags()
+    {
+        for (size_t i = 0; i < m_MemoryTagHistory.size(); i++)
+        {
+            const MemoryTagStats stats = MemoryTracker::GetStats(static_cast<MemoryTag>(i));
+            MemoryTagHistory& history = m_MemoryTagHistory[i];
+
+            history.MegaBytes.push_back((stats.LiveBytes + stats.GPUBytes) / (1024.0f * 1024.0f));
+            history.AllocationRate = (stats.Allocations - history.LastAllocations) / MemorySampleInterval;
+            history.LastAllocations = stats.Allocations;
+        }
+    }
+
+    void MonitorPanel::DrawFlameGraph(const ProfileFrame& frame)
+    {
+        const float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+        const float width = ImGui::GetContentRegionAvail().x;
+        const double frameStart = (double)frame.Start;
+        const double frameTicks = std::max((double)(frame.End - frame.Start), 1.0);
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+        // The zones are grouped by thread, so size each thread's lane by its deepest zone first.
+        std::vector<int> laneDepth(FrameProfiler::GetThreadCount(), 0);
+        for (const ProfileZone& zone : frame.Zones)
+            laneDepth[zone.ThreadIndex] = std::max(laneDepth[zone.ThreadIndex], zone.Depth + 1);
+
+        for (uint16_t thread = 0; thread < laneDepth.size(); thread++)
+        {
+            if (laneDepth[thread] == 0)
+                continue;
+
+            ImGui::TextUnformatted(FrameProfiler::GetThreadName(thread).c_str());
+            const ImVec2 origin = ImGui::GetCursorScreenPos();
+            ImGui::PushID(thread);
+            ImGui::InvisibleButton("##Lane", ImVec2(std::max(width, 1.0f), rowHeight * laneDepth[thread]));
+            ImGui::PopID();
+
+            for (const ProfileZone& zone : frame.Zones)
+            {
+                if (zone.ThreadIndex != thread)
+                    continue;
+
+                // Zones of other threads can start in the previous frame, clip them to this one.
+                const float start = std::clamp((float)((zone.Start - frameStart) / frameTicks), 0.0f, 1.0f);
+                const float end = std::clamp((float)((zone.End - frameStart) / frameTicks), 0.0f, 1.0f);
+
+                const ImVec2 min(origin.x + start * width, origin.y + zone.Depth * rowHeight);
+                const ImVec2 max(std::max(origin.x + end * width, min.x + 1.0f), min.y + rowHeight - 1.0f);
+
+                // Same name, same color, so a zone is easy to follow from frame to frame.
+                const float hue = (std::hash<std::string_view>{}(zone.Name) % 360) / 360.0f;
+                drawList->AddRectFilled(min, max, ImColor::HSV(hue, 0.45f, 0.75f));
+
+                if (max.x - min.x > ImGui::GetFontSize())
+                {
+                    drawList->PushClipRect(min, max, true);
+                    drawList->AddText(ImVec2(min.x + 2.0f, min.y + 2.0f), IM_COL32_BLACK, zone.Name);
+                    drawList->PopClipRect();
+                }
+
+                if (ImGui::IsMouseHoveringRect(min, max))
+                    ImGui::SetTooltip("%s\n%.3f ms", zone.Name, FrameProfiler::ToMilliseconds(zone.End - zone.Start));
+            }
+        }
+    }
+
 }
\ No newline at end of file
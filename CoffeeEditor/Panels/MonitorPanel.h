@@ -1,16 +1,71 @@
 #pragma once
 
 #include "Panels/Panel.h"
+#include "CoffeeEngine/Core/DataStructures/CircularBuffer.h"
+#include "CoffeeEngine/Core/MemoryTracker.h"
+#include "CoffeeEngine/Core/Timer.h"
+
+#include <array>
+#include <cstdint>
 
 namespace Coffee {
+    struct ProfileFrame;
+    class TelemetrySeries;
+
     class MonitorPanel : public Panel
     {
     public:
         MonitorPanel() = default;
         void OnImGuiRender() override;
     private:
+        /**
+         * Draws the zones of a frame as a flame graph, one lane per thread.
+         *
+         * @param frame The frame to draw.
+         */
+        void DrawFlameGraph(const ProfileFrame& frame);
+
+        /**
+         * Gets the number of samples the selected telemetry window spans.
+         *
+         * @return The number of samples, SIZE_MAX for the whole history.
+         */
+        size_t GetTelemetryWindowSize() const;
+
+        /**
+         * Plots the newest samples of a telemetry series, with its min, avg and max in the overlay.
+         *
+         * @param series The series to plot.
+         * @param window The number of samples to plot.
+         */
+        void DrawTelemetrySeries(const TelemetrySeries& series, size_t window);
+
+        /**
+         * Appends the current memory of every tag to its history and computes the allocation rates.
+         */
+        void SampleMemoryTags();
+
+        /**
+         * The sampled memory of a MemoryTag.
+         */
+        struct MemoryTagHistory
+        {
+            CircularBuffer<float> MegaBytes{600}; ///< CPU plus GPU memory, one sample every MemorySampleInterval.
+            float AllocationRate = 0.0f; ///< Allocations per second during the last interval.
+            uint64_t LastAllocations = 0;
+        };
+
+        static constexpr double MemorySampleInterval = 0.5;
+
         bool m_ShowFPS = true;
         bool m_ShowFrameTime = true;
         bool m_MemoryUsage = true;
+        bool m_ShowFlameGraph = false;
+        bool m_ShowMemoryTags = true;
+        bool m_ShowTelemetry = false;
+        int m_TelemetryWindow = 1; ///< Index of the window the stats are computed over: 1 s, 10 s, 60 s or everything.
+        int m_SelectedFrame = -1; ///< Index of the frame shown in the flame graph, -1 for the latest one.
+        std::array<MemoryTagHistory, static_cast<size_t>(MemoryTag::Count)> m_MemoryTagHistory;
+        Timer m_MemorySampleTimer{MemorySampleInterval, true, false, [this]() { SampleMemoryTags(); }};
     };
 }
\ No newline at end of file
@@ -14,7 +14,6 @@ namespace Coffee {
         if (!m_Visible) return;
 
         ImGui::Begin("Output", nullptr, ImGuiWindowFlags_HorizontalScrollbar);
-        const std::vector<std::string>& logBuffer = Coffee::Log::GetLogBuffer();
         /* for (const auto& log : logBuffer)
         {
             auto [before_level, level_str, after_level] = ParseLogMessage(log);
@@ -22,15 +21,13 @@ namespace Coffee {
             RenderLogMessage(before_level, level_str, after_level, level);
         } */
 
-        for (const std::string& log : logBuffer)
-        {
-            auto [before_level, level_str, after_level] = ParseLogMessage(log);
-            spdlog::level::level_enum level = spdlog::level::from_str(level_str);
-            
-            ImGui::PushStyleColor(ImGuiCol_Text, GetLogLevelColor(level));
+        Coffee::Log::GetLogBuffer().ForEach([this](const LogEntry& entry) {
+            auto [before_level, level_str, after_level] = ParseLogMessage(entry.Text);
+
+            ImGui::PushStyleColor(ImGuiCol_Text, GetLogLevelColor(entry.Level));
             ImGui::TextUnformatted(after_level.c_str());
             ImGui::PopStyleColor();
-        }
+        });
 
         if (ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
                 ImGui::SetScrollHereY(1.0f);
@@ -152,9 +152,15 @@ namespace Coffee {
 
         if (ImGui::BeginPopup("EntityPopup"/*, ImGuiWindowFlags_NoBackground*/))
         {
-            auto buff = entity.GetComponent<TagComponent>().Tag.c_str();
+            char buffer[256];
+            memset(buffer, 0, sizeof(buffer));
+            strncpy(buffer, entity.GetComponent<TagComponent>().Tag.c_str(), sizeof(buffer) - 1);
+
             ImGui::SetNextItemWidth(itemSize.x - ImGui::GetStyle().IndentSpacing);
-            ImGui::InputText("##entity-name", (char*)buff, 128);
+            if(ImGui::InputText("##entity-name", buffer, sizeof(buffer)))
+            {
+                entity.SetName(buffer);
+            }
             ImGui::EndPopup();
         }
 
@@ -212,7 +218,7 @@ namespace Coffee {
 
             if(ImGui::InputText("##", buffer, sizeof(buffer)))
             {
-                entityNameTag = std::string(buffer);
+                entity.SetName(buffer);
             }
 
             ImGui::Separator();
@@ -224,14 +230,21 @@ namespace Coffee {
 
             if(ImGui::CollapsingHeader("Transform", ImGuiTreeNodeFlags_DefaultOpen))
             {
+                bool changed = false;
+
                 ImGui::Text("Position");
-                ImGui::DragFloat3("##Position", glm::value_ptr(transformComponent.Position), 0.1f);
+                changed |= ImGui::DragFloat3("##Position", glm::value_ptr(transformComponent.Position), 0.1f);
 
                 ImGui::Text("Rotation");
-                ImGui::DragFloat3("##Rotation", glm::value_ptr(transformComponent.Rotation),  0.1f);
+                changed |= ImGui::DragFloat3("##Rotation", glm::value_ptr(transformComponent.Rotation),  0.1f);
 
                 ImGui::Text("Scale");
-                ImGui::DragFloat3("##Scale", glm::value_ptr(transformComponent.Scale),  0.1f);
+                changed |= ImGui::DragFloat3("##Scale", glm::value_ptr(transformComponent.Scale),  0.1f);
+
+                if(changed)
+                {
+                    transformComponent.MarkDirty();
+                }
             }
         }
 
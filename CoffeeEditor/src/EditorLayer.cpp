@@ -4,6 +4,7 @@
 #include "CoffeeEngine/Core/Assert.h"
 #include "CoffeeEngine/Core/Base.h"
 #include "CoffeeEngine/Core/FileDialog.h"
+#include "CoffeeEngine/Core/FrameProfiler.h"
 #include "CoffeeEngine/Core/Input.h"
 #include "CoffeeEngine/Core/Log.h"
 #include "CoffeeEngine/Core/MouseCodes.h"
@@ -35,7 +36,6 @@
 #include <imgui.h>
 #include <string>
 #include <sys/types.h>
-#include <tracy/Tracy.hpp>
 
 #include <IconsLucide.h>
 
@@ -64,6 +64,17 @@ namespace Coffee {
         m_SceneTreePanel.SetContext(m_ActiveScene);
         m_ContentBrowserPanel.SetContext(m_ActiveScene);
         m_ImportPanel.SetContext(m_ActiveScene);
+
+        EventBus& eventBus = Application::Get().GetEventBus();
+        m_EventSubscriptions = {
+            eventBus.Subscribe<MouseScrolledEvent>([this](MouseScrolledEvent& event) {
+                m_EditorCamera.OnEvent(event);
+                return event.Handled;
+            }),
+            eventBus.Subscribe<KeyPressedEvent>(COFFEE_BIND_EVENT_FN(EditorLayer::OnKeyPressed)),
+            eventBus.Subscribe<MouseButtonPressedEvent>(COFFEE_BIND_EVENT_FN(EditorLayer::OnMouseButtonPressed)),
+            eventBus.Subscribe<FileDropEvent>(COFFEE_BIND_EVENT_FN(EditorLayer::OnFileDrop)),
+        };
     }
 
     void EditorLayer::OnUpdate(float dt)
@@ -84,20 +95,6 @@ namespace Coffee {
         }
     }
 
-    void EditorLayer::OnEvent(Coffee::Event& event)
-    {
-        ZoneScoped;
-
-        m_EditorCamera.OnEvent(event);
-
-        m_ActiveScene->OnEvent(event);
-
-        EventDispatcher dispatcher(event);
-        dispatcher.Dispatch<KeyPressedEvent>(COFFEE_BIND_EVENT_FN(EditorLayer::OnKeyPressed));
-        dispatcher.Dispatch<MouseButtonPressedEvent>(COFFEE_BIND_EVENT_FN(EditorLayer::OnMouseButtonPressed));
-        dispatcher.Dispatch<FileDropEvent>(COFFEE_BIND_EVENT_FN(EditorLayer::OnFileDrop));
-    }
-
     bool EditorLayer::OnKeyPressed(KeyPressedEvent& event)
     {
         if(event.IsRepeat() > 0)
@@ -187,6 +184,10 @@ namespace Coffee {
         ZoneScoped;
 
         m_ActiveScene->OnExitEditor();
+
+        for (EventBus::SubscriptionID subscription : m_EventSubscriptions)
+            Application::Get().GetEventBus().Unsubscribe(subscription);
+        m_EventSubscriptions.clear();
     }
 
     void EditorLayer::OnImGuiRender()
@@ -211,6 +212,7 @@ namespace Coffee {
                 if (ImGui::MenuItem(ICON_LC_FOLDER_OPEN " Open Scene...", "Ctrl+O")) { OpenScene(); }
                 if (ImGui::MenuItem(ICON_LC_SAVE " Save Scene", "Ctrl+S")) { SaveScene(); }
                 if (ImGui::MenuItem(ICON_LC_SAVE " Save Scene As...", "Ctrl+Shift+S")) { SaveSceneAs(); }
+                if (ImGui::MenuItem(ICON_LC_REFRESH_CW " Convert Scene...")) { ConvertScene(); }
                 if (ImGui::MenuItem(ICON_LC_X " Exit")) { Application::Get().Close(); }
                 ImGui::EndMenu();
             }
@@ -393,23 +395,7 @@ namespace Coffee {
 
             if (ImGuizmo::IsUsing())
             {
-              /*TODO: Revisit this bc this should work using the SetWorldTransform
-                but for this in the SetWorldTransform we should update the local
-                transform too and for this we need the transform of the parent.*/
-
-                glm::mat4 localTransform = transform;
-
-                auto& parentEntity = selectedEntity.GetComponent<HierarchyComponent>().m_Parent;
-                if(parentEntity != entt::null)
-                {
-                    Entity e{parentEntity, m_ActiveScene.get()};
-                    glm::mat4 parentGlobalTransform = e.GetComponent<TransformComponent>().GetWorldTransform();
-                    glm::mat4 inverseParentGlobalTransform = glm::inverse(parentGlobalTransform);
-                    localTransform = inverseParentGlobalTransform * transform;
-                }
-
-                // Update the local transform component
-                transformComponent.SetLocalTransform(localTransform);
+                selectedEntity.SetWorldTransform(transform);
             }
         }
         else
@@ -666,17 +652,10 @@ namespace Coffee {
 
     void EditorLayer::OnScenePlay()
     {
-        if(m_ActiveScene->m_FilePath.empty())
-        {
-            COFFEE_ERROR("Scene is not saved! Please save the scene before playing.");
-            return;
-        }
-
         m_SceneState = SceneState::Play;
 
-        Scene::Save(m_EditorScene->m_FilePath, m_EditorScene);
-
-        m_ActiveScene = Scene::Load(m_ActiveScene->m_FilePath);
+        // Play on a copy, the edited scene stays untouched until the play mode stops
+        m_ActiveScene = Scene::Copy(m_EditorScene);
         m_ActiveScene->OnInitRuntime();
 
         m_SceneTreePanel.SetContext(m_ActiveScene);
@@ -759,15 +738,28 @@ namespace Coffee {
         m_ImportPanel.SetContext(m_ActiveScene);
     }
 
+    // Binary scenes load faster, JSON scenes diff well in version control
+    static ResourceFormat GetSceneFormat(const std::filesystem::path& path)
+    {
+        return path.extension() == ".TeaSceneBin" ? ResourceFormat::Binary : ResourceFormat::JSON;
+    }
+
     void EditorLayer::OpenScene()
     {
         FileDialogArgs args;
-        args.Filters = {{"Coffee Scene", "TeaScene"}};
+        args.Filters = {{"Coffee Scene", "TeaScene"}, {"Coffee Binary Scene", "TeaSceneBin"}};
         const std::filesystem::path& path = FileDialog::OpenFile(args);
 
-        if (!path.empty() and path.extension() == ".TeaScene")
+        if (!path.empty() and (path.extension() == ".TeaScene" or path.extension() == ".TeaSceneBin"))
         {
-            m_EditorScene = Scene::Load(path);
+            Ref<Scene> scene = Scene::Load(path);
+            if (!scene)
+            {
+                COFFEE_CORE_ERROR("Open Scene: Could not load {0}", path.string());
+                return;
+            }
+
+            m_EditorScene = scene;
             m_ActiveScene = m_EditorScene;
             m_ActiveScene->OnInitEditor();
 
@@ -790,7 +782,7 @@ namespace Coffee {
 
         if (!path.empty())
         {
-            Scene::Save(path, m_ActiveScene);
+            Scene::Save(path, m_ActiveScene, GetSceneFormat(path));
         }
         else
         {
@@ -799,6 +791,43 @@ namespace Coffee {
 
         /* Scene::Save(Project::GetActive()->GetProjectDirectory() / "Untitled.TeaScene", m_ActiveScene); */
     }
-    void EditorLayer::SaveSceneAs() {}
+    void EditorLayer::SaveSceneAs()
+    {
+        FileDialogArgs args;
+        args.Filters = {{"Coffee Scene", "TeaScene"}, {"Coffee Binary Scene", "TeaSceneBin"}};
+        const std::filesystem::path& path = FileDialog::SaveFile(args);
+
+        if (!path.empty())
+        {
+            Scene::Save(path, m_ActiveScene, GetSceneFormat(path));
+        }
+        else
+        {
+            COFFEE_CORE_WARN("Save Scene As: No file selected");
+        }
+    }
+
+    void EditorLayer::ConvertScene()
+    {
+        FileDialogArgs args;
+        args.Filters = {{"Coffee Scene", "TeaScene"}, {"Coffee Binary Scene", "TeaSceneBin"}};
+        const std::filesystem::path& path = FileDialog::OpenFile(args);
+
+        if (path.empty())
+        {
+            COFFEE_CORE_WARN("Convert Scene: No file selected");
+            return;
+        }
+
+        // Writes the other format next to the source
+        const ResourceFormat format = GetSceneFormat(path) == ResourceFormat::JSON ? ResourceFormat::Binary : ResourceFormat::JSON;
+        std::filesystem::path destination = path;
+        destination.replace_extension(format == ResourceFormat::Binary ? ".TeaSceneBin" : ".TeaScene");
+
+        if (Scene::Convert(path, destination, format))
+        {
+            COFFEE_CORE_INFO("Convert Scene: Saved {0}", destination.string());
+        }
+    }
 
 }
@@ -3,6 +3,7 @@
 #include "CoffeeEngine/Core/Base.h"
 #include "CoffeeEngine/Core/Layer.h"
 #include "CoffeeEngine/Events/ApplicationEvent.h"
+#include "CoffeeEngine/Events/EventBus.h"
 #include "CoffeeEngine/Events/KeyEvent.h"
 #include "CoffeeEngine/Renderer/EditorCamera.h"
 #include "CoffeeEngine/Scene/Scene.h"
@@ -25,8 +26,6 @@ namespace Coffee {
 
         void OnUpdate(float dt) override;
 
-        void OnEvent(Event& event) override;
-
         bool OnKeyPressed(KeyPressedEvent& event);
         bool OnMouseButtonPressed(MouseButtonPressedEvent& event);
         bool OnFileDrop(FileDropEvent& event);
@@ -53,6 +52,7 @@ namespace Coffee {
         void OpenScene();
         void SaveScene();
         void SaveSceneAs();
+        void ConvertScene();
     private:
         Ref<Scene> m_EditorScene;
         Ref<Scene> m_ActiveScene;
@@ -77,6 +77,8 @@ namespace Coffee {
         OutputPanel m_OutputPanel;
         MonitorPanel m_MonitorPanel;
         ImportPanel m_ImportPanel;
+
+        std::vector<EventBus::SubscriptionID> m_EventSubscriptions;
     };
 
 }
@@ -1,5 +1,6 @@
 #include "Audio.h"
 
+#include "CoffeeEngine/Core/MemoryTracker.h"
 #include "CoffeeEngine/Scene/Components.h"
 
 #include <cassert>
@@ -16,8 +17,17 @@ namespace Coffee
     std::vector<AudioSourceComponent*> Audio::audioSources;
     std::vector<AudioListenerComponent*> Audio::audioListeners;
 
-    void Audio::Init()
+    AudioBackend Audio::s_Backend = AudioBackend::Wwise;
+    uint32_t Audio::s_RegistrationSuspended = 0;
+
+    void Audio::Init(AudioBackend backend)
     {
+        COFFEE_MEMORY_TAG(MemoryTag::Audio);
+
+        s_Backend = backend;
+        if (s_Backend == AudioBackend::Null)
+            return;
+
         if (!InitializeMemoryManager())
             return;
 
@@ -48,11 +58,19 @@ namespace Coffee
 
     void Audio::RegisterGameObject(uint64_t gameObjectID)
     {
+        COFFEE_MEMORY_TAG(MemoryTag::Audio);
+
+        if (s_Backend == AudioBackend::Null)
+            return;
+
         AK::SoundEngine::RegisterGameObj(gameObjectID);
     }
 
     void Audio::UnregisterGameObject(uint64_t gameObjectID)
     {
+        if (s_Backend == AudioBackend::Null)
+            return;
+
         AK::SoundEngine::UnregisterGameObj(gameObjectID);
     }
 
@@ -71,6 +89,9 @@ namespace Coffee
 
     void Audio::Set3DPosition(uint64_t gameObjectID, glm::vec3 pos, glm::vec3 forward, glm::vec3 up)
     {
+        if (s_Backend == AudioBackend::Null)
+            return;
+
         AkSoundPosition newPos;
         newPos.SetPosition(pos.x, pos.y, -pos.z);
 
@@ -83,42 +104,54 @@ namespace Coffee
 
     void Audio::PlayEvent(AudioSourceComponent& audioSourceComponent)
     {
-        AK::SoundEngine::PostEvent(audioSourceComponent.eventName.c_str(), audioSourceComponent.gameObjectID);
+        if (s_Backend != AudioBackend::Null)
+            AK::SoundEngine::PostEvent(audioSourceComponent.eventName.c_str(), audioSourceComponent.gameObjectID);
         audioSourceComponent.isPlaying = true;
         audioSourceComponent.isPaused = false;
     }
 
     void Audio::StopEvent(AudioSourceComponent& audioSourceComponent)
     {
-        AK::SoundEngine::ExecuteActionOnEvent(audioSourceComponent.eventName.c_str(), AK::SoundEngine::AkActionOnEventType_Stop, audioSourceComponent.gameObjectID);
+        if (s_Backend != AudioBackend::Null)
+            AK::SoundEngine::ExecuteActionOnEvent(audioSourceComponent.eventName.c_str(), AK::SoundEngine::AkActionOnEventType_Stop, audioSourceComponent.gameObjectID);
         audioSourceComponent.isPlaying = false;
         audioSourceComponent.isPaused = false;
     }
 
     void Audio::PauseEvent(AudioSourceComponent& audioSourceComponent)
     {
-        AK::SoundEngine::ExecuteActionOnEvent(audioSourceComponent.eventName.c_str(), AK::SoundEngine::AkActionOnEventType_Pause, audioSourceComponent.gameObjectID);
+        if (s_Backend != AudioBackend::Null)
+            AK::SoundEngine::ExecuteActionOnEvent(audioSourceComponent.eventName.c_str(), AK::SoundEngine::AkActionOnEventType_Pause, audioSourceComponent.gameObjectID);
         audioSourceComponent.isPaused = true;
     }
 
     void Audio::ResumeEvent(AudioSourceComponent& audioSourceComponent)
     {
-        AK::SoundEngine::ExecuteActionOnEvent(audioSourceComponent.eventName.c_str(), AK::SoundEngine::AkActionOnEventType_Resume, audioSourceComponent.gameObjectID);
+        if (s_Backend != AudioBackend::Null)
+            AK::SoundEngine::ExecuteActionOnEvent(audioSourceComponent.eventName.c_str(), AK::SoundEngine::AkActionOnEventType_Resume, audioSourceComponent.gameObjectID);
         audioSourceComponent.isPaused = false;
     }
 
     void Audio::SetSwitch(const char* switchGroup, const char* switchState, uint64_t gameObjectID)
     {
+        if (s_Backend == AudioBackend::Null)
+            return;
+
         AK::SoundEngine::SetSwitch(switchGroup, switchState, gameObjectID);
     }
 
     void Audio::SetVolume(uint64_t gameObjectID, float newVolume)
     {
+        if (s_Backend == AudioBackend::Null)
+            return;
+
         AK::SoundEngine::SetGameObjectOutputBusVolume(gameObjectID, AK_INVALID_GAME_OBJECT, newVolume);
     }
 
     void Audio::RegisterAudioSourceComponent(AudioSourceComponent& audioSourceComponent)
     {
+        COFFEE_MEMORY_TAG(MemoryTag::Audio);
+
         for (const auto& source : audioSources)
         {
             if (source->gameObjectID == audioSourceComponent.gameObjectID)
@@ -150,6 +183,8 @@ namespace Coffee
 
     void Audio::RegisterAudioListenerComponent(AudioListenerComponent& audioListenerComponent)
     {
+        COFFEE_MEMORY_TAG(MemoryTag::Audio);
+
         for (const auto* listener : audioListeners)
         {
             if (listener->gameObjectID == audioListenerComponent.gameObjectID)
@@ -162,7 +197,8 @@ namespace Coffee
         audioListeners.push_back(&audioListenerComponent);
 
         RegisterGameObject(audioListenerComponent.gameObjectID);
-        AK::SoundEngine::SetDefaultListeners(&audioListenerComponent.gameObjectID, audioListeners.size());
+        if (s_Backend != AudioBackend::Null)
+            AK::SoundEngine::SetDefaultListeners(&audioListenerComponent.gameObjectID, audioListeners.size());
     }
 
     void Audio::UnregisterAudioListenerComponent(AudioListenerComponent& audioListenerComponent)
@@ -195,9 +231,19 @@ namespace Coffee
 
     void Audio::ProcessAudio()
     {
+        COFFEE_MEMORY_TAG(MemoryTag::Audio);
+
+        if (s_Backend == AudioBackend::Null)
+            return;
+
         AudioZone::Update();
 
         AK::SoundEngine::RenderAudio();
+
+        // Wwise allocates through its own memory manager, which doesn't go through operator new.
+        AK::MemoryMgr::GlobalStats memoryStats;
+        AK::MemoryMgr::GetGlobalStats(memoryStats);
+        MemoryTracker::SetExternalBytes(MemoryTag::Audio, memoryStats.uUsed);
     }
 
     bool Audio::InitializeMemoryManager()
@@ -298,6 +344,8 @@ namespace Coffee
 
     bool Audio::LoadAudioBanks()
     {
+        COFFEE_MEMORY_TAG(MemoryTag::Audio);
+
         std::ifstream file("assets/audio/Wwise Project/GeneratedSoundBanks/Windows/SoundbanksInfo.json");
         if (!file.is_open())
             return false;
@@ -351,10 +399,15 @@ namespace Coffee
 
     void Audio::Shutdown()
     {
+        COFFEE_MEMORY_TAG(MemoryTag::Audio);
+
         AudioZone::Shutdown();
 
         UnregisterAllGameObjects();
 
+        if (s_Backend == AudioBackend::Null)
+            return;
+
         // Unload the soundbanks
         AK::SoundEngine::ClearBanks();
 
@@ -379,5 +432,6 @@ namespace Coffee
 
         // Terminate the Memory Manager
         AK::MemoryMgr::Term();
+        MemoryTracker::SetExternalBytes(MemoryTag::Audio, 0);
     }
 } // namespace Coffee
@@ -36,6 +36,15 @@ namespace Coffee {
     struct AudioSourceComponent;
     struct AudioListenerComponent;
 
+    /**
+     * @brief The audio backends the engine can run on.
+     */
+    enum class AudioBackend
+    {
+        Wwise, ///< Plays audio through the Wwise sound engine.
+        Null ///< Keeps track of sources and listeners but never touches Wwise or an audio device, for headless runs.
+    };
+
     /**
      * @class Audio
      * @brief Manages audio systems including memory, sound, music, and spatial audio.
@@ -46,8 +55,15 @@ namespace Coffee {
 
         /**
          * @brief Initializes the audio system.
+         * @param backend The backend to run on.
          */
-        static void Init();
+        static void Init(AudioBackend backend = AudioBackend::Wwise);
+
+        /**
+         * @brief Gets the backend the audio system runs on.
+         * @return The backend.
+         */
+        static AudioBackend GetBackend() { return s_Backend; }
 
         /**
          * @brief Shuts down the audio system.
@@ -183,6 +199,23 @@ namespace Coffee {
          */
         static void UnregisterAudioListenerComponent(AudioListenerComponent& audioListenerComponent);
 
+        /**
+         * @brief Stop audio components from registering themselves when they are copied, for scenes that are only
+         * loaded to be saved again. Calls nest, every call must be matched by ResumeRegistration.
+         */
+        static void SuspendRegistration() { s_RegistrationSuspended++; }
+
+        /**
+         * @brief Undo a SuspendRegistration call.
+         */
+        static void ResumeRegistration() { s_RegistrationSuspended--; }
+
+        /**
+         * @brief Check if audio components should register themselves.
+         * @return False between SuspendRegistration and ResumeRegistration.
+         */
+        static bool IsRegistrationEnabled() { return s_RegistrationSuspended == 0; }
+
         /**
          * @brief Play the audio sources chosen to play on awake.
          */
@@ -195,6 +228,9 @@ namespace Coffee {
 
     private:
 
+        static AudioBackend s_Backend; ///< The backend the audio system runs on.
+        static uint32_t s_RegistrationSuspended; ///< The number of pending SuspendRegistration calls.
+
         /**
          * @brief Initializes the memory manager.
          * @return True if successful, false otherwise.
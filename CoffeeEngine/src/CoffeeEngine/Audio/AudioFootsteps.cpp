@@ -12,6 +12,9 @@ namespace Coffee {
 
     void AudioFootsteps::Initialize()
     {
+        if (Audio::GetBackend() == AudioBackend::Null)
+            return;
+
         // Register the listener with Wwise
         Audio::RegisterGameObject(m_ListenerID);
         AK::SoundEngine::SetDefaultListeners(&m_ListenerID, 2);
@@ -25,7 +28,8 @@ namespace Coffee {
         AkSoundPosition soundPosition;
         soundPosition.SetPosition(m_ListenerPosition.x, m_ListenerPosition.y, m_ListenerPosition.z);
         soundPosition.SetOrientation(0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f); // Default orientation
-        AK::SoundEngine::SetPosition(m_ListenerID, soundPosition);
+        if (Audio::GetBackend() != AudioBackend::Null)
+            AK::SoundEngine::SetPosition(m_ListenerID, soundPosition);
 
         // Determine surface and play appropriate sound
         DetermineSurface();
@@ -1,20 +1,20 @@
 #include "AudioZone.h"
 
+#include "CoffeeEngine/Core/DataStructures/FlatHashMap.h"
 #include "CoffeeEngine/Scene/Components.h"
 
 #include <AK/SoundEngine/Common/AkSoundEngine.h>
 #include <AK/Plugin/AllPluginsFactories.h>
 
-#include <unordered_map>
 #include <fstream>
 
 namespace Coffee
 {
     uint64_t m_nextZoneID= 1000;
 
-    std::unordered_map<uint64_t, AudioZoneComponent*> m_zones;
+    FlatHashMap<uint64_t, AudioZoneComponent*> m_zones;
 
-    std::unordered_map<uint64_t, glm::vec3> m_registeredObjects;
+    FlatHashMap<uint64_t, glm::vec3> m_registeredObjects;
 
     std::vector<std::string> AudioZone::busNames;
 
@@ -26,16 +26,14 @@ namespace Coffee
 
     void AudioZone::CreateZone(AudioZoneComponent& audioZone)
     {
-        for (const auto& zone : m_zones)
-        {
-            if (zone.first == audioZone.zoneID)
-                return;
-        }
+        if (m_zones.contains(audioZone.zoneID))
+            return;
 
         if (audioZone.zoneID == -1)
             audioZone.zoneID = UUID();
 
-        AK::SoundEngine::RegisterGameObj(audioZone.zoneID);
+        if (Audio::GetBackend() != AudioBackend::Null)
+            AK::SoundEngine::RegisterGameObj(audioZone.zoneID);
 
         m_zones[audioZone.zoneID] = &audioZone;
     }
@@ -125,7 +123,8 @@ namespace Coffee
 
     void AudioZone::CleanupZone(const uint64_t zoneID)
     {
-        AK::SoundEngine::UnregisterGameObj(zoneID);
+        if (Audio::GetBackend() != AudioBackend::Null)
+            AK::SoundEngine::UnregisterGameObj(zoneID);
     }
 
     bool AudioZone::IsObjectInZone(const glm::vec3& objectPos, const AudioZoneComponent& audioZoneComponent)
@@ -1,16 +1,26 @@
 #include "CoffeeEngine/Core/Application.h"
 
+#include "CoffeeEngine/Core/FrameAllocator.h"
+#include "CoffeeEngine/Core/FrameProfiler.h"
 #include "CoffeeEngine/Core/Layer.h"
 #include "CoffeeEngine/Core/Stopwatch.h"
 #include "CoffeeEngine/Core/Input.h"
-#include "CoffeeEngine/Events/ControllerEvent.h"
-#include "CoffeeEngine/Events/KeyEvent.h"
+#include "CoffeeEngine/Core/JobSystem.h"
+#include "CoffeeEngine/Core/MemoryTracker.h"
+#include "CoffeeEngine/Core/StartupOrchestrator.h"
+#include "CoffeeEngine/Core/SystemInfo.h"
+#include "CoffeeEngine/Core/TelemetrySampler.h"
+#include "CoffeeEngine/Core/TimerWheel.h"
+#include "CoffeeEngine/Events/InputEvent.h"
 #include "CoffeeEngine/Renderer/Renderer.h"
 #include "CoffeeEngine/Audio/Audio.h"
 
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_timer.h>
-#include <tracy/Tracy.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string_view>
 
 #ifdef WIN32
 #include <windows.h>
@@ -24,6 +34,37 @@ extern "C"
 namespace Coffee
 {
     Application* Application::s_Instance = nullptr;
+    ApplicationSettings Application::s_Settings;
+
+    ApplicationSettings ApplicationSettings::FromCommandLine(int argc, const char** argv)
+    {
+        ApplicationSettings settings;
+
+        if (const char* headless = std::getenv("COFFEE_HEADLESS"))
+            settings.Headless = std::string_view(headless) != "0";
+        if (const char* frames = std::getenv("COFFEE_FRAMES"))
+            settings.FrameCount = std::strtoull(frames, nullptr, 10);
+        if (const char* fixedDeltaTime = std::getenv("COFFEE_FIXED_DT"))
+            settings.FixedDeltaTime = std::strtof(fixedDeltaTime, nullptr);
+        if (const char* telemetry = std::getenv("COFFEE_TELEMETRY"))
+            settings.TelemetryPath = telemetry;
+
+        for (int i = 1; i < argc; i++)
+        {
+            const std::string_view argument = argv[i];
+
+            if (argument == "--headless")
+                settings.Headless = true;
+            else if (argument == "--frames" && i + 1 < argc)
+                settings.FrameCount = std::strtoull(argv[++i], nullptr, 10);
+            else if (argument == "--fixed-dt" && i + 1 < argc)
+                settings.FixedDeltaTime = std::strtof(argv[++i], nullptr);
+            else if (argument == "--telemetry" && i + 1 < argc)
+                settings.TelemetryPath = argv[++i];
+        }
+
+        return settings;
+    }
 
     Application::Application()
     {
@@ -32,20 +73,51 @@ namespace Coffee
         COFFEE_CORE_ASSERT(!s_Instance, "Application already exists!");
 		s_Instance = this;
 
-        m_Window = Window::Create(WindowProps("Coffee Engine"));
-        SetEventCallback(COFFEE_BIND_EVENT_FN(OnEvent));
-
-        Input::Init();
-        Renderer::Init();
-        Audio::Init();
+        if (s_Settings.Headless)
+        {
+            COFFEE_CORE_INFO("Running headless ({0} frames, fixed delta time {1} s)", s_Settings.FrameCount,
+                             s_Settings.FixedDeltaTime);
+            RendererAPI::SetAPI(RendererAPI::API::Null);
+        }
 
-        m_ImGuiLayer = new ImGuiLayer();
-		PushOverlay(m_ImGuiLayer);
+        SetEventCallback(COFFEE_BIND_EVENT_FN(OnEvent));
+        m_EventBus.Subscribe<WindowCloseEvent>(COFFEE_BIND_EVENT_FN(OnWindowClose), EventPriority::Low);
+
+        FrameProfiler::Init();
+
+        // The main thread takes part in the jobs while it waits, so leave it one core.
+        uint32_t logicalCores = SystemInfo::GetLogicalProcessorCount();
+        JobSystem::Init(logicalCores > 1 ? logicalCores - 1 : 0);
+        FrameAllocator::Init(JobSystem::GetWorkerCount() + 1);
+        TelemetrySampler::Init();
+
+        // The asset decoding doesn't need the window, so it runs on the workers while the main thread creates it and
+        // sets up the GL state. Wwise stays on the main thread: the sound engine is later driven from it (RenderAudio,
+        // game object registration), and its init is not documented as safe from another thread.
+        StartupOrchestrator startup;
+        startup.AddStage("Window", StartupThread::Main, {},
+                         [this]() { m_Window = Window::Create(WindowProps("Coffee Engine")); });
+        startup.AddStage("Audio", StartupThread::Main, {}, []() {
+            Audio::Init(s_Settings.Headless ? AudioBackend::Null : AudioBackend::Wwise);
+        });
+        startup.AddStage("Renderer Assets", StartupThread::Any, {}, []() { Renderer::PreloadAssets(); });
+        startup.AddStage("Input", StartupThread::Main, {"Window"}, []() { Input::Init(); });
+        startup.AddStage("Renderer", StartupThread::Main, {"Window"}, []() { Renderer::Init(); });
+        startup.AddStage("ImGui", StartupThread::Main, {"Renderer"}, [this]() {
+            m_ImGuiLayer = new ImGuiLayer();
+            PushOverlay(m_ImGuiLayer);
+        });
+        startup.Run();
     }
 
     Application::~Application()
     {
         Audio::Shutdown();
+        TelemetrySampler::Shutdown();
+        TimerWheel::Shutdown();
+        FrameProfiler::Shutdown();
+        JobSystem::Shutdown();
+        FrameAllocator::Shutdown();
     }
 
     void Application::PushLayer(Layer* layer)
@@ -73,17 +145,18 @@ namespace Coffee
     {
         ZoneScoped;
 
-        EventDispatcher dispacher(e);
-        dispacher.Dispatch<WindowCloseEvent>(COFFEE_BIND_EVENT_FN(OnWindowClose));
+        Input::OnEvent(e);
+
+        m_EventBus.Publish(e);
+    }
 
+    void Application::OnInputEvent(InputEvent& e)
+    {
         Input::OnEvent(e);
 
-        for (auto it = m_LayerStack.end(); it != m_LayerStack.begin();)
-        {
-            (*--it)->OnEvent(e);
-            if(e.Handled)
-                break;
-        }
+        // Most high-rate events have no subscribers, so skip building the Event entirely.
+        if (m_EventBus.HasSubscribers(e.Type))
+            DispatchAsEvent(e, [this](auto& event) { m_EventQueue.Post<std::decay_t<decltype(event)>>(event); });
     }
 
     void Application::Run()
@@ -92,22 +165,37 @@ namespace Coffee
 
         static Stopwatch frameTimeStopwatch;
 
+        Stopwatch runStopwatch;
+        runStopwatch.Start();
+        uint64_t frameIndex = 0;
+
         while (m_Running)
-        {   
+        {
+            // Close the previous frame before this one's zones start.
+            FrameProfiler::BeginFrame();
+
             ZoneScopedN("RunLoop");
 
             m_LastFrameTime = frameTimeStopwatch.GetPreciseElapsedTime();
             frameTimeStopwatch.Reset();
             frameTimeStopwatch.Start();
+            TelemetrySampler::RecordFrame(m_LastFrameTime);
+
+            FrameAllocator::BeginFrame();
 
-            float deltaTime = m_LastFrameTime;
+            // A fixed step makes headless runs reproducible regardless of how fast the machine is.
+            float deltaTime = s_Settings.FixedDeltaTime > 0.0f ? s_Settings.FixedDeltaTime : m_LastFrameTime;
 
             //Poll and handle events
             ProcessEvents();
+            Input::Update();
 
             //Process audio
             Audio::ProcessAudio();
 
+            //Fire expired timers at the same point of every frame, before the layers update
+            TimerWheel::Advance(deltaTime);
+
             //Update and render
             {
                 ZoneScopedN("LayerStack Update");
@@ -127,11 +215,50 @@ namespace Coffee
             m_ImGuiLayer->End();
 
             m_Window->OnUpdate();
+
+            // Deliver what was posted during the frame before the event arena is rewound.
+            m_EventQueue.Dispatch(m_EventBus);
+            m_EventQueue.Reset();
+
+            MemoryTracker::EndFrame();
+
+            if (s_Settings.FrameCount > 0 && ++frameIndex >= s_Settings.FrameCount)
+                Close();
         }
+
+        if (s_Settings.FrameCount > 0)
+        {
+            const double seconds = runStopwatch.GetPreciseElapsedTime();
+            COFFEE_CORE_INFO("Ran {0} frames in {1:.3f} s ({2:.3f} ms/frame, {3} draw calls in the last frame)",
+                             frameIndex, seconds, seconds * 1000.0 / std::max<uint64_t>(frameIndex, 1),
+                             Renderer::GetStats().DrawCalls);
+
+            for (uint8_t i = 0; i < static_cast<uint8_t>(MemoryTag::Count); i++)
+            {
+                const MemoryTagStats stats = MemoryTracker::GetStats(static_cast<MemoryTag>(i));
+                COFFEE_CORE_INFO("  {0:<10} {1:>8.2f} MB live, {2:>8.2f} MB peak, {3:>8.2f} MB GPU",
+                                 MemoryTracker::GetTagName(static_cast<MemoryTag>(i)), stats.LiveBytes / 1048576.0,
+                                 stats.PeakBytes / 1048576.0, stats.GPUBytes / 1048576.0);
+            }
+        }
+
+        if (!s_Settings.TelemetryPath.empty())
+            TelemetrySampler::ExportCSV(s_Settings.TelemetryPath);
     }
 
     void Application::ProcessEvents()
     {
+        // Input is held back until polling is done so redundant motion/axis events can be merged first. Window events
+        // flush it before they are posted, so the queue still sees every event in the order SDL reported it.
+        const auto flushInputEvents = [this]() {
+            ZoneScopedN("Dispatch Input Events");
+
+            TracyPlot("Input Events Received", static_cast<int64_t>(m_InputEvents.GetReceivedCount()));
+            TracyPlot("Input Events Dispatched", static_cast<int64_t>(m_InputEvents.GetPendingCount()));
+
+            m_InputEvents.Flush([this](InputEvent& e) { OnInputEvent(e); });
+        };
+
         SDL_Event event;
         while(SDL_PollEvent(&event))
         {
@@ -140,20 +267,20 @@ namespace Coffee
             {
                 case SDL_EVENT_QUIT:
                 {
-                    WindowCloseEvent e;
-                    m_EventCallback(e);
+                    flushInputEvents();
+                    m_EventQueue.Post<WindowCloseEvent>();
                     break;
                 }
                 case SDL_EVENT_WINDOW_RESIZED:
                 {
-                    WindowResizeEvent e(event.window.data1, event.window.data2);
-                    m_EventCallback(e);
+                    flushInputEvents();
+                    m_EventQueue.Post<WindowResizeEvent>(event.window.data1, event.window.data2);
                     break;
                 }
                 case SDL_EVENT_WINDOW_CLOSE_REQUESTED:
                 {
-                    WindowCloseEvent e;
-                    m_EventCallback(e);
+                    flushInputEvents();
+                    m_EventQueue.Post<WindowCloseEvent>();
                     break;
                 }
                 case SDL_EVENT_DROP_FILE:
@@ -161,87 +288,92 @@ namespace Coffee
                     const std::string& source = event.drop.source ? event.drop.source : "";
                     const std::string& file = event.drop.data ? event.drop.data : "";
 
-                    FileDropEvent e(event.drop.timestamp, event.drop.windowID,event.drop.x,
-                                    event.drop.y, source, file);
-                    m_EventCallback(e);
+                    flushInputEvents();
+                    m_EventQueue.Post<FileDropEvent>(event.drop.timestamp, event.drop.windowID, event.drop.x,
+                                                     event.drop.y, source, file);
                     break;
                 }
                 case SDL_EVENT_KEY_DOWN:
                 {
-                    if(event.key.repeat)
-                    {
-                        KeyPressedEvent e(event.key.scancode, 1);
-                        m_EventCallback(e);
-                    }
-                    else
-                    {
-                        KeyPressedEvent e(event.key.scancode, 0);
-                        m_EventCallback(e);
-                    }
+                    InputEvent e = InputEvent::MakeKey(EventType::KeyPressed, event.key.timestamp, event.key.scancode,
+                                                       event.key.repeat);
+                    m_InputEvents.Push(e);
                     break;
                 }
                 case SDL_EVENT_KEY_UP:
                 {
-                    KeyReleasedEvent e(event.key.scancode);
-                    m_EventCallback(e);
+                    InputEvent e = InputEvent::MakeKey(EventType::KeyReleased, event.key.timestamp, event.key.scancode);
+                    m_InputEvents.Push(e);
                     break;
                 }
                 case SDL_EVENT_MOUSE_BUTTON_DOWN:
                 {
-                    MouseButtonPressedEvent e(event.button.button);
-                    m_EventCallback(e);
+                    InputEvent e = InputEvent::MakeMouseButton(EventType::MouseButtonPressed, event.button.timestamp,
+                                                               event.button.button);
+                    m_InputEvents.Push(e);
                     break;
                 }
                 case SDL_EVENT_MOUSE_BUTTON_UP:
                 {
-                    MouseButtonReleasedEvent e(event.button.button);
-                    m_EventCallback(e);
+                    InputEvent e = InputEvent::MakeMouseButton(EventType::MouseButtonReleased, event.button.timestamp,
+                                                               event.button.button);
+                    m_InputEvents.Push(e);
                     break;
                 }
                 case SDL_EVENT_MOUSE_MOTION:
                 {
-                    MouseMovedEvent e(event.motion.x, event.motion.y);
-                    m_EventCallback(e);
+                    InputEvent e = InputEvent::MakeMouseMove(event.motion.timestamp, event.motion.x, event.motion.y,
+                                                             event.motion.xrel, event.motion.yrel);
+                    m_InputEvents.Push(e);
                     break;
                 }
                 case SDL_EVENT_MOUSE_WHEEL:
                 {
-                    MouseScrolledEvent e(event.wheel.x, event.wheel.y);
-                    m_EventCallback(e);
+                    InputEvent e = InputEvent::MakeMouseScroll(event.wheel.timestamp, event.wheel.x, event.wheel.y);
+                    m_InputEvents.Push(e);
                     break;
                 }
                 case SDL_EVENT_GAMEPAD_ADDED:
                 {
-                    ControllerAddEvent e((event.gdevice.which));
-                    m_EventCallback(e);
+                    InputEvent e = InputEvent::MakeControllerDevice(EventType::ControllerConnected,
+                                                                    event.gdevice.timestamp, event.gdevice.which);
+                    m_InputEvents.Push(e);
                     break;
                 }
                 case SDL_EVENT_GAMEPAD_REMOVED:
                 {
-                    ControllerRemoveEvent e(event.gdevice.which);
-                    m_EventCallback(e);
+                    InputEvent e = InputEvent::MakeControllerDevice(EventType::ControllerDisconnected,
+                                                                    event.gdevice.timestamp, event.gdevice.which);
+                    m_InputEvents.Push(e);
                     break;
                 }
                 case SDL_EVENT_GAMEPAD_BUTTON_DOWN:
                 {
-                    ButtonPressEvent e(event.gbutton.which, event.gbutton.button);
-                    m_EventCallback(e);
+                    InputEvent e = InputEvent::MakeControllerButton(EventType::ButtonPressed, event.gbutton.timestamp,
+                                                                    event.gbutton.which, event.gbutton.button);
+                    m_InputEvents.Push(e);
                     break;
                 }
                 case SDL_EVENT_GAMEPAD_BUTTON_UP:
                 {
-                    ButtonReleaseEvent e(event.gbutton.which, event.gbutton.button);
-                    m_EventCallback(e);
+                    InputEvent e = InputEvent::MakeControllerButton(EventType::ButtonReleased, event.gbutton.timestamp,
+                                                                    event.gbutton.which, event.gbutton.button);
+                    m_InputEvents.Push(e);
                     break;
                 }
                 case SDL_EVENT_GAMEPAD_AXIS_MOTION:
                 {
-                    AxisMoveEvent e(event.gaxis.which, event.gaxis.axis, event.gaxis.value);
-                    m_EventCallback(e);
+                    InputEvent e = InputEvent::MakeControllerAxis(event.gaxis.timestamp, event.gaxis.which,
+                                                                  event.gaxis.axis, event.gaxis.value);
+                    m_InputEvents.Push(e);
                     break;
                 }
             }
         }
+
+        flushInputEvents();
+
+        m_EventQueue.Dispatch(m_EventBus);
     }
 
     bool Application::OnWindowClose(WindowCloseEvent& e)
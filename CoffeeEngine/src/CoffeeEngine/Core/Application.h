@@ -4,7 +4,13 @@
 #include "Window.h"
 #include "LayerStack.h"
 #include "CoffeeEngine/Events/ApplicationEvent.h"
+#include "CoffeeEngine/Events/EventBus.h"
+#include "CoffeeEngine/Events/EventQueue.h"
+#include "CoffeeEngine/Events/InputEvent.h"
 #include "CoffeeEngine/ImGui/ImGuiLayer.h"
+#include "CoffeeEngine/Input/InputEventCoalescer.h"
+
+#include <string>
 
 namespace Coffee
 {
@@ -14,6 +20,37 @@ namespace Coffee
      * @{
      */
 
+    /**
+     * @brief How the application runs, chosen on the command line or through environment variables.
+     */
+    struct ApplicationSettings
+    {
+        /**
+         * @brief Runs without a visible window, GPU or audio device.
+         *
+         * SDL uses its dummy video driver, the renderer runs on the null backend (render commands and stats are
+         * still recorded, see NullGL) and audio on the null backend. Meant for CI, benchmarks and servers.
+         */
+        bool Headless = false;
+
+        uint64_t FrameCount = 0; ///< The number of frames to run before closing, 0 runs until the application is closed.
+        float FixedDeltaTime = 0.0f; ///< The delta time of every frame in seconds, 0 uses the measured frame time.
+        std::string TelemetryPath; ///< Where to export the telemetry as CSV when Run returns, empty to skip it.
+
+        /**
+         * @brief Reads the settings from the command line, falling back to the environment.
+         *
+         * Recognizes --headless, --frames N, --fixed-dt SECONDS and --telemetry FILE.csv, and the COFFEE_HEADLESS,
+         * COFFEE_FRAMES, COFFEE_FIXED_DT and COFFEE_TELEMETRY environment variables. Unknown arguments are left for
+         * the client.
+         *
+         * @param argc The number of arguments.
+         * @param argv The arguments.
+         * @return The settings.
+         */
+        static ApplicationSettings FromCommandLine(int argc, const char** argv);
+    };
+
     /**
      * @brief The Application class is responsible for managing the main application loop,
      * handling events, and managing layers and overlays.
@@ -38,11 +75,27 @@ namespace Coffee
         void Run();
 
         /**
-         * @brief Handles incoming events.
+         * @brief Handles incoming events and publishes them on the event bus.
          * @param e The event to handle.
          */
         void OnEvent(Event& e);
 
+        /**
+         * @brief Gets the event bus. Layers and systems subscribe here to the events they are interested in.
+         * @return A reference to the event bus.
+         */
+        EventBus& GetEventBus() { return m_EventBus; }
+
+        /**
+         * @brief Gets the event queue of the current frame.
+         *
+         * Events posted here are published on the event bus after polling, or at the end of the frame if posted
+         * later. Handlers should post follow-up events (e.g. gameplay messages) here instead of publishing them.
+         *
+         * @return A reference to the event queue.
+         */
+        EventQueue& GetEventQueue() { return m_EventQueue; }
+
         /**
          * @brief Pushes a layer onto the layer stack.
          * @param layer The layer to push.
@@ -82,6 +135,18 @@ namespace Coffee
         float GetFrameTime() const { return m_LastFrameTime * 1000.0f; }
         float GetFPS() const { return 1.0f / m_LastFrameTime; }
 
+        /**
+         * @brief Sets how the application runs. Must be called before the application is created.
+         * @param settings The settings.
+         */
+        static void SetSettings(const ApplicationSettings& settings) { s_Settings = settings; }
+
+        /**
+         * @brief Gets how the application runs.
+         * @return The settings.
+         */
+        static const ApplicationSettings& GetSettings() { return s_Settings; }
+
         /**
          * @brief Gets the singleton instance of the Application.
          * @return A reference to the singleton instance.
@@ -94,10 +159,22 @@ namespace Coffee
          * @brief Polls and processes events.
          * 
          * This function retrieves and handles events such as input from the keyboard,
-         * mouse, window, and other devices.
+         * mouse, window, and other devices. Input events are queued while polling and dispatched
+         * afterwards, with redundant motion, scroll and axis events merged. Events are then published
+         * from the event queue in posting order.
          */
         void ProcessEvents();
 
+        /**
+         * @brief Handles an input event once the events of the frame have been coalesced.
+         *
+         * Input consumes the compact event directly; if anything subscribed to its type, the matching Event is
+         * posted to the event queue.
+         *
+         * @param e The input event to handle.
+         */
+        void OnInputEvent(InputEvent& e);
+
         /**
          * @brief Handles the window close event.
          * @param e The window close event.
@@ -110,12 +187,16 @@ namespace Coffee
         Scope<Window> m_Window; ///< The main application window.
         ImGuiLayer* m_ImGuiLayer; ///< The ImGui layer.
         bool m_Running = true; ///< Indicates whether the application is running.
+        EventBus m_EventBus; ///< Routes events to their subscribers. Declared before the layers so it outlives them.
+        EventQueue m_EventQueue; ///< The events of the current frame, allocated in a per-frame arena.
         LayerStack m_LayerStack; ///< The stack of layers.
         double m_LastFrameTime = 0.0f; ///< The time of the last frame.
         EventCallbackFn m_EventCallback; ///< The event callback function.
+        InputEventCoalescer m_InputEvents; ///< The input events of the current frame, merged before dispatch.
 
       private:
         static Application* s_Instance; ///< The singleton instance of the Application.
+        static ApplicationSettings s_Settings; ///< How the application runs.
     };
 
     /**
@@ -0,0 +1,258 @@
+#include "CoffeeEngine/Core/BinaryLog.h"
+
+#include "CoffeeEngine/Core/DataStructures/LockFreeRingBuffer.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tracy/Tracy.hpp>
+#include <vector>
+
+namespace Coffee
+{
+    static constexpr size_t ThreadBufferSize = 256 * 1024;
+    static constexpr size_t ChunkSize = 64 * 1024;
+
+    struct LogFormat
+    {
+        spdlog::level::level_enum Level;
+        std::string LoggerName;
+        std::string Format;
+    };
+
+    struct LogThreadBuffer
+    {
+        explicit LogThreadBuffer(uint16_t index) : Index(index), Bytes(ThreadBufferSize) {}
+
+        uint16_t Index;
+        SPSCRingBuffer<std::byte> Bytes; ///< Written by the owning thread, drained by the writer thread.
+    };
+
+    struct BinaryLogData
+    {
+        static constexpr uint16_t MaxThreads = 256;
+
+        std::atomic<bool> Enabled = false;
+        std::ofstream File;
+        std::thread Writer;
+        std::atomic<bool> Running = false;
+
+        // Formats are kept across Shutdown and Init, the call sites cache their ID.
+        std::mutex FormatMutex;
+        std::vector<LogFormat> Formats;
+        size_t WrittenFormats = 0; ///< Formats already written to the current file.
+
+        // Buffers are never freed, so threads can keep their pointer for their whole lifetime.
+        std::mutex RegisterMutex;
+        std::array<std::unique_ptr<LogThreadBuffer>, MaxThreads> Threads;
+        std::atomic<uint16_t> ThreadCount = 0;
+
+        std::atomic<uint64_t> Dropped = 0;
+    };
+
+    static BinaryLogData s_BinaryLogData;
+    static thread_local LogThreadBuffer* s_ThreadBuffer = nullptr;
+
+    spdlog::level::level_enum BinaryLog::s_TextLevel = spdlog::level::warn;
+
+    static LogThreadBuffer* RegisterThread()
+    {
+        auto& data = s_BinaryLogData;
+        std::lock_guard lock(data.RegisterMutex);
+
+        const uint16_t index = data.ThreadCount.load(std::memory_order_relaxed);
+        if (index == BinaryLogData::MaxThreads)
+            return nullptr;
+
+        data.Threads[index] = std::make_unique<LogThreadBuffer>(index);
+        data.ThreadCount.store(index + 1, std::memory_order_release);
+
+        s_ThreadBuffer = data.Threads[index].get();
+        return s_ThreadBuffer;
+    }
+
+    template<typename T>
+    static void WriteValue(std::ofstream& file, const T& value)
+    {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    static void WriteNewFormats()
+    {
+        auto& data = s_BinaryLogData;
+        std::lock_guard lock(data.FormatMutex);
+
+        for (; data.WrittenFormats < data.Formats.size(); data.WrittenFormats++)
+        {
+            const LogFormat& format = data.Formats[data.WrittenFormats];
+
+            WriteValue(data.File, BinaryLogFormat::BlockType::Format);
+            WriteValue(data.File, static_cast<uint32_t>(data.WrittenFormats));
+            WriteValue(data.File, static_cast<uint8_t>(format.Level));
+            WriteValue(data.File, static_cast<uint16_t>(format.LoggerName.size()));
+            data.File.write(format.LoggerName.data(), format.LoggerName.size());
+            WriteValue(data.File, static_cast<uint32_t>(format.Format.size()));
+            data.File.write(format.Format.data(), format.Format.size());
+        }
+    }
+
+    /**
+     * Moves the records of every thread to the file. Returns the number of bytes written.
+     */
+    static size_t WriteChunks(std::vector<std::byte>& chunk)
+    {
+        auto& data = s_BinaryLogData;
+        size_t written = 0;
+
+        const uint16_t threadCount = data.ThreadCount.load(std::memory_order_acquire);
+        for (uint16_t i = 0; i < threadCount; i++)
+        {
+            LogThreadBuffer& thread = *data.Threads[i];
+
+            size_t size;
+            while ((size = thread.Bytes.pop_n(chunk.data(), chunk.size())) > 0)
+            {
+                // The records were pushed after their format was registered, so this picks it up.
+                WriteNewFormats();
+
+                WriteValue(data.File, BinaryLogFormat::BlockType::Chunk);
+                WriteValue(data.File, thread.Index);
+                WriteValue(data.File, static_cast<uint32_t>(size));
+                data.File.write(reinterpret_cast<const char*>(chunk.data()), size);
+                written += size;
+            }
+        }
+
+        return written;
+    }
+
+    BinaryLog::Record::Record(uint32_t formatID, size_t argCount)
+    {
+        const int64_t time =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+                .count();
+
+        Append(&formatID, sizeof(formatID));
+        Append(&time, sizeof(time));
+        const uint8_t count = static_cast<uint8_t>(argCount);
+        Append(&count, sizeof(count));
+    }
+
+    void BinaryLog::Record::PutString(std::string_view text)
+    {
+        text = text.substr(0, std::min(text.size(), MaxStringBytes - m_StringBytes));
+        m_StringBytes += text.size();
+
+        const BinaryLogFormat::ArgType type = BinaryLogFormat::ArgType::String;
+        const uint32_t length = static_cast<uint32_t>(text.size());
+        Append(&type, sizeof(type));
+        Append(&length, sizeof(length));
+        Append(text.data(), text.size());
+    }
+
+    void BinaryLog::Record::Append(const void* data, size_t size)
+    {
+        std::memcpy(m_Data + m_Size, data, size);
+        m_Size += size;
+    }
+
+    void BinaryLog::Init(const std::filesystem::path& path, spdlog::level::level_enum textLevel)
+    {
+        auto& data = s_BinaryLogData;
+
+        data.File.open(path, std::ios::binary | std::ios::trunc);
+        if (!data.File)
+        {
+            COFFEE_CORE_ERROR("BinaryLog::Init: Could not open {0}", path.string());
+            return;
+        }
+
+        data.File.write(BinaryLogFormat::Magic, sizeof(BinaryLogFormat::Magic));
+        WriteValue(data.File, BinaryLogFormat::Version);
+        data.WrittenFormats = 0;
+        data.Dropped.store(0, std::memory_order_relaxed);
+        s_TextLevel = textLevel;
+
+        data.Running.store(true, std::memory_order_release);
+        data.Writer = std::thread(&BinaryLog::WriterThread);
+        data.Enabled.store(true, std::memory_order_release);
+    }
+
+    void BinaryLog::Shutdown()
+    {
+        auto& data = s_BinaryLogData;
+
+        if (!data.Enabled.exchange(false, std::memory_order_acq_rel))
+            return;
+
+        // The writer drains the thread buffers before returning.
+        data.Running.store(false, std::memory_order_release);
+        data.Writer.join();
+
+        WriteValue(data.File, BinaryLogFormat::BlockType::End);
+        WriteValue(data.File, data.Dropped.load(std::memory_order_relaxed));
+        data.File.close();
+
+        if (data.Dropped.load(std::memory_order_relaxed) > 0)
+            COFFEE_CORE_WARN("BinaryLog: {0} records were dropped because a thread buffer was full",
+                             data.Dropped.load(std::memory_order_relaxed));
+    }
+
+    bool BinaryLog::IsEnabled()
+    {
+        return s_BinaryLogData.Enabled.load(std::memory_order_relaxed);
+    }
+
+    uint32_t BinaryLog::RegisterFormat(spdlog::logger& logger, spdlog::level::level_enum level,
+                                       fmt::string_view format)
+    {
+        auto& data = s_BinaryLogData;
+        std::lock_guard lock(data.FormatMutex);
+
+        data.Formats.push_back({level, logger.name(), std::string(format.data(), format.size())});
+        return static_cast<uint32_t>(data.Formats.size() - 1);
+    }
+
+    void BinaryLog::Submit(const Record& record)
+    {
+        LogThreadBuffer* thread = s_ThreadBuffer ? s_ThreadBuffer : RegisterThread();
+
+        // A record is pushed whole or dropped, half of one would corrupt the thread's stream.
+        if (!thread || thread->Bytes.capacity() - thread->Bytes.size() < record.Size())
+        {
+            s_BinaryLogData.Dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        thread->Bytes.push_n(record.Data(), record.Size());
+    }
+
+    void BinaryLog::WriterThread()
+    {
+        tracy::SetThreadName("Binary Log");
+
+        auto& data = s_BinaryLogData;
+        std::vector<std::byte> chunk(ChunkSize);
+
+        while (true)
+        {
+            // Read the flag before draining, so the records pushed before Shutdown are always written.
+            const bool running = data.Running.load(std::memory_order_acquire);
+
+            if (WriteChunks(chunk) > 0)
+                continue;
+
+            if (!running)
+                break;
+
+            data.File.flush();
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+
+} // namespace Coffee
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "CoffeeEngine/Core/BinaryLogFormat.h"
+#include "CoffeeEngine/Core/Log.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace Coffee
+{
+    /**
+     * @defgroup core Core
+     * @{
+     */
+
+    /**
+     * @brief Deferred-format logging to a binary file, enabled by building with COFFEE_BINARY_LOG.
+     *
+     * Every log call site gets a format ID the first time it runs. A message is then only its ID, a timestamp and
+     * a raw copy of its arguments, appended to a lock-free buffer owned by the calling thread; nothing is formatted.
+     * A writer thread moves the buffers to a compact binary file (see BinaryLogFormat.h), which the LogDecoder
+     * tool turns back into text. Messages at or above the text level are also written to the regular sinks, so
+     * warnings and errors still show up in the console.
+     */
+    class BinaryLog
+    {
+      public:
+        /**
+         * @brief Opens the file and starts the writer thread.
+         * @param path The path of the binary log file.
+         * @param textLevel The lowest level also written to the regular sinks.
+         */
+        static void Init(const std::filesystem::path& path,
+                         spdlog::level::level_enum textLevel = spdlog::level::warn);
+
+        /**
+         * @brief Writes the pending records and closes the file.
+         */
+        static void Shutdown();
+
+        /**
+         * @brief Checks if messages are being written to the binary file.
+         * @return True between Init and Shutdown, false otherwise.
+         */
+        static bool IsEnabled();
+
+        /**
+         * @brief Records a message. Used by the log macros.
+         * @param site A lambda unique to the call site, so every call site has its own format ID.
+         * @param logger The logger the message belongs to.
+         * @param level The level of the message.
+         * @param format The format string.
+         * @param args The format arguments.
+         */
+        template<typename Site, typename... Args>
+        static void Write(Site, spdlog::logger& logger, spdlog::level::level_enum level,
+                          spdlog::format_string_t<Args...> format, Args&&... args)
+        {
+            static_assert(sizeof...(Args) <= Record::MaxArgs, "Too many arguments for a binary log record");
+
+            if (!logger.should_log(level))
+                return;
+
+            if (IsEnabled())
+            {
+                static const uint32_t formatID = RegisterFormat(logger, level, format);
+
+                Record record(formatID, sizeof...(Args));
+                (record.Add(args), ...);
+                Submit(record);
+            }
+
+            if (level >= s_TextLevel || !IsEnabled())
+                Log::Write<Args...>(logger, level, format, std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Records a message that is not a format string. Used by the log macros.
+         */
+        template<typename Site, typename T>
+        static void Write(Site site, spdlog::logger& logger, spdlog::level::level_enum level, const T& message)
+        {
+            Write(site, logger, level, "{}", message);
+        }
+
+      private:
+        /**
+         * @brief A record being encoded on the stack of the logging thread.
+         */
+        class Record
+        {
+          public:
+            static constexpr size_t MaxArgs = 16;
+            static constexpr size_t MaxStringBytes = 512; ///< Characters of all string arguments; the rest is truncated.
+
+            Record(uint32_t formatID, size_t argCount);
+
+            template<typename T>
+            void Add(const T& value)
+            {
+                using namespace BinaryLogFormat;
+
+                if constexpr (std::is_same_v<T, bool>)
+                    Put(ArgType::Bool, value);
+                else if constexpr (std::is_same_v<T, char>)
+                    Put(ArgType::Char, value);
+                else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+                    PutString(std::string_view(value));
+                else if constexpr (std::is_enum_v<T> && std::is_constructible_v<fmt::formatter<T>>)
+                    PutString(fmt::format("{}", value)); // Enums with a formatter are logged by name, not by value.
+                else if constexpr (std::is_enum_v<T>)
+                    Add(static_cast<std::underlying_type_t<T>>(value));
+                else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+                    sizeof(T) <= 4 ? Put(ArgType::Int32, static_cast<int32_t>(value))
+                                   : Put(ArgType::Int64, static_cast<int64_t>(value));
+                else if constexpr (std::is_integral_v<T>)
+                    sizeof(T) <= 4 ? Put(ArgType::UInt32, static_cast<uint32_t>(value))
+                                   : Put(ArgType::UInt64, static_cast<uint64_t>(value));
+                else if constexpr (std::is_same_v<T, float>)
+                    Put(ArgType::Float, value);
+                else if constexpr (std::is_floating_point_v<T>)
+                    Put(ArgType::Double, static_cast<double>(value));
+                else if constexpr (std::is_pointer_v<T>)
+                    Put(ArgType::Pointer, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+                else
+                    PutString(fmt::format("{}", value)); // The decoder only knows built-in types.
+            }
+
+            const std::byte* Data() const { return m_Data; }
+            size_t Size() const { return m_Size; }
+
+          private:
+            template<typename T>
+            void Put(BinaryLogFormat::ArgType type, const T& value)
+            {
+                Append(&type, sizeof(type));
+                Append(&value, sizeof(value));
+            }
+
+            void PutString(std::string_view text);
+            void Append(const void* data, size_t size);
+
+            static constexpr size_t HeaderSize = sizeof(uint32_t) + sizeof(int64_t) + sizeof(uint8_t);
+            static constexpr size_t MaxArgSize = sizeof(BinaryLogFormat::ArgType) + sizeof(uint64_t);
+
+            std::byte m_Data[HeaderSize + MaxArgs * MaxArgSize + MaxStringBytes];
+            size_t m_Size = 0;
+            size_t m_StringBytes = 0;
+        };
+
+        static uint32_t RegisterFormat(spdlog::logger& logger, spdlog::level::level_enum level, fmt::string_view format);
+        static void Submit(const Record& record);
+        static void WriterThread();
+
+        static spdlog::level::level_enum s_TextLevel;
+    };
+
+    /** @} */
+} // namespace Coffee
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @file BinaryLogFormat.h
+ * @brief Layout of the files written by the BinaryLog, shared with the LogDecoder tool. Has no dependencies so
+ * the tool can be built on its own.
+ *
+ * All values are stored in the byte order of the machine that wrote the file.
+ *
+ * File:
+ * - Magic (4 bytes), Version (u32), then blocks until an End block.
+ *
+ * Blocks, starting with a BlockType (u8):
+ * - Format: ID (u32), Level (u8, spdlog level), logger name length (u16), logger name, format length (u32), format.
+ *   Written once per call site, before the first chunk that uses it.
+ * - Chunk: thread index (u16), size (u32), then size bytes of that thread's record stream. A record may be split
+ *   across consecutive chunks of the same thread.
+ * - End: number of records dropped because a thread buffer was full (u64).
+ *
+ * Records: format ID (u32), time in nanoseconds since the epoch (i64), argument count (u8), then for every
+ * argument an ArgType (u8) followed by its value: the raw bytes of the type, or for strings a length (u32)
+ * followed by the characters.
+ */
+
+namespace Coffee::BinaryLogFormat
+{
+    inline constexpr char Magic[4] = {'C', 'F', 'L', 'G'};
+    inline constexpr uint32_t Version = 1;
+
+    enum class BlockType : uint8_t
+    {
+        Format = 1,
+        Chunk = 2,
+        End = 3
+    };
+
+    enum class ArgType : uint8_t
+    {
+        Bool,
+        Char,
+        Int32,
+        Int64,
+        UInt32,
+        UInt64,
+        Float,
+        Double,
+        Pointer,
+        String
+    };
+} // namespace Coffee::BinaryLogFormat
@@ -0,0 +1,382 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Coffee {
+
+    /**
+     * @defgroup core Core
+     * @{
+     */
+
+    /**
+     * @brief Open-addressing hash map for 64-bit keys such as UUIDs.
+     *
+     * The elements live in one flat array, so a lookup is one multiplication to pick the home slot and a short
+     * linear scan, instead of the bucket and node indirections of std::unordered_map. The probing is Robin Hood:
+     * every slot records how far its element is from its home, elements that are further from home take the
+     * slot of those that are closer, and a lookup stops as soon as it meets an element closer to home than the
+     * key would be. The distances are kept in a separate array, so a probe touches one cache line of distances
+     * and only reads the keys whose distance matches. Erasing shifts the following elements back instead of
+     * leaving tombstones, so lookups don't degrade over time.
+     *
+     * The home slot is taken from the high bits of key * 2^64/phi (Fibonacci hashing). Random keys are spread
+     * evenly anyway; the multiplication also spreads sequential ones.
+     *
+     * Inserting may move elements, which invalidates iterators and references. Erasing only invalidates those of
+     * the erased element and of the elements after it.
+     *
+     * @tparam Key The key type. Must be convertible to uint64_t.
+     * @tparam Value The mapped type. Must be movable. Empty slots hold no object, so values are only constructed
+     * for stored elements; it only has to be default-constructible for operator[] and try_emplace without arguments.
+     */
+    template<typename Key, typename Value>
+    class FlatHashMap
+    {
+      private:
+        template<bool IsConst> class Iterator;
+
+      public:
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = std::pair<const Key, Value>;
+        using size_type = size_t;
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        FlatHashMap() = default;
+
+        /**
+         * @brief Constructs an empty map.
+         * @param capacity The number of elements that can be inserted without growing.
+         */
+        explicit FlatHashMap(size_type capacity) { reserve(capacity); }
+
+        FlatHashMap(const FlatHashMap& other) { *this = other; }
+        FlatHashMap(FlatHashMap&& other) noexcept { swap(other); }
+        ~FlatHashMap() { clear(); }
+
+        FlatHashMap& operator=(const FlatHashMap& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                reserve(other.size());
+                for (const value_type& element : other)
+                    insert_or_assign(element.first, element.second);
+            }
+            return *this;
+        }
+
+        FlatHashMap& operator=(FlatHashMap&& other) noexcept
+        {
+            FlatHashMap(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        void swap(FlatHashMap& other) noexcept
+        {
+            std::swap(m_Slots, other.m_Slots);
+            std::swap(m_Distances, other.m_Distances);
+            std::swap(m_Capacity, other.m_Capacity);
+            std::swap(m_Shift, other.m_Shift);
+            std::swap(m_Size, other.m_Size);
+        }
+
+        /**
+         * @brief Finds an element.
+         * @param key The key.
+         * @return An iterator to the element, or end() if the key is not in the map.
+         */
+        iterator find(const Key& key) { return iterator(this, find_index(key)); }
+        const_iterator find(const Key& key) const { return const_iterator(this, find_index(key)); }
+
+        /**
+         * @brief Checks if a key is in the map.
+         */
+        bool contains(const Key& key) const { return find_index(key) != m_Capacity; }
+        size_type count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+        /**
+         * @brief Gets the value of a key, inserting a default-constructed one if the key is not in the map.
+         */
+        Value& operator[](const Key& key) { return try_emplace(key).first->second; }
+
+        /**
+         * @brief Inserts a value if the key is not in the map yet.
+         * @param key The key.
+         * @param args The arguments the value is constructed from.
+         * @return An iterator to the element with the key, and true if it was inserted.
+         */
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+        {
+            const size_type index = find_index(key);
+            if (index != m_Capacity)
+                return {iterator(this, index), false};
+
+            if ((m_Size + 1) * 8 > m_Capacity * 7 || m_Capacity == 0)
+                rehash(std::max<size_type>(m_Capacity * 2, 16));
+
+            return {iterator(this, insert_new(StoredType(key, Value(std::forward<Args>(args)...)))), true};
+        }
+
+        /**
+         * @brief Inserts a value, or assigns it if the key is already in the map.
+         * @return An iterator to the element, and true if it was inserted.
+         */
+        template<typename V>
+        std::pair<iterator, bool> insert_or_assign(const Key& key, V&& value)
+        {
+            const size_type index = find_index(key);
+            if (index != m_Capacity)
+            {
+                iterator it(this, index);
+                it->second = std::forward<V>(value);
+                return {it, false};
+            }
+            return try_emplace(key, std::forward<V>(value));
+        }
+
+        /**
+         * @brief Removes an element.
+         * @param key The key.
+         * @return The number of elements removed, 0 or 1.
+         */
+        size_type erase(const Key& key)
+        {
+            const size_type index = find_index(key);
+            if (index == m_Capacity)
+                return 0;
+
+            erase_index(index);
+            return 1;
+        }
+
+        /**
+         * @brief Removes an element.
+         * @param position An iterator to the element.
+         * @return An iterator to the element that took its place in the iteration order.
+         * @note When the last slots are erased while iterating, an element that wrapped around to the first
+         * slots can be shifted back and visited a second time.
+         */
+        iterator erase(const_iterator position)
+        {
+            const size_type index = position.m_Index;
+            erase_index(index);
+
+            // The following element may have been shifted into the erased slot.
+            iterator next(this, index);
+            if (m_Distances[index] == 0)
+                ++next;
+            return next;
+        }
+
+        /**
+         * @brief Removes every element, keeping the capacity.
+         */
+        void clear()
+        {
+            for (size_type i = 0; i < m_Capacity; i++)
+            {
+                if (m_Distances[i] != 0)
+                {
+                    m_Slots[i].Stored.~StoredType();
+                    m_Distances[i] = 0;
+                }
+            }
+            m_Size = 0;
+        }
+
+        /**
+         * @brief Grows the map so it can hold a number of elements without rehashing.
+         */
+        void reserve(size_type count)
+        {
+            const size_type capacity = std::bit_ceil(std::max<size_type>((count * 8 + 6) / 7, 16));
+            if (capacity > m_Capacity)
+                rehash(capacity);
+        }
+
+        size_type size() const { return m_Size; }
+        bool empty() const { return m_Size == 0; }
+        size_type capacity() const { return m_Capacity * 7 / 8; }
+
+        iterator begin() { return ++iterator(this, size_type(-1)); }
+        iterator end() { return iterator(this, m_Capacity); }
+        const_iterator begin() const { return ++const_iterator(this, size_type(-1)); }
+        const_iterator end() const { return const_iterator(this, m_Capacity); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+
+      private:
+        // Distances are stored + 1 so 0 means empty. 16 bits, so even a badly clustered map can't overflow them.
+        using Distance = uint16_t;
+
+        // The map moves elements between slots, which needs an assignable key, but the iterators must not let
+        // callers change a key in place. Slots store a pair with a mutable key and hand out the same object as a
+        // pair with a const key; both pairs have the same layout, as in the node-less maps of Abseil.
+        using StoredType = std::pair<Key, Value>;
+        static_assert(sizeof(StoredType) == sizeof(value_type) && alignof(StoredType) == alignof(value_type));
+
+        // Only constructed while the slot is occupied.
+        union Slot
+        {
+            Slot() {}
+            ~Slot() {}
+
+            value_type Element; ///< The element as seen through the iterators.
+            StoredType Stored; ///< The element as constructed, moved and destroyed by the map.
+        };
+
+        template<bool IsConst>
+        class Iterator
+        {
+          public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = FlatHashMap::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+            using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+            using Map = std::conditional_t<IsConst, const FlatHashMap, FlatHashMap>;
+
+            Iterator() = default;
+            Iterator(Map* map, size_type index) : m_Map(map), m_Index(index) {}
+            operator Iterator<true>() const { return Iterator<true>(m_Map, m_Index); }
+
+            reference operator*() const { return *std::launder(&m_Map->m_Slots[m_Index].Element); }
+            pointer operator->() const { return std::launder(&m_Map->m_Slots[m_Index].Element); }
+
+            Iterator& operator++()
+            {
+                do
+                    m_Index++;
+                while (m_Index < m_Map->m_Capacity && m_Map->m_Distances[m_Index] == 0);
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator previous = *this;
+                ++*this;
+                return previous;
+            }
+
+            bool operator==(const Iterator& other) const { return m_Index == other.m_Index; }
+
+          private:
+            friend class FlatHashMap;
+
+            Map* m_Map = nullptr;
+            size_type m_Index = 0;
+        };
+
+        size_type home(const Key& key) const
+        {
+            return static_cast<size_type>((static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ull) >> m_Shift);
+        }
+
+        size_type find_index(const Key& key) const
+        {
+            if (m_Size == 0)
+                return m_Capacity;
+
+            const size_type mask = m_Capacity - 1;
+            size_type index = home(key);
+            for (Distance distance = 1; distance <= m_Distances[index]; distance++)
+            {
+                if (m_Distances[index] == distance && static_cast<uint64_t>(m_Slots[index].Stored.first) == static_cast<uint64_t>(key))
+                    return index;
+                index = (index + 1) & mask;
+            }
+            return m_Capacity;
+        }
+
+        /**
+         * Inserts an element whose key is not in the map, there must be room for it. Returns where it ended up.
+         */
+        size_type insert_new(StoredType&& element)
+        {
+            const size_type mask = m_Capacity - 1;
+            size_type index = home(element.first);
+            Distance distance = 1;
+            size_type inserted = m_Capacity;
+
+            while (m_Distances[index] != 0)
+            {
+                // Robin Hood: take the slot of an element closer to its home, and carry that one on.
+                if (m_Distances[index] < distance)
+                {
+                    std::swap(element, m_Slots[index].Stored);
+                    std::swap(distance, m_Distances[index]);
+                    if (inserted == m_Capacity)
+                        inserted = index;
+                }
+                index = (index + 1) & mask;
+                distance++;
+            }
+
+            new (&m_Slots[index].Stored) StoredType(std::move(element));
+            m_Distances[index] = distance;
+            m_Size++;
+            return inserted == m_Capacity ? index : inserted;
+        }
+
+        void erase_index(size_type index)
+        {
+            const size_type mask = m_Capacity - 1;
+
+            // Shift the following elements back until one is already at home or the slot is empty.
+            size_type next = (index + 1) & mask;
+            while (m_Distances[next] > 1)
+            {
+                m_Slots[index].Stored = std::move(m_Slots[next].Stored);
+                m_Distances[index] = m_Distances[next] - 1;
+                index = next;
+                next = (next + 1) & mask;
+            }
+
+            m_Slots[index].Stored.~StoredType();
+            m_Distances[index] = 0;
+            m_Size--;
+        }
+
+        void rehash(size_type capacity)
+        {
+            std::unique_ptr<Slot[]> slots = std::move(m_Slots);
+            std::unique_ptr<Distance[]> distances = std::move(m_Distances);
+            const size_type oldCapacity = m_Capacity;
+
+            m_Slots = std::make_unique<Slot[]>(capacity);
+            m_Distances = std::make_unique<Distance[]>(capacity); // Value-initialized: all empty.
+            m_Capacity = capacity;
+            m_Shift = 64 - std::countr_zero(capacity);
+            m_Size = 0;
+
+            for (size_type i = 0; i < oldCapacity; i++)
+            {
+                if (distances[i] != 0)
+                {
+                    insert_new(std::move(slots[i].Stored));
+                    slots[i].Stored.~StoredType();
+                }
+            }
+        }
+
+        std::unique_ptr<Slot[]> m_Slots;
+        std::unique_ptr<Distance[]> m_Distances;
+        size_type m_Capacity = 0;
+        uint32_t m_Shift = 64;
+        size_type m_Size = 0;
+    };
+
+    /** @} */
+} // namespace Coffee
@@ -0,0 +1,470 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace Coffee {
+
+    /**
+     * @defgroup core Core
+     * @{
+     */
+
+    /**
+     * @brief Size of a cache line, used to keep the producer and consumer indices from sharing one.
+     */
+    inline constexpr size_t CacheLineSize = 64;
+
+    /**
+     * @brief Lock-free single-producer/single-consumer ring buffer.
+     *
+     * A bounded FIFO with the same interface as CircularBuffer, but without the mutex: exactly one thread may
+     * push and exactly one thread may pop at the same time. Unlike CircularBuffer it never overwrites, pushing
+     * into a full buffer fails. The capacity is rounded up to a power of two so wrapping is a mask, and the
+     * indices grow monotonically, which tells a full buffer from an empty one without wasting a slot.
+     *
+     * Each side keeps a cached copy of the other side's index on its own cache line, so the shared indices are
+     * only read when the cached value says the buffer looks full (producer) or empty (consumer).
+     *
+     * front(), operator[], pop_n and the iterators belong to the consumer; they only see the elements that were
+     * published when they were called.
+     *
+     * @tparam T The element type. Must be default-constructible and move-assignable.
+     */
+    template<typename T>
+    class SPSCRingBuffer
+    {
+      private:
+        template<bool IsConst> class Iterator;
+
+      public:
+        using value_type = T;
+        using size_type = size_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        /**
+         * @brief Constructs an empty ring buffer.
+         * @param capacity The minimum number of elements the buffer can hold. Rounded up to a power of two.
+         */
+        explicit SPSCRingBuffer(size_type capacity)
+            : m_Capacity(std::bit_ceil(std::max<size_type>(capacity, 2))), m_Mask(m_Capacity - 1),
+              m_Buffer(std::make_unique<T[]>(m_Capacity))
+        {
+        }
+
+        SPSCRingBuffer(const SPSCRingBuffer&) = delete;
+        SPSCRingBuffer& operator=(const SPSCRingBuffer&) = delete;
+
+        /**
+         * @brief Pushes an element. Producer only.
+         * @param value The element.
+         * @return True if the element was pushed, false if the buffer is full.
+         */
+        bool push_back(const value_type& value) { return emplace_back(value); }
+        bool push_back(value_type&& value) { return emplace_back(std::move(value)); }
+
+        /**
+         * @brief Pushes an element assigned from the arguments. Producer only.
+         * @return True if the element was pushed, false if the buffer is full.
+         */
+        template<typename... Args>
+        bool emplace_back(Args&&... args)
+        {
+            const size_type head = m_Head.load(std::memory_order_relaxed);
+            if (head - m_ProducerTail == m_Capacity)
+            {
+                m_ProducerTail = m_Tail.load(std::memory_order_acquire);
+                if (head - m_ProducerTail == m_Capacity)
+                    return false;
+            }
+
+            m_Buffer[head & m_Mask] = T(std::forward<Args>(args)...);
+            m_Head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Pushes as many elements of an array as fit, copying them in at most two contiguous runs and
+         * publishing them at once. Producer only.
+         * @param items The elements.
+         * @param count The number of elements.
+         * @return The number of elements pushed.
+         */
+        size_type push_n(const value_type* items, size_type count)
+        {
+            const size_type head = m_Head.load(std::memory_order_relaxed);
+            if (m_Capacity - (head - m_ProducerTail) < count)
+                m_ProducerTail = m_Tail.load(std::memory_order_acquire);
+
+            count = std::min(count, m_Capacity - (head - m_ProducerTail));
+            if (count == 0)
+                return 0;
+
+            const size_type start = head & m_Mask;
+            const size_type firstRun = std::min(count, m_Capacity - start);
+            std::copy_n(items, firstRun, m_Buffer.get() + start);
+            std::copy_n(items + firstRun, count - firstRun, m_Buffer.get());
+
+            m_Head.store(head + count, std::memory_order_release);
+            return count;
+        }
+
+        /**
+         * @brief Gets the oldest element. Consumer only.
+         * @return The oldest element.
+         * @note The buffer must not be empty.
+         */
+        reference front() { return m_Buffer[m_Tail.load(std::memory_order_relaxed) & m_Mask]; }
+        const_reference front() const { return m_Buffer[m_Tail.load(std::memory_order_relaxed) & m_Mask]; }
+
+        /**
+         * @brief Removes the oldest element. Consumer only.
+         * @return True if an element was removed, false if the buffer is empty.
+         */
+        bool pop_front()
+        {
+            const size_type tail = m_Tail.load(std::memory_order_relaxed);
+            if (!consumer_readable(tail, 1))
+                return false;
+
+            m_Tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Moves the oldest element out and removes it. Consumer only.
+         * @param out Receives the element.
+         * @return True if an element was popped, false if the buffer is empty.
+         */
+        bool pop_front(value_type& out)
+        {
+            const size_type tail = m_Tail.load(std::memory_order_relaxed);
+            if (!consumer_readable(tail, 1))
+                return false;
+
+            out = std::move(m_Buffer[tail & m_Mask]);
+            m_Tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Pops up to count elements into an array, moving them in at most two contiguous runs and
+         * releasing their slots at once. Consumer only.
+         * @param out The array that receives the elements.
+         * @param count The maximum number of elements to pop.
+         * @return The number of elements popped.
+         */
+        size_type pop_n(value_type* out, size_type count)
+        {
+            const size_type tail = m_Tail.load(std::memory_order_relaxed);
+            if (m_ConsumerHead - tail < count)
+                m_ConsumerHead = m_Head.load(std::memory_order_acquire);
+
+            count = std::min(count, m_ConsumerHead - tail);
+            if (count == 0)
+                return 0;
+
+            const size_type start = tail & m_Mask;
+            const size_type firstRun = std::min(count, m_Capacity - start);
+            std::move(m_Buffer.get() + start, m_Buffer.get() + start + firstRun, out);
+            std::move(m_Buffer.get(), m_Buffer.get() + (count - firstRun), out + firstRun);
+
+            m_Tail.store(tail + count, std::memory_order_release);
+            return count;
+        }
+
+        /**
+         * @brief Removes every element. Consumer only.
+         */
+        void clear() { m_Tail.store(m_Head.load(std::memory_order_acquire), std::memory_order_release); }
+
+        /**
+         * @brief Gets an element by its position from the oldest one. Consumer only.
+         * @param index The position, which must be lower than size().
+         * @return The element.
+         */
+        reference operator[](size_type index)
+        {
+            return m_Buffer[(m_Tail.load(std::memory_order_relaxed) + index) & m_Mask];
+        }
+        const_reference operator[](size_type index) const
+        {
+            return m_Buffer[(m_Tail.load(std::memory_order_relaxed) + index) & m_Mask];
+        }
+
+        iterator begin() { return iterator(this, m_Tail.load(std::memory_order_relaxed)); }
+        iterator end() { return iterator(this, m_Head.load(std::memory_order_acquire)); }
+        const_iterator begin() const { return const_iterator(this, m_Tail.load(std::memory_order_relaxed)); }
+        const_iterator end() const { return const_iterator(this, m_Head.load(std::memory_order_acquire)); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+
+        /**
+         * @brief Gets the number of elements. Exact from the producer or consumer thread, a snapshot from any
+         * other thread.
+         */
+        size_type size() const
+        {
+            const size_type tail = m_Tail.load(std::memory_order_acquire);
+            return m_Head.load(std::memory_order_acquire) - tail;
+        }
+
+        bool empty() const { return size() == 0; }
+        bool full() const { return size() == m_Capacity; }
+        size_type capacity() const { return m_Capacity; }
+
+      private:
+        bool consumer_readable(size_type tail, size_type count)
+        {
+            if (m_ConsumerHead - tail >= count)
+                return true;
+
+            m_ConsumerHead = m_Head.load(std::memory_order_acquire);
+            return m_ConsumerHead - tail >= count;
+        }
+
+        template<bool IsConst>
+        class Iterator
+        {
+          public:
+            using iterator_category = std::random_access_iterator_tag;
+            using difference_type = std::ptrdiff_t;
+            using value_type = T;
+            using reference = std::conditional_t<IsConst, const T&, T&>;
+            using pointer = std::conditional_t<IsConst, const T*, T*>;
+            using owner_pointer = std::conditional_t<IsConst, const SPSCRingBuffer*, SPSCRingBuffer*>;
+
+            Iterator() = default;
+            Iterator(owner_pointer owner, size_type position) : m_Owner(owner), m_Position(position) {}
+            operator Iterator<true>() const { return Iterator<true>(m_Owner, m_Position); }
+
+            reference operator*() const { return m_Owner->m_Buffer[m_Position & m_Owner->m_Mask]; }
+            pointer operator->() const { return &**this; }
+            reference operator[](difference_type n) const { return *(*this + n); }
+
+            Iterator& operator++() { ++m_Position; return *this; }
+            Iterator operator++(int) { Iterator it = *this; ++m_Position; return it; }
+            Iterator& operator--() { --m_Position; return *this; }
+            Iterator operator--(int) { Iterator it = *this; --m_Position; return it; }
+            Iterator& operator+=(difference_type n) { m_Position += n; return *this; }
+            Iterator& operator-=(difference_type n) { m_Position -= n; return *this; }
+
+            friend Iterator operator+(Iterator it, difference_type n) { return it += n; }
+            friend Iterator operator+(difference_type n, Iterator it) { return it += n; }
+            friend Iterator operator-(Iterator it, difference_type n) { return it -= n; }
+            friend difference_type operator-(const Iterator& lhs, const Iterator& rhs)
+            {
+                return static_cast<difference_type>(lhs.m_Position - rhs.m_Position);
+            }
+
+            bool operator==(const Iterator& other) const { return m_Position == other.m_Position; }
+            auto operator<=>(const Iterator& other) const { return *this - other <=> 0; }
+
+          private:
+            owner_pointer m_Owner = nullptr;
+            size_type m_Position = 0; ///< Monotonic position, masked on access.
+        };
+
+        const size_type m_Capacity;
+        const size_type m_Mask;
+        std::unique_ptr<T[]> m_Buffer;
+
+        alignas(CacheLineSize) std::atomic<size_type> m_Head{0}; ///< Next position to write, owned by the producer.
+        size_type m_ProducerTail = 0; ///< The producer's cached copy of m_Tail.
+
+        alignas(CacheLineSize) std::atomic<size_type> m_Tail{0}; ///< Next position to read, owned by the consumer.
+        size_type m_ConsumerHead = 0; ///< The consumer's cached copy of m_Head.
+    };
+
+    /**
+     * @brief Bounded lock-free multi-producer/multi-consumer ring buffer.
+     *
+     * Every slot carries a sequence number that says whether it is ready to be written or read for the current
+     * lap, so producers and consumers only contend on their own index with a single compare-and-swap and never
+     * wait on each other (Vyukov's bounded queue). Pushing into a full buffer and popping from an empty one fail
+     * instead of blocking.
+     *
+     * push_n and pop_n claim a whole run of consecutive slots with one compare-and-swap, so a batch stays in
+     * order and is never interleaved with other producers' elements. There is no iteration or indexing, the
+     * contents are only meaningful to the thread that pops them.
+     *
+     * @tparam T The element type. Must be default-constructible and move-assignable.
+     */
+    template<typename T>
+    class MPMCRingBuffer
+    {
+      public:
+        using value_type = T;
+        using size_type = size_t;
+
+        /**
+         * @brief Constructs an empty ring buffer.
+         * @param capacity The minimum number of elements the buffer can hold. Rounded up to a power of two.
+         */
+        explicit MPMCRingBuffer(size_type capacity)
+            : m_Capacity(std::bit_ceil(std::max<size_type>(capacity, 2))), m_Mask(m_Capacity - 1),
+              m_Slots(std::make_unique<Slot[]>(m_Capacity))
+        {
+            for (size_type i = 0; i < m_Capacity; i++)
+                m_Slots[i].Sequence.store(i, std::memory_order_relaxed);
+        }
+
+        MPMCRingBuffer(const MPMCRingBuffer&) = delete;
+        MPMCRingBuffer& operator=(const MPMCRingBuffer&) = delete;
+
+        /**
+         * @brief Pushes an element.
+         * @param value The element.
+         * @return True if the element was pushed, false if the buffer is full.
+         */
+        bool push_back(const value_type& value) { return emplace_back(value); }
+        bool push_back(value_type&& value) { return emplace_back(std::move(value)); }
+
+        /**
+         * @brief Pushes an element assigned from the arguments.
+         * @return True if the element was pushed, false if the buffer is full.
+         */
+        template<typename... Args>
+        bool emplace_back(Args&&... args)
+        {
+            const auto [position, count] = claim(m_EnqueuePos, 0, 1);
+            if (count == 0)
+                return false;
+
+            Slot& slot = m_Slots[position & m_Mask];
+            slot.Value = T(std::forward<Args>(args)...);
+            slot.Sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Pushes as many elements of an array as there are free consecutive slots.
+         * @param items The elements.
+         * @param count The number of elements.
+         * @return The number of elements pushed. They are popped in order and without other elements between them.
+         */
+        size_type push_n(const value_type* items, size_type count)
+        {
+            const auto [position, claimed] = claim(m_EnqueuePos, 0, count);
+            for (size_type i = 0; i < claimed; i++)
+            {
+                Slot& slot = m_Slots[(position + i) & m_Mask];
+                slot.Value = items[i];
+                slot.Sequence.store(position + i + 1, std::memory_order_release);
+            }
+            return claimed;
+        }
+
+        /**
+         * @brief Moves the oldest element out and removes it.
+         * @param out Receives the element.
+         * @return True if an element was popped, false if the buffer is empty.
+         */
+        bool pop_front(value_type& out) { return pop_n(&out, 1) == 1; }
+
+        /**
+         * @brief Pops up to count consecutive elements into an array.
+         * @param out The array that receives the elements.
+         * @param count The maximum number of elements to pop.
+         * @return The number of elements popped.
+         */
+        size_type pop_n(value_type* out, size_type count)
+        {
+            const auto [position, claimed] = claim(m_DequeuePos, 1, count);
+            for (size_type i = 0; i < claimed; i++)
+            {
+                Slot& slot = m_Slots[(position + i) & m_Mask];
+                out[i] = std::move(slot.Value);
+                slot.Sequence.store(position + i + m_Capacity, std::memory_order_release);
+            }
+            return claimed;
+        }
+
+        /**
+         * @brief Gets an approximate number of elements; other threads may change it at any time.
+         */
+        size_type size() const
+        {
+            const size_type dequeue = m_DequeuePos.load(std::memory_order_acquire);
+            const size_type enqueue = m_EnqueuePos.load(std::memory_order_acquire);
+            return enqueue > dequeue ? std::min(enqueue - dequeue, m_Capacity) : 0;
+        }
+
+        bool empty() const { return size() == 0; }
+        bool full() const { return size() == m_Capacity; }
+        size_type capacity() const { return m_Capacity; }
+
+      private:
+        struct Slot
+        {
+            std::atomic<size_type> Sequence{0};
+            T Value{};
+        };
+
+        struct Claim
+        {
+            size_type Position;
+            size_type Count;
+        };
+
+        /**
+         * @brief Reserves up to maxCount consecutive slots starting at an index.
+         *
+         * A slot at position p is ready for producers when its sequence is p and for consumers when it is p + 1
+         * (the readyOffset). The run ends at the first slot that is not ready; the whole run is then taken with a
+         * single compare-and-swap of the index, retrying if another thread moved it first.
+         */
+        Claim claim(std::atomic<size_type>& index, size_type readyOffset, size_type maxCount)
+        {
+            maxCount = std::min(maxCount, m_Capacity);
+            size_type position = index.load(std::memory_order_relaxed);
+
+            while (maxCount > 0)
+            {
+                const size_type sequence = m_Slots[position & m_Mask].Sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::intptr_t>(sequence - (position + readyOffset));
+
+                if (diff < 0)
+                    return {position, 0}; // Full (producers) or empty (consumers).
+                if (diff > 0)
+                {
+                    position = index.load(std::memory_order_relaxed); // Another thread took this slot.
+                    continue;
+                }
+
+                size_type count = 1;
+                while (count < maxCount &&
+                       m_Slots[(position + count) & m_Mask].Sequence.load(std::memory_order_acquire) ==
+                           position + count + readyOffset)
+                {
+                    count++;
+                }
+
+                if (index.compare_exchange_weak(position, position + count, std::memory_order_relaxed))
+                    return {position, count};
+            }
+
+            return {position, 0};
+        }
+
+        const size_type m_Capacity;
+        const size_type m_Mask;
+        std::unique_ptr<Slot[]> m_Slots;
+
+        alignas(CacheLineSize) std::atomic<size_type> m_EnqueuePos{0};
+        alignas(CacheLineSize) std::atomic<size_type> m_DequeuePos{0};
+    };
+
+    /** @} */
+} // namespace Coffee
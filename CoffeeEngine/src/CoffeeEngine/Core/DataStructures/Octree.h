@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CoffeeEngine/Core/Base.h"
+#include "CoffeeEngine/Core/FrameAllocator.h"
 #include "CoffeeEngine/Math/BoundingBox.h"
 #include "CoffeeEngine/Math/Frustum.h"
 #include "CoffeeEngine/Renderer/Mesh.h"
@@ -43,7 +44,10 @@ namespace Coffee {
         void DebugDraw();
         void Clear();
 
-        std::vector<ObjectContainer<T>> Query(const Frustum& frustum) const;
+        /**
+         * @brief Gets the objects inside a frustum. The result is allocated from the frame arena.
+         */
+        FrameVector<ObjectContainer<T>> Query(const Frustum& frustum) const;
 
     private:
         void Insert(OctreeNode<T>& node, const ObjectContainer<T>& object);
@@ -53,7 +57,7 @@ namespace Coffee {
         void Subdivide(OctreeNode<T>& node);
         void CreateChildren(OctreeNode<T>& node, const glm::vec3& center);
 
-        void Query(const OctreeNode<T>& node, const Frustum& frustum, std::vector<ObjectContainer<T>>& results) const;
+        void Query(const OctreeNode<T>& node, const Frustum& frustum, FrameVector<ObjectContainer<T>>& results) const;
 
         OctreeNode<T> rootNode;
         int maxObjectsPerNode;
@@ -139,7 +143,7 @@ namespace Coffee {
     }
 
     template <typename T>
-    void Octree<T>::Query(const OctreeNode<T>& node, const Frustum& frustum, std::vector<ObjectContainer<T>>& results) const
+    void Octree<T>::Query(const OctreeNode<T>& node, const Frustum& frustum, FrameVector<ObjectContainer<T>>& results) const
     {
         if (!frustum.Contains(node.aabb))
             return;
@@ -236,9 +240,9 @@ namespace Coffee {
     }
 
     template <typename T>
-    std::vector<ObjectContainer<T>> Octree<T>::Query(const Frustum& frustum) const
+    FrameVector<ObjectContainer<T>> Octree<T>::Query(const Frustum& frustum) const
     {
-        std::vector<ObjectContainer<T>> results;
+        FrameVector<ObjectContainer<T>> results;
         Query(rootNode, frustum, results);
         return results;
     }
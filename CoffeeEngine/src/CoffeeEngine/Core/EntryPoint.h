@@ -7,9 +7,12 @@ int main(int argc, const char** argv)
     Coffee::Log::Init();
     COFFEE_CORE_WARN("Initialized Log!");
 
+    Coffee::Application::SetSettings(Coffee::ApplicationSettings::FromCommandLine(argc, argv));
+
     auto app = Coffee::CreateApplication();
     app->Run();
     delete app;
 
+    Coffee::Log::Shutdown();
     return 0;
 }
@@ -0,0 +1,63 @@
+#include "CoffeeEngine/Core/FrameAllocator.h"
+
+#include "CoffeeEngine/Core/Assert.h"
+#include "CoffeeEngine/Core/JobSystem.h"
+
+#include <memory>
+
+namespace Coffee {
+
+    struct FrameAllocatorData
+    {
+        std::vector<std::unique_ptr<LinearArena>> Arenas[2]; ///< One arena per thread for each buffer.
+        uint32_t CurrentBuffer = 0;
+    };
+
+    static FrameAllocatorData s_FrameAllocatorData;
+
+    void FrameAllocator::Init(uint32_t threadCount, size_t blockSize)
+    {
+        for (auto& arenas : s_FrameAllocatorData.Arenas)
+        {
+            arenas.clear();
+            for (uint32_t i = 0; i < threadCount; i++)
+                arenas.push_back(std::make_unique<LinearArena>(blockSize));
+        }
+        s_FrameAllocatorData.CurrentBuffer = 0;
+    }
+
+    void FrameAllocator::Shutdown()
+    {
+        for (auto& arenas : s_FrameAllocatorData.Arenas)
+            arenas.clear();
+    }
+
+    void FrameAllocator::BeginFrame()
+    {
+        s_FrameAllocatorData.CurrentBuffer ^= 1;
+
+        for (auto& arena : s_FrameAllocatorData.Arenas[s_FrameAllocatorData.CurrentBuffer])
+            arena->Reset();
+    }
+
+    LinearArena& FrameAllocator::GetArena()
+    {
+        auto& arenas = s_FrameAllocatorData.Arenas[s_FrameAllocatorData.CurrentBuffer];
+        const uint32_t threadIndex = JobSystem::GetThreadIndex();
+
+        // Threads the JobSystem doesn't own (logging, telemetry, audio callbacks) have no arena; sharing the main
+        // thread's one would be a data race.
+        COFFEE_CORE_ASSERT(threadIndex != JobSystem::InvalidThreadIndex, "FrameAllocator used from a thread that is not a JobSystem thread!");
+        COFFEE_CORE_ASSERT(threadIndex < arenas.size(), "FrameAllocator used before Init!");
+        return *arenas[threadIndex];
+    }
+
+    size_t FrameAllocator::GetUsedBytes()
+    {
+        size_t used = 0;
+        for (const auto& arena : s_FrameAllocatorData.Arenas[s_FrameAllocatorData.CurrentBuffer])
+            used += arena->GetUsedBytes();
+        return used;
+    }
+
+} // namespace Coffee
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "CoffeeEngine/Core/LinearArena.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace Coffee {
+
+    /**
+     * @defgroup core Core
+     * @{
+     */
+
+    /**
+     * @brief Double-buffered per-frame arenas for transient data.
+     *
+     * Every thread of the JobSystem gets its own pair of arenas, so allocating never takes a lock. BeginFrame
+     * swaps to the other buffer and resets it, which means frame memory stays valid until the end of the next
+     * frame: data built in one frame can still be read by the next one (e.g. by a render pass running one frame
+     * behind), but nothing allocated here may be kept longer than that.
+     *
+     * Only the main thread and JobSystem workers may allocate from it; other threads trip an assert in GetArena.
+     */
+    class FrameAllocator
+    {
+      public:
+        /**
+         * @brief Creates the arenas.
+         * @param threadCount The number of threads that allocate, usually JobSystem::GetWorkerCount() + 1.
+         * @param blockSize The block size of each arena, in bytes.
+         */
+        static void Init(uint32_t threadCount, size_t blockSize = 1024 * 1024);
+
+        /**
+         * @brief Destroys the arenas.
+         */
+        static void Shutdown();
+
+        /**
+         * @brief Starts a new frame: swaps the buffers and resets the arenas of the new current buffer.
+         */
+        static void BeginFrame();
+
+        /**
+         * @brief Gets the current frame arena of the calling thread.
+         * @return The arena.
+         */
+        static LinearArena& GetArena();
+
+        /**
+         * @brief Allocates memory for the current frame from the calling thread's arena.
+         * @param size The size of the allocation, in bytes.
+         * @param alignment The alignment of the allocation.
+         * @return A pointer to the memory, valid until the end of the next frame.
+         */
+        static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+        {
+            return GetArena().Allocate(size, alignment);
+        }
+
+        /**
+         * @brief Gets the memory used by the current frame across all threads.
+         * @return The number of used bytes.
+         */
+        static size_t GetUsedBytes();
+    };
+
+    /**
+     * @brief STL allocator that allocates from a LinearArena.
+     *
+     * A default-constructed adapter allocates from the calling thread's current frame arena, looked up at
+     * allocation time, so containers using it can be declared statically. Deallocation is a no-op; the memory
+     * is reclaimed when the arena is reset. Containers using it must not outlive the frame after the one they
+     * were filled in.
+     */
+    template<typename T>
+    class FrameAllocatorAdapter
+    {
+      public:
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+        using is_always_equal = std::false_type;
+
+        FrameAllocatorAdapter() = default;
+        explicit FrameAllocatorAdapter(LinearArena& arena) : m_Arena(&arena) {}
+
+        template<typename U>
+        FrameAllocatorAdapter(const FrameAllocatorAdapter<U>& other) : m_Arena(other.GetArena())
+        {
+        }
+
+        T* allocate(size_t count)
+        {
+            LinearArena& arena = m_Arena ? *m_Arena : FrameAllocator::GetArena();
+            return arena.AllocateArray<T>(count);
+        }
+        void deallocate(T*, size_t) {}
+
+        LinearArena* GetArena() const { return m_Arena; }
+
+        template<typename U>
+        bool operator==(const FrameAllocatorAdapter<U>& other) const
+        {
+            return m_Arena == other.GetArena();
+        }
+
+      private:
+        LinearArena* m_Arena = nullptr; ///< The arena, or nullptr for the current frame arena.
+    };
+
+    /**
+     * @brief A std::vector allocated from the frame arena.
+     */
+    template<typename T>
+    using FrameVector = std::vector<T, FrameAllocatorAdapter<T>>;
+
+    /**
+     * @brief Scratch allocations that are freed when the scope ends.
+     *
+     * Rewinds the calling thread's frame arena to where it was when the scope was created, so temporary buffers
+     * inside a function don't add to the frame's footprint. Nothing allocated inside the scope may escape it.
+     */
+    class TempAllocatorScope
+    {
+      public:
+        TempAllocatorScope() : m_Arena(FrameAllocator::GetArena()), m_Marker(m_Arena.GetMarker()) {}
+        ~TempAllocatorScope() { m_Arena.Rewind(m_Marker); }
+
+        TempAllocatorScope(const TempAllocatorScope&) = delete;
+        TempAllocatorScope& operator=(const TempAllocatorScope&) = delete;
+
+        /**
+         * @brief Allocates scratch memory.
+         * @param size The size of the allocation, in bytes.
+         * @param alignment The alignment of the allocation.
+         * @return A pointer to the memory, valid until the scope ends.
+         */
+        void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+        {
+            return m_Arena.Allocate(size, alignment);
+        }
+
+        /**
+         * @brief Gets an STL allocator for containers that live inside the scope.
+         * @tparam T The element type.
+         * @return The allocator.
+         */
+        template<typename T>
+        FrameAllocatorAdapter<T> GetAllocator() const
+        {
+            return FrameAllocatorAdapter<T>(m_Arena);
+        }
+
+      private:
+        LinearArena& m_Arena;
+        LinearArena::Marker m_Marker;
+    };
+
+    /** @} */
+} // namespace Coffee
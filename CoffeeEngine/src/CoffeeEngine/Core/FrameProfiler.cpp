@@ -0,0 +1,324 @@
+#include "CoffeeEngine/Core/FrameProfiler.h"
+
+#include "CoffeeEngine/Core/DataStructures/LockFreeRingBuffer.h"
+#include "CoffeeEngine/Core/JobSystem.h"
+#include "CoffeeEngine/Core/Log.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Coffee {
+
+    struct ThreadProfile
+    {
+        ThreadProfile(uint16_t index, std::string name, uint32_t capacity)
+            : Index(index), Name(std::move(name)), Zones(capacity)
+        {
+        }
+
+        uint16_t Index;
+        uint16_t Depth = 0;
+        std::string Name;
+        SPSCRingBuffer<ProfileZone> Zones; ///< Written by the owning thread, drained by BeginFrame.
+        std::atomic<uint64_t> Dropped = 0;
+    };
+
+    struct FrameProfilerData
+    {
+        static constexpr uint16_t MaxThreads = 256;
+
+        std::atomic<bool> Enabled = false;
+        uint32_t ZonesPerThread = 16 * 1024;
+        std::thread::id MainThread;
+
+        // Thread profiles are never freed, so threads can keep their pointer for their whole lifetime. The array
+        // is fixed so the main thread can read it while other threads register.
+        std::mutex RegisterMutex;
+        std::array<std::unique_ptr<ThreadProfile>, MaxThreads> Threads;
+        std::atomic<uint16_t> ThreadCount = 0;
+
+        std::vector<ProfileFrame> History; ///< Ring of the last frames, HistoryHead being the next one written.
+        uint32_t HistoryHead = 0;
+        uint32_t FrameCount = 0;
+        uint64_t FrameNumber = 0;
+        uint64_t FrameStart = 0;
+
+        float SpikeThreshold = 0.0f;
+        std::filesystem::path SpikeDirectory = ".";
+        uint64_t NextSpikeFrame = 0;
+        JobCounter SpikeExport;
+    };
+
+    static FrameProfilerData s_FrameProfilerData;
+    static thread_local ThreadProfile* s_ThreadProfile = nullptr;
+
+    static ThreadProfile* RegisterThread()
+    {
+        auto& data = s_FrameProfilerData;
+        std::lock_guard lock(data.RegisterMutex);
+
+        const uint16_t index = data.ThreadCount.load(std::memory_order_relaxed);
+        if (index == FrameProfilerData::MaxThreads)
+            return nullptr;
+
+        std::string name;
+        if (std::this_thread::get_id() == data.MainThread)
+            name = "Main Thread";
+        else if (JobSystem::GetThreadIndex() > 0)
+            name = "Worker " + std::to_string(JobSystem::GetThreadIndex());
+        else
+            name = "Thread " + std::to_string(index);
+
+        data.Threads[index] = std::make_unique<ThreadProfile>(index, std::move(name), data.ZonesPerThread);
+        data.ThreadCount.store(index + 1, std::memory_order_release);
+
+        s_ThreadProfile = data.Threads[index].get();
+        return s_ThreadProfile;
+    }
+
+    static void WriteEscaped(std::ostream& out, const char* text)
+    {
+        for (; *text; text++)
+        {
+            if (*text == '"' || *text == '\\')
+                out << '\\';
+            out << *text;
+        }
+    }
+
+    static bool WriteChromeTrace(const std::filesystem::path& path, const std::vector<ProfileFrame>& frames,
+                                 const std::vector<std::string>& threadNames)
+    {
+        std::ofstream file(path);
+        if (!file)
+        {
+            COFFEE_CORE_ERROR("FrameProfiler::ExportChromeTrace: Could not open {0}", path.string());
+            return false;
+        }
+
+        const double ticksToMicroseconds = 1000000.0 / SDL_GetPerformanceFrequency();
+        const uint64_t origin = frames.empty() ? 0 : frames.front().Start;
+        const auto timestamp = [&](uint64_t ticks) { return (ticks - std::min(ticks, origin)) * ticksToMicroseconds; };
+        const size_t frameTrack = threadNames.size();
+
+        file << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+
+        bool first = true;
+        const auto beginEvent = [&]() {
+            file << (first ? "\n" : ",\n");
+            first = false;
+        };
+
+        for (size_t i = 0; i <= threadNames.size(); i++)
+        {
+            beginEvent();
+            file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << i << ",\"args\":{\"name\":\"";
+            WriteEscaped(file, i < frameTrack ? threadNames[i].c_str() : "Frames");
+            file << "\"}}";
+        }
+
+        for (const ProfileFrame& frame : frames)
+        {
+            beginEvent();
+            file << "{\"name\":\"Frame " << frame.Number << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << frameTrack
+                 << ",\"ts\":" << timestamp(frame.Start) << ",\"dur\":" << (frame.End - frame.Start) * ticksToMicroseconds
+                 << "}";
+
+            for (const ProfileZone& zone : frame.Zones)
+            {
+                beginEvent();
+                file << "{\"name\":\"";
+                WriteEscaped(file, zone.Name);
+                file << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << zone.ThreadIndex << ",\"ts\":" << timestamp(zone.Start)
+                     << ",\"dur\":" << (zone.End - zone.Start) * ticksToMicroseconds << "}";
+            }
+        }
+
+        file << "\n]}\n";
+        return file.good();
+    }
+
+    static std::vector<ProfileFrame> CopyHistory()
+    {
+        std::vector<ProfileFrame> frames;
+        frames.reserve(FrameProfiler::GetFrameCount());
+        for (uint32_t i = 0; i < FrameProfiler::GetFrameCount(); i++)
+            frames.push_back(FrameProfiler::GetFrame(i));
+        return frames;
+    }
+
+    static std::vector<std::string> CopyThreadNames()
+    {
+        std::vector<std::string> names;
+        for (uint16_t i = 0; i < FrameProfiler::GetThreadCount(); i++)
+            names.push_back(FrameProfiler::GetThreadName(i));
+        return names;
+    }
+
+    void FrameProfiler::Init(uint32_t historySize, uint32_t zonesPerThread)
+    {
+        auto& data = s_FrameProfilerData;
+
+        data.ZonesPerThread = zonesPerThread;
+        data.MainThread = std::this_thread::get_id();
+        data.History.assign(std::max(historySize, 1u), ProfileFrame());
+        data.HistoryHead = 0;
+        data.FrameCount = 0;
+        data.FrameNumber = 0;
+        data.FrameStart = Now();
+
+        data.Enabled.store(true, std::memory_order_relaxed);
+    }
+
+    void FrameProfiler::Shutdown()
+    {
+        auto& data = s_FrameProfilerData;
+
+        data.Enabled.store(false, std::memory_order_relaxed);
+        JobSystem::Wait(data.SpikeExport);
+
+        data.History.clear();
+        data.HistoryHead = 0;
+        data.FrameCount = 0;
+    }
+
+    void FrameProfiler::BeginFrame()
+    {
+        auto& data = s_FrameProfilerData;
+        const uint64_t now = Now();
+
+        if (!IsEnabled() || data.History.empty())
+        {
+            data.FrameStart = now;
+            return;
+        }
+
+        ProfileFrame& frame = data.History[data.HistoryHead];
+        frame.Number = data.FrameNumber++;
+        frame.Start = data.FrameStart;
+        frame.End = now;
+        frame.Zones.clear();
+
+        const uint16_t threadCount = data.ThreadCount.load(std::memory_order_acquire);
+        for (uint16_t i = 0; i < threadCount; i++)
+        {
+            auto& zones = data.Threads[i]->Zones;
+
+            const size_t offset = frame.Zones.size();
+            frame.Zones.resize(offset + zones.size());
+            frame.Zones.resize(offset + zones.pop_n(frame.Zones.data() + offset, frame.Zones.size() - offset));
+        }
+
+        data.HistoryHead = (data.HistoryHead + 1) % data.History.size();
+        data.FrameCount = std::min<uint32_t>(data.FrameCount + 1, data.History.size());
+        data.FrameStart = now;
+
+        // Spikes are exported at most once per history length, so consecutive traces don't overlap.
+        const double frameTime = ToMilliseconds(frame.End - frame.Start);
+        if (data.SpikeThreshold > 0.0f && frameTime > data.SpikeThreshold && frame.Number >= data.NextSpikeFrame &&
+            data.SpikeExport.IsDone())
+        {
+            data.NextSpikeFrame = frame.Number + data.History.size();
+
+            const std::filesystem::path path = data.SpikeDirectory / ("spike_" + std::to_string(frame.Number) + ".json");
+            COFFEE_CORE_WARN("FrameProfiler: Frame {0} took {1:.2f} ms, exporting the last {2} frames to {3}",
+                             frame.Number, frameTime, data.FrameCount, path.string());
+
+            JobSystem::Execute(data.SpikeExport, [frames = CopyHistory(), names = CopyThreadNames(), path]() {
+                WriteChromeTrace(path, frames, names);
+            });
+        }
+    }
+
+    void FrameProfiler::SetEnabled(bool enabled)
+    {
+        s_FrameProfilerData.Enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool FrameProfiler::IsEnabled()
+    {
+        return s_FrameProfilerData.Enabled.load(std::memory_order_relaxed);
+    }
+
+    double FrameProfiler::ToMilliseconds(uint64_t ticks)
+    {
+        return static_cast<double>(ticks) * 1000.0 / SDL_GetPerformanceFrequency();
+    }
+
+    uint32_t FrameProfiler::GetFrameCount()
+    {
+        return s_FrameProfilerData.FrameCount;
+    }
+
+    const ProfileFrame& FrameProfiler::GetFrame(uint32_t index)
+    {
+        auto& data = s_FrameProfilerData;
+        const size_t historySize = data.History.size();
+        return data.History[(data.HistoryHead + historySize - data.FrameCount + index) % historySize];
+    }
+
+    const std::string& FrameProfiler::GetThreadName(uint16_t threadIndex)
+    {
+        return s_FrameProfilerData.Threads[threadIndex]->Name;
+    }
+
+    uint16_t FrameProfiler::GetThreadCount()
+    {
+        return s_FrameProfilerData.ThreadCount.load(std::memory_order_acquire);
+    }
+
+    uint64_t FrameProfiler::GetDroppedZoneCount()
+    {
+        uint64_t dropped = 0;
+        for (uint16_t i = 0; i < GetThreadCount(); i++)
+            dropped += s_FrameProfilerData.Threads[i]->Dropped.load(std::memory_order_relaxed);
+        return dropped;
+    }
+
+    bool FrameProfiler::ExportChromeTrace(const std::filesystem::path& path)
+    {
+        if (!WriteChromeTrace(path, CopyHistory(), CopyThreadNames()))
+            return false;
+
+        COFFEE_CORE_INFO("FrameProfiler: Exported {0} frames to {1}", GetFrameCount(), path.string());
+        return true;
+    }
+
+    void FrameProfiler::SetSpikeThreshold(float milliseconds, const std::filesystem::path& directory)
+    {
+        s_FrameProfilerData.SpikeThreshold = milliseconds;
+        s_FrameProfilerData.SpikeDirectory = directory;
+    }
+
+    float FrameProfiler::GetSpikeThreshold()
+    {
+        return s_FrameProfilerData.SpikeThreshold;
+    }
+
+    void FrameProfiler::PushZone()
+    {
+        ThreadProfile* thread = s_ThreadProfile ? s_ThreadProfile : RegisterThread();
+        if (thread)
+            thread->Depth++;
+    }
+
+    void FrameProfiler::PopZone(const char* name, uint64_t start)
+    {
+        const uint64_t end = Now();
+
+        ThreadProfile* thread = s_ThreadProfile;
+        if (!thread)
+            return;
+
+        thread->Depth--;
+        if (!thread->Zones.push_back({name, start, end, thread->Index, thread->Depth}))
+            thread->Dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+} // namespace Coffee
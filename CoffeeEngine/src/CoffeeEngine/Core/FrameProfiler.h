@@ -0,0 +1,205 @@
+#pragma once
+
+#include <SDL3/SDL_timer.h>
+#include <tracy/Tracy.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Coffee {
+
+    /**
+     * @defgroup core Core
+     * @{
+     */
+
+    /**
+     * @brief A finished zone recorded by the FrameProfiler.
+     */
+    struct ProfileZone
+    {
+        const char* Name; ///< The zone name. Must be a string with static storage (a literal or __FUNCTION__).
+        uint64_t Start; ///< Start time, in performance counter ticks.
+        uint64_t End; ///< End time, in performance counter ticks.
+        uint16_t ThreadIndex; ///< Index of the recording thread, see FrameProfiler::GetThreadName.
+        uint16_t Depth; ///< Nesting depth of the zone in its thread, 0 for top-level zones.
+    };
+
+    /**
+     * @brief The zones recorded during one frame.
+     */
+    struct ProfileFrame
+    {
+        uint64_t Number = 0; ///< Number of the frame since Init.
+        uint64_t Start = 0; ///< Start time, in performance counter ticks.
+        uint64_t End = 0; ///< End time, in performance counter ticks.
+        std::vector<ProfileZone> Zones; ///< The zones that finished during the frame, grouped by thread.
+    };
+
+    /**
+     * @brief Always-on, in-process hierarchical CPU profiler.
+     *
+     * Complements Tracy for builds where no profiler GUI is attached. Every thread records its finished zones
+     * into its own lock-free ring, so a zone costs two performance counter reads and one ring write. BeginFrame
+     * collects the rings of all threads into a history of the last frames, which the MonitorPanel shows as a
+     * flame graph and which can be exported as a Chrome trace (chrome://tracing, Perfetto), either on demand or
+     * automatically when a frame takes longer than the spike threshold.
+     *
+     * ZoneScoped and ZoneScopedN feed both Tracy and the FrameProfiler when this header is included instead of
+     * tracy/Tracy.hpp.
+     */
+    class FrameProfiler
+    {
+      public:
+        /**
+         * @brief Starts recording.
+         * @param historySize The number of frames kept in the history.
+         * @param zonesPerThread The capacity of each thread's ring. Zones recorded while it is full are dropped.
+         */
+        static void Init(uint32_t historySize = 120, uint32_t zonesPerThread = 16 * 1024);
+
+        /**
+         * @brief Stops recording and waits for a pending spike export.
+         */
+        static void Shutdown();
+
+        /**
+         * @brief Ends the current frame: collects the zones recorded by every thread into the history and
+         * exports a trace if the frame was a spike. Called once per frame by the Application.
+         */
+        static void BeginFrame();
+
+        /**
+         * @brief Enables or disables recording. Zones that are open when it changes are still recorded.
+         * @param enabled True to record zones, false otherwise.
+         */
+        static void SetEnabled(bool enabled);
+
+        /**
+         * @brief Checks if zones are being recorded.
+         * @return True if zones are being recorded, false otherwise.
+         */
+        static bool IsEnabled();
+
+        /**
+         * @brief Gets the current time.
+         * @return The current time, in performance counter ticks.
+         */
+        static uint64_t Now() { return SDL_GetPerformanceCounter(); }
+
+        /**
+         * @brief Converts a duration to milliseconds.
+         * @param ticks The duration, in performance counter ticks.
+         * @return The duration, in milliseconds.
+         */
+        static double ToMilliseconds(uint64_t ticks);
+
+        /**
+         * @brief Gets the number of finished frames in the history.
+         * @return The number of frames.
+         */
+        static uint32_t GetFrameCount();
+
+        /**
+         * @brief Gets a frame of the history.
+         * @param index The index of the frame, 0 being the oldest one.
+         * @return The frame.
+         */
+        static const ProfileFrame& GetFrame(uint32_t index);
+
+        /**
+         * @brief Gets the name of a recording thread.
+         * @param threadIndex The ThreadIndex of a zone.
+         * @return The thread name.
+         */
+        static const std::string& GetThreadName(uint16_t threadIndex);
+
+        /**
+         * @brief Gets the number of threads that recorded zones so far.
+         * @return The number of threads.
+         */
+        static uint16_t GetThreadCount();
+
+        /**
+         * @brief Gets the number of zones dropped because a thread's ring was full.
+         * @return The number of dropped zones.
+         */
+        static uint64_t GetDroppedZoneCount();
+
+        /**
+         * @brief Writes the frame history as a Chrome trace JSON file.
+         * @param path The path of the file.
+         * @return True if the file was written, false otherwise.
+         */
+        static bool ExportChromeTrace(const std::filesystem::path& path);
+
+        /**
+         * @brief Exports the frame history automatically when a frame takes longer than a threshold. The trace
+         * is written in the background to spike_<frame>.json in the given directory.
+         * @param milliseconds The threshold, or 0 to disable spike exports.
+         * @param directory The directory the traces are written to.
+         */
+        static void SetSpikeThreshold(float milliseconds, const std::filesystem::path& directory = ".");
+
+        /**
+         * @brief Gets the spike threshold.
+         * @return The threshold in milliseconds, 0 if spike exports are disabled.
+         */
+        static float GetSpikeThreshold();
+
+        /**
+         * @brief Opens a zone on the calling thread. Use ProfileScope instead.
+         */
+        static void PushZone();
+
+        /**
+         * @brief Closes the innermost zone of the calling thread and records it. Use ProfileScope instead.
+         * @param name The zone name.
+         * @param start The time PushZone was called, in performance counter ticks.
+         */
+        static void PopZone(const char* name, uint64_t start);
+    };
+
+    /**
+     * @brief Records a FrameProfiler zone for the lifetime of the object.
+     */
+    class ProfileScope
+    {
+      public:
+        explicit ProfileScope(const char* name) : m_Name(name)
+        {
+            if (FrameProfiler::IsEnabled())
+            {
+                FrameProfiler::PushZone();
+                m_Start = FrameProfiler::Now();
+            }
+        }
+
+        ~ProfileScope()
+        {
+            if (m_Start != 0)
+                FrameProfiler::PopZone(m_Name, m_Start);
+        }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+      private:
+        const char* m_Name;
+        uint64_t m_Start = 0;
+    };
+
+    /** @} */
+} // namespace Coffee
+
+// Feed the FrameProfiler from the existing Tracy zones.
+#undef ZoneScoped
+#undef ZoneScopedN
+#define ZoneScoped                                                                                                     \
+    ZoneNamed(___tracy_scoped_zone, true);                                                                             \
+    ::Coffee::ProfileScope ___coffee_profile_scope(__FUNCTION__)
+#define ZoneScopedN(name)                                                                                              \
+    ZoneNamedN(___tracy_scoped_zone, name, true);                                                                      \
+    ::Coffee::ProfileScope ___coffee_profile_scope(name)
@@ -1,9 +1,6 @@
 #include "CoffeeEngine/Core/Input.h"
+#include "CoffeeEngine/Core/MemoryTracker.h"
 
-#include "CoffeeEngine/Events/ControllerEvent.h"
-#include "CoffeeEngine/Events/Event.h"
-#include "CoffeeEngine/Events/KeyEvent.h"
-#include "CoffeeEngine/Events/MouseEvent.h"
 #include "SDL3/SDL_keyboard.h"
 #include "SDL3/SDL_mouse.h"
 
@@ -15,12 +12,21 @@ namespace Coffee {
     std::vector<Ref<Gamepad>> Input::m_gamepads;
     std::unordered_map<ButtonCode, char> Input::m_buttonStates;
     std::unordered_map<AxisCode, float> Input::m_axisStates;
-    std::vector<InputBinding> Input::m_bindings = std::vector<InputBinding>(static_cast<int>(InputAction::ActionCount));
+    InputProfile Input::m_bindingProfile;
+    InputEventHandlerTable Input::m_eventHandlers;
 
 
     void Input::Init()
     {
+        COFFEE_MEMORY_TAG(MemoryTag::Input);
+
         SDL_InitSubSystem(SDL_INIT_GAMEPAD);
+
+        m_eventHandlers.Bind(EventType::ControllerConnected, &OnAddController);
+        m_eventHandlers.Bind(EventType::ControllerDisconnected, &OnRemoveController);
+        m_eventHandlers.Bind(EventType::ButtonPressed, &OnButtonPressed);
+        m_eventHandlers.Bind(EventType::ButtonReleased, &OnButtonReleased);
+        m_eventHandlers.Bind(EventType::AxisMoved, &OnAxisMoved);
     }
 
 
@@ -64,129 +70,128 @@ namespace Coffee {
         return m_axisStates[axis];
     }
 
-    void Input::OnAddController(const ControllerAddEvent* cEvent)
+    float Input::GetActionValue(InputAction action, ControllerCode controller)
+    {
+        const ActionTable& bindings = controller != 0 ? m_bindingProfile.GetBindings(SDL_GetGamepadGUIDForID(controller))
+                                                      : m_bindingProfile.GetBindings();
+        const CompiledBinding& binding = bindings[static_cast<size_t>(action)];
+
+        if (binding.IsAnalog && binding.Axis != Axis::Invalid)
+        {
+            return GetAxisRaw(binding.Axis);
+        }
+
+        float value = 0.0f;
+        if (IsKeyPressed(binding.KeyPos) || GetButtonRaw(binding.ButtonPos))
+            value += 1.0f;
+        if (IsKeyPressed(binding.KeyNeg) || GetButtonRaw(binding.ButtonNeg))
+            value -= 1.0f;
+
+        return value;
+    }
+
+    InputBinding Input::GetBinding(InputAction action)
     {
-        m_gamepads.emplace_back(new Gamepad(cEvent->Controller));
+        return InputBinding(m_bindingProfile.GetBindings()[static_cast<size_t>(action)]);
     }
 
+    void Input::SetBinding(InputAction action, const InputBinding& binding)
+    {
+        m_bindingProfile.SetBinding(action, binding.Compile());
+    }
+
+    bool Input::LoadBindingProfile(const std::string& name, bool watch)
+    {
+        COFFEE_MEMORY_TAG(MemoryTag::Input);
+
+        const std::filesystem::path path = InputProfile::GetCachedProfilePath(name);
+
+        if (!m_bindingProfile.Load(path))
+            return false;
+
+        if (watch)
+            m_bindingProfile.Watch(path);
+        else
+            m_bindingProfile.StopWatching();
+
+        return true;
+    }
+
+    bool Input::SaveBindingProfile(const std::string& name)
+    {
+        COFFEE_MEMORY_TAG(MemoryTag::Input);
+
+        return m_bindingProfile.Save(InputProfile::GetCachedProfilePath(name));
+    }
 
-    void Input::OnRemoveController(const ControllerRemoveEvent* cEvent)
+    void Input::Update()
+    {
+        COFFEE_MEMORY_TAG(MemoryTag::Input);
+
+        m_bindingProfile.PollChanges();
+    }
+
+    bool Input::OnAddController(const InputEvent& e)
+    {
+        COFFEE_MEMORY_TAG(MemoryTag::Input);
+
+        m_gamepads.emplace_back(new Gamepad(e.ControllerDevice.Controller));
+        return false;
+    }
+
+    bool Input::OnRemoveController(const InputEvent& e)
     {
         // Remove controller by SDL_Gamepad ID
-        auto pred = [&cEvent](const Ref<Gamepad>& gamepad) {
-            return gamepad->getId() == cEvent->Controller;
+        auto pred = [&e](const Ref<Gamepad>& gamepad) {
+            return gamepad->getId() == e.ControllerDevice.Controller;
         };
         erase_if(m_gamepads, pred);
-    }
-    void Input::OnButtonPressed(const ButtonPressEvent& e) {
-        m_buttonStates[e.Button] += 1;
+        return false;
     }
 
-    void Input::OnButtonReleased(const ButtonReleaseEvent& e) {
-        m_buttonStates[e.Button] -= 1;
+    bool Input::OnButtonPressed(const InputEvent& e)
+    {
+        m_buttonStates[e.ControllerButton.Button] += 1;
+        return false;
     }
 
-    void Input::OnAxisMoved(const AxisMoveEvent& e) {
+    bool Input::OnButtonReleased(const InputEvent& e)
+    {
+        m_buttonStates[e.ControllerButton.Button] -= 1;
+        return false;
+    }
 
+    bool Input::OnAxisMoved(const InputEvent& e)
+    {
         constexpr float DEADZONE = 0.15f;
-        float normalizedValue = e.Value / 32767.0f;
+        float normalizedValue = e.ControllerAxis.Value / 32767.0f;
 
         if (std::abs(normalizedValue) < DEADZONE)
         {
             normalizedValue = 0.0f;
         }
-       
-        m_axisStates[e.Axis] = normalizedValue;
-    }
-    void Input::OnKeyPressed(const KeyPressedEvent& kEvent) {
-    }
 
-    void Input::OnKeyReleased(const KeyReleasedEvent& kEvent) {
+        m_axisStates[e.ControllerAxis.Axis] = normalizedValue;
+        return false;
     }
 
-    void Input::OnMouseButtonPressed(const MouseButtonPressedEvent& mEvent) {
-    }
+    void Input::OnEvent(InputEvent& e)
+    {
+        COFFEE_MEMORY_TAG(MemoryTag::Input);
 
-    void Input::OnMouseButtonReleased(const MouseButtonReleasedEvent& mEvent) {
+        m_eventHandlers.Dispatch(e);
     }
 
-    void Input::OnMouseMoved(const MouseMovedEvent& mEvent) {
+    void Input::OnEvent(Event& e)
+    {
+        COFFEE_MEMORY_TAG(MemoryTag::Input);
+
+        InputEvent inputEvent;
+        if (!ToInputEvent(e, inputEvent))
+            return;
+
+        OnEvent(inputEvent);
+        e.Handled = inputEvent.Handled;
     }
 
-    void Input::OnEvent(Event& e)
-	{
-	    if (e.IsInCategory(EventCategoryInput))
-	    {
-            switch (e.GetEventType())
-            {
-            	using enum EventType;
-                case ControllerConnected:
-                {
-                if (const auto* cEvent = static_cast<ControllerAddEvent*>(&e))
-                        OnAddController(cEvent);
-                    break;
-                }
-                case ControllerDisconnected:
-                {
-                    if (const auto* cEvent = static_cast<ControllerRemoveEvent*>(&e))
-                        OnRemoveController(cEvent);
-                    break;
-                }
-                case ButtonPressed:
-                {
-                    if (const auto* bEvent = static_cast<ButtonPressEvent*>(&e))
-                        OnButtonPressed(*bEvent);
-                    break;
-                }
-                case ButtonReleased:
-                {
-                    if (const auto* bEvent = static_cast<ButtonReleaseEvent*>(&e))
-                        OnButtonReleased(*bEvent);
-                    break;
-                }
-                case AxisMoved:
-                {
-                    if (const auto* aEvent = static_cast<AxisMoveEvent*>(&e))
-                        OnAxisMoved(*aEvent);
-                    break;
-                }
-                case KeyPressed:
-                {
-                    if (const auto* kEvent = static_cast<KeyPressedEvent*>(&e))
-                        OnKeyPressed(*kEvent);
-                    break;
-                }
-                case KeyReleased:
-                {
-                    if (const auto* kEvent = static_cast<KeyReleasedEvent*>(&e))
-                        OnKeyReleased(*kEvent);
-                    break;
-                }
-                case MouseButtonPressed:
-                {
-                    if (const auto* mEvent = static_cast<MouseButtonPressedEvent*>(&e))
-                        OnMouseButtonPressed(*mEvent);
-                    break;
-                }
-                case MouseButtonReleased:
-                {
-                    if (const auto* mEvent = static_cast<MouseButtonReleasedEvent*>(&e))
-                        OnMouseButtonReleased(*mEvent);
-                    break;
-                }
-                case MouseMoved:
-                {
-                    if (const auto* mEvent = static_cast<MouseMovedEvent*>(&e))
-                        OnMouseMoved(*mEvent);
-                    break;
-                }
-
-                default:
-                {
-                    break;
-                }
-            }
-	    }
-	}
-
-}
\ No newline at end of file
+}
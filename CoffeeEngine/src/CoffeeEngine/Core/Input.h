@@ -4,10 +4,9 @@
 #include "CoffeeEngine/Core/KeyCodes.h"
 #include "CoffeeEngine/Core/MouseCodes.h"
 #include "CoffeeEngine/Input/Gamepad.h"
-#include "CoffeeEngine/Events/ControllerEvent.h"
-#include "CoffeeEngine/Events/KeyEvent.h"
-#include "CoffeeEngine/Events/MouseEvent.h"
+#include "CoffeeEngine/Events/InputEvent.h"
 #include "CoffeeEngine/Input/InputBinding.h"
+#include "CoffeeEngine/Input/InputProfile.h"
 
 
 #include "CoffeeEngine/Events/Event.h"
@@ -17,41 +16,6 @@
 #include <unordered_map>
 
 namespace Coffee {
-	// TODO Change for better action map layers method?
-	/**
-	 * @brief Current action context. Each key/button can only be in one InputAction per context layer
-	 */
-	enum class InputLayer : int
-	{
-		None = 0,
-		Gameplay = BIT(1),
-		Menu = BIT(2)
-	};
-
-    /**
-     * @brief List of possible actions in ActionMap v0.1
-     */
-    enum class InputAction
-    {
-        // UI
-    	Up,
-    	Down,
-    	Left,
-    	Right,
-        Confirm,
-        Cancel,
-
-        // Gameplay
-    	MoveHorizontal,
-		MoveVertical,
-        Attack,
-        Ability,
-        Pause,
-
-        // Action count for array creation and iteration
-        ActionCount
-    };
-
     /**
      * @defgroup core Core
      * @brief Core components of the CoffeeEngine.
@@ -116,71 +80,107 @@ namespace Coffee {
          */
         static float GetAxisRaw(AxisCode axis);
 
+        /**
+         * @brief Gets the value of an action using the active binding profile.
+         *
+         * @param action The action to query.
+         * @param controller The controller the input comes from. Its device override is used if the profile has one.
+         * @return The action value, between -1 and 1.
+         */
+        static float GetActionValue(InputAction action, ControllerCode controller = 0);
+
+        /**
+         * @brief Gets the binding of an action in the default action table.
+         *
+         * @param action The action to query.
+         * @return An editable copy of the binding.
+         */
+        static InputBinding GetBinding(InputAction action);
+
+        /**
+         * @brief Rebinds an action in the default action table. Takes effect immediately.
+         *
+         * @param action The action to rebind.
+         * @param binding The new binding.
+         */
+        static void SetBinding(InputAction action, const InputBinding& binding);
+
+        /**
+         * @brief Loads a binding profile from the cache directory and makes it the active one.
+         *
+         * @param name The name of the profile.
+         * @param watch Whether to hot reload the profile when the file changes.
+         * @return True if the profile was loaded, false otherwise.
+         */
+        static bool LoadBindingProfile(const std::string& name, bool watch = true);
+
+        /**
+         * @brief Saves the active binding profile to the cache directory.
+         *
+         * @param name The name of the profile.
+         * @return True if the profile was written, false otherwise.
+         */
+        static bool SaveBindingProfile(const std::string& name);
+
+        /**
+         * @brief Gets the active binding profile, e.g. to edit per-device overrides.
+         * @return The active binding profile.
+         */
+        static InputProfile& GetBindingProfile() { return m_bindingProfile; }
+
+        /**
+         * @brief Per-frame housekeeping. Hot reloads the binding profile if it changed on disk.
+         */
+        static void Update();
+
 		static InputLayer CurrentInputContext;
 
+        /**
+         * @brief Updates the input state from an input event.
+         *
+         * @param e The event to process. Dispatched through a per-type handler table.
+         */
+        static void OnEvent(InputEvent& e);
+
+        /**
+         * @brief Updates the input state from a legacy event.
+         *
+         * @param e The event to process. Non-input events are ignored.
+         */
         static void OnEvent(Event& e);
 
 	private:
         /**
 	     * @brief Handles controller connection events
-	     * @param cEvent The event data to process
+	     * @param e The event data to process
 	     */
-        static void OnAddController(const ControllerAddEvent* cEvent);
+        static bool OnAddController(const InputEvent& e);
 	    /**
          * @brief Handles controller disconnection events
-         * @param cEvent The event data to process
+         * @param e The event data to process
          */
-	    static void OnRemoveController(const ControllerRemoveEvent* cEvent);
+	    static bool OnRemoveController(const InputEvent& e);
 	    /**
         * @brief Handles button press events from controllers.
         *
         * @param e The button press event to process.
         */
-        static void OnButtonPressed(const ButtonPressEvent& e);
+        static bool OnButtonPressed(const InputEvent& e);
 	    /**
          * @brief Handles button release events from controllers.
          *
          * @param e The button release event to process.
          */
-        static void OnButtonReleased(const ButtonReleaseEvent& e);
+        static bool OnButtonReleased(const InputEvent& e);
 	    /**
          * @brief Handles axis movement events from controllers.
          *
          * @param e The axis move event to process.
          */
-        static void OnAxisMoved(const AxisMoveEvent& e);
-	    /**
-         * @brief Handles key press events from the keyboard.
-         *
-         * @param event The key pressed event to process.
-         */
-	    static void OnKeyPressed(const KeyPressedEvent& event);
-	    /**
-         * @brief Handles key release events from the keyboard.
-         *
-         * @param event The key released event to process.
-         */
-	    static void OnKeyReleased(const KeyReleasedEvent& event);
-	    /**
-         * @brief Handles mouse button press events.
-         *
-         * @param event The mouse button pressed event to process.
-         */
-	    static void OnMouseButtonPressed(const MouseButtonPressedEvent& event);
-	    /**
-         * @brief Handles mouse button release events.
-         *
-         * @param event The mouse button released event to process.
-         */
-	    static void OnMouseButtonReleased(const MouseButtonReleasedEvent& event);
-	    /**
-         * @brief Handles mouse movement events.
-         *
-         * @param event The mouse moved event to process.
-         */
-	    static void OnMouseMoved(const MouseMovedEvent& event);
+        static bool OnAxisMoved(const InputEvent& e);
 
-        static std::vector<InputBinding> m_bindings;
+        static InputEventHandlerTable m_eventHandlers;
+        static InputProfile m_bindingProfile;
 
 	    static std::vector<Ref<Gamepad>> m_gamepads;
 	    static std::unordered_map<ButtonCode, char> m_buttonStates;
@@ -0,0 +1,346 @@
+#include "CoffeeEngine/Core/JobSystem.h"
+
+#include "CoffeeEngine/Core/FrameProfiler.h"
+#include "CoffeeEngine/Core/Log.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Coffee {
+
+    /**
+     * @brief The copy of a Dispatch function, shared by its batches and recycled once the last one finishes.
+     */
+    struct RangeSlot
+    {
+        JobSystem::RangeFn Func;
+        std::atomic<uint32_t> Remaining = 0;
+    };
+
+    struct Job
+    {
+        JobSystem::JobFn Task;
+        JobCounter* Counter;
+        const JobCounter* Dependency;
+
+        // Batches of a Dispatch call the range function directly, so they don't wrap it in a Task.
+        const JobSystem::RangeFn* Range = nullptr;
+        RangeSlot* Slot = nullptr; ///< The slot Range lives in, or nullptr if the caller keeps it alive.
+        uint32_t Begin = 0;
+        uint32_t End = 0;
+    };
+
+    struct JobQueue
+    {
+        std::mutex Mutex;
+        std::deque<Job> Jobs;
+    };
+
+    struct JobSystemData
+    {
+        /// Queue 0 belongs to the main thread, then one per worker, and the last one is shared by the other threads.
+        std::vector<std::unique_ptr<JobQueue>> Queues;
+        std::vector<std::thread> Workers;
+
+        std::atomic<bool> Running = false;
+        std::atomic<uint32_t> PendingJobs = 0;
+
+        std::mutex SleepMutex;
+        std::condition_variable WakeCondition;
+
+        std::mutex RangeSlotMutex;
+        std::deque<RangeSlot> RangeSlots; ///< A deque so slots don't move when the pool grows.
+        std::vector<RangeSlot*> FreeRangeSlots;
+    };
+
+    static JobSystemData s_JobSystemData;
+    static thread_local uint32_t s_ThreadIndex = JobSystem::InvalidThreadIndex;
+
+    static uint32_t GetQueueIndex()
+    {
+        if (s_ThreadIndex == JobSystem::InvalidThreadIndex)
+            return static_cast<uint32_t>(s_JobSystemData.Queues.size() - 1);
+        return s_ThreadIndex;
+    }
+
+    static void Push(Job job)
+    {
+        JobQueue& queue = *s_JobSystemData.Queues[GetQueueIndex()];
+        std::lock_guard lock(queue.Mutex);
+        queue.Jobs.push_back(std::move(job));
+    }
+
+    static void WakeWorkers(uint32_t jobCount)
+    {
+        // Taking the lock orders the PendingJobs update before a worker re-checks it, so no wake-up is lost.
+        {
+            std::lock_guard lock(s_JobSystemData.SleepMutex);
+        }
+
+        if (jobCount == 1)
+            s_JobSystemData.WakeCondition.notify_one();
+        else
+            s_JobSystemData.WakeCondition.notify_all();
+    }
+
+    static RangeSlot* AcquireRangeSlot(const JobSystem::RangeFn& func, uint32_t batchCount)
+    {
+        RangeSlot* slot;
+        {
+            std::lock_guard lock(s_JobSystemData.RangeSlotMutex);
+            if (s_JobSystemData.FreeRangeSlots.empty())
+            {
+                slot = &s_JobSystemData.RangeSlots.emplace_back();
+            }
+            else
+            {
+                slot = s_JobSystemData.FreeRangeSlots.back();
+                s_JobSystemData.FreeRangeSlots.pop_back();
+            }
+        }
+
+        slot->Func = func;
+        slot->Remaining.store(batchCount, std::memory_order_relaxed);
+        return slot;
+    }
+
+    static void ReleaseRangeSlot(RangeSlot* slot)
+    {
+        if (slot->Remaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+
+        // Last batch: drop the captures now rather than when the slot is reused.
+        slot->Func = nullptr;
+
+        std::lock_guard lock(s_JobSystemData.RangeSlotMutex);
+        s_JobSystemData.FreeRangeSlots.push_back(slot);
+    }
+
+    static bool TryPop(uint32_t queueIndex, bool steal, Job& job)
+    {
+        JobQueue& queue = *s_JobSystemData.Queues[queueIndex];
+        std::lock_guard lock(queue.Mutex);
+
+        if (queue.Jobs.empty())
+            return false;
+
+        // The owner takes the newest job (still hot in cache), thieves take the oldest one.
+        if (steal)
+        {
+            job = std::move(queue.Jobs.front());
+            queue.Jobs.pop_front();
+        }
+        else
+        {
+            job = std::move(queue.Jobs.back());
+            queue.Jobs.pop_back();
+        }
+        return true;
+    }
+
+    bool JobSystem::RunPendingJob()
+    {
+        const uint32_t queueCount = static_cast<uint32_t>(s_JobSystemData.Queues.size());
+        const uint32_t self = GetQueueIndex();
+
+        Job job;
+        bool found = false;
+        for (uint32_t i = 0; !found && i < queueCount; i++)
+        {
+            const uint32_t queueIndex = (self + i) % queueCount;
+            if (!TryPop(queueIndex, i != 0, job))
+                continue;
+
+            found = !job.Dependency || job.Dependency->IsDone();
+            if (!found)
+            {
+                // Not ready yet: put it back where it will be picked last and look for work in the next queue.
+                JobQueue& queue = *s_JobSystemData.Queues[queueIndex];
+                std::lock_guard lock(queue.Mutex);
+                queue.Jobs.push_front(std::move(job));
+            }
+        }
+
+        if (!found)
+            return false;
+
+        if (job.Range)
+        {
+            (*job.Range)(job.Begin, job.End);
+            if (job.Slot)
+                ReleaseRangeSlot(job.Slot);
+        }
+        else
+        {
+            job.Task();
+        }
+
+        s_JobSystemData.PendingJobs.fetch_sub(1, std::memory_order_relaxed);
+        job.Counter->m_Value.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    void JobSystem::WorkerLoop(uint32_t threadIndex)
+    {
+        s_ThreadIndex = threadIndex;
+
+        const std::string threadName = "Job Worker " + std::to_string(threadIndex);
+        tracy::SetThreadName(threadName.c_str());
+
+        while (s_JobSystemData.Running.load(std::memory_order_acquire))
+        {
+            if (RunPendingJob())
+                continue;
+
+            if (s_JobSystemData.PendingJobs.load(std::memory_order_acquire) > 0)
+            {
+                // Jobs exist but are blocked on dependencies or owned by a busy queue; back off briefly.
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock lock(s_JobSystemData.SleepMutex);
+            s_JobSystemData.WakeCondition.wait(lock, [] {
+                return s_JobSystemData.PendingJobs.load(std::memory_order_acquire) > 0 ||
+                       !s_JobSystemData.Running.load(std::memory_order_acquire);
+            });
+        }
+    }
+
+    void JobSystem::Init(uint32_t workerCount)
+    {
+        ZoneScoped;
+
+        s_JobSystemData.Queues.clear();
+        for (uint32_t i = 0; i < workerCount + 2; i++)
+            s_JobSystemData.Queues.push_back(std::make_unique<JobQueue>());
+
+        s_ThreadIndex = 0;
+        s_JobSystemData.Running = true;
+
+        for (uint32_t i = 1; i <= workerCount; i++)
+            s_JobSystemData.Workers.emplace_back(WorkerLoop, i);
+
+        COFFEE_CORE_INFO("JobSystem: Started {0} worker threads", workerCount);
+    }
+
+    void JobSystem::Shutdown()
+    {
+        ZoneScoped;
+
+        if (!s_JobSystemData.Running)
+            return;
+
+        // Drain what is left so no counter is left waiting forever.
+        while (s_JobSystemData.PendingJobs.load(std::memory_order_acquire) > 0)
+        {
+            if (!RunPendingJob())
+                std::this_thread::yield();
+        }
+
+        s_JobSystemData.Running = false;
+        WakeWorkers(static_cast<uint32_t>(s_JobSystemData.Workers.size()));
+
+        for (std::thread& worker : s_JobSystemData.Workers)
+            worker.join();
+
+        s_JobSystemData.Workers.clear();
+        s_JobSystemData.Queues.clear();
+        s_JobSystemData.RangeSlots.clear();
+        s_JobSystemData.FreeRangeSlots.clear();
+    }
+
+    uint32_t JobSystem::GetWorkerCount()
+    {
+        return static_cast<uint32_t>(s_JobSystemData.Workers.size());
+    }
+
+    uint32_t JobSystem::GetThreadIndex()
+    {
+        return s_ThreadIndex;
+    }
+
+    void JobSystem::Execute(JobCounter& counter, JobFn job, const JobCounter* dependency)
+    {
+        if (s_JobSystemData.Workers.empty())
+        {
+            if (dependency)
+                Wait(*dependency);
+            job();
+            return;
+        }
+
+        counter.m_Value.fetch_add(1, std::memory_order_relaxed);
+        s_JobSystemData.PendingJobs.fetch_add(1, std::memory_order_release);
+        Push({std::move(job), &counter, dependency});
+        WakeWorkers(1);
+    }
+
+    void JobSystem::Dispatch(JobCounter& counter, uint32_t count, uint32_t batchSize, const RangeFn& func,
+                             const JobCounter* dependency)
+    {
+        SubmitBatches(counter, count, batchSize, func, dependency, true);
+    }
+
+    void JobSystem::DispatchAndWait(uint32_t count, uint32_t batchSize, const RangeFn& func)
+    {
+        JobCounter counter;
+        SubmitBatches(counter, count, batchSize, func, nullptr, false);
+        Wait(counter);
+    }
+
+    void JobSystem::SubmitBatches(JobCounter& counter, uint32_t count, uint32_t batchSize, const RangeFn& func,
+                                  const JobCounter* dependency, bool copy)
+    {
+        if (count == 0)
+            return;
+
+        if (batchSize == 0)
+            batchSize = 1;
+
+        if (s_JobSystemData.Workers.empty() || count <= batchSize)
+        {
+            if (dependency)
+                Wait(*dependency);
+            func(0, count);
+            return;
+        }
+
+        const uint32_t batchCount = (count + batchSize - 1) / batchSize;
+        RangeSlot* slot = copy ? AcquireRangeSlot(func, batchCount) : nullptr;
+        const RangeFn* range = slot ? &slot->Func : &func;
+
+        counter.m_Value.fetch_add(batchCount, std::memory_order_relaxed);
+        s_JobSystemData.PendingJobs.fetch_add(batchCount, std::memory_order_release);
+
+        {
+            JobQueue& queue = *s_JobSystemData.Queues[GetQueueIndex()];
+            std::lock_guard lock(queue.Mutex);
+
+            for (uint32_t batch = 0; batch < batchCount; batch++)
+            {
+                const uint32_t begin = batch * batchSize;
+                const uint32_t end = std::min(begin + batchSize, count);
+                queue.Jobs.push_back({nullptr, &counter, dependency, range, slot, begin, end});
+            }
+        }
+
+        WakeWorkers(batchCount);
+    }
+
+    void JobSystem::Wait(const JobCounter& counter)
+    {
+        while (!counter.IsDone())
+        {
+            if (!RunPendingJob())
+                std::this_thread::yield();
+        }
+    }
+
+} // namespace Coffee
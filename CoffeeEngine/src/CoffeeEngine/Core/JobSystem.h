@@ -0,0 +1,158 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+namespace Coffee {
+
+    /**
+     * @defgroup core Core
+     * @{
+     */
+
+    /**
+     * @brief Counts the unfinished jobs of a group.
+     *
+     * Every job submitted with a counter increments it and decrements it when it finishes, so a counter
+     * reaching zero means the whole group is done. Counters are also used as job dependencies.
+     */
+    class JobCounter
+    {
+      public:
+        JobCounter() = default;
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        /**
+         * @brief Checks if every job of the group has finished.
+         * @return True if the group is done, false otherwise.
+         */
+        bool IsDone() const { return m_Value.load(std::memory_order_acquire) == 0; }
+
+        /**
+         * @brief Gets the number of unfinished jobs.
+         * @return The number of unfinished jobs.
+         */
+        uint32_t GetValue() const { return m_Value.load(std::memory_order_acquire); }
+
+      private:
+        friend class JobSystem;
+        std::atomic<uint32_t> m_Value{0};
+    };
+
+    /**
+     * @brief Work-stealing job system.
+     *
+     * Each worker thread owns a job queue: it runs its own jobs newest first and, when it runs out, steals the
+     * oldest jobs of the other queues. The thread that called Init (the main thread) owns queue 0 and runs jobs
+     * while it waits on a counter, so it is never idle during a Wait. Other threads (logging, telemetry, audio
+     * callbacks) share one submission queue that the workers steal from. If the system was started without workers
+     * every job runs inline on the calling thread.
+     */
+    class JobSystem
+    {
+      public:
+        using JobFn = std::function<void()>;
+        using RangeFn = std::function<void(uint32_t begin, uint32_t end)>;
+
+        static constexpr uint32_t InvalidThreadIndex = UINT32_MAX; ///< The index of the threads the JobSystem doesn't own.
+
+        /**
+         * @brief Starts the worker threads.
+         * @param workerCount The number of worker threads, not counting the main thread.
+         */
+        static void Init(uint32_t workerCount);
+
+        /**
+         * @brief Waits for the pending jobs and joins the worker threads.
+         */
+        static void Shutdown();
+
+        /**
+         * @brief Gets the number of worker threads, not counting the main thread.
+         * @return The number of worker threads.
+         */
+        static uint32_t GetWorkerCount();
+
+        /**
+         * @brief Gets the index of the calling thread: 0 for the main thread, 1..GetWorkerCount() for the workers
+         * and InvalidThreadIndex for any other thread. Useful to index per-thread scratch data.
+         * @return The index of the calling thread.
+         */
+        static uint32_t GetThreadIndex();
+
+        /**
+         * @brief Submits a job.
+         * @param counter The counter of the group the job belongs to.
+         * @param job The job to run.
+         * @param dependency A counter that must reach zero before the job starts, or nullptr.
+         */
+        static void Execute(JobCounter& counter, JobFn job, const JobCounter* dependency = nullptr);
+
+        /**
+         * @brief Splits a range in batches and submits one job per batch. The function is copied once, into a
+         * pooled slot shared by the batches, so it may be a temporary.
+         * @param counter The counter of the group the jobs belong to.
+         * @param count The number of elements in the range.
+         * @param batchSize The number of elements per job.
+         * @param func The function to run for each batch, with the half-open range [begin, end).
+         * @param dependency A counter that must reach zero before the jobs start, or nullptr.
+         */
+        static void Dispatch(JobCounter& counter, uint32_t count, uint32_t batchSize, const RangeFn& func,
+                             const JobCounter* dependency = nullptr);
+
+        /**
+         * @brief Splits a range in batches, runs them across the job system and waits for them. Unlike Dispatch
+         * the function is not copied, as it outlives the jobs.
+         * @param count The number of elements in the range.
+         * @param batchSize The number of elements per job.
+         * @param func The function to run for each batch, with the half-open range [begin, end).
+         */
+        static void DispatchAndWait(uint32_t count, uint32_t batchSize, const RangeFn& func);
+
+        /**
+         * @brief Blocks until a counter reaches zero, running jobs in the meantime.
+         * @param counter The counter to wait for.
+         */
+        static void Wait(const JobCounter& counter);
+
+        /**
+         * @brief Runs a function for every index in [0, count) across the job system and waits for it.
+         * @tparam F The function type, taking a uint32_t index.
+         * @param count The number of elements.
+         * @param batchSize The number of elements per job.
+         * @param func The function to run for each index.
+         */
+        template<typename F>
+        static void ParallelFor(uint32_t count, uint32_t batchSize, F&& func)
+        {
+            DispatchAndWait(count, batchSize, [&func](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; i++)
+                    func(i);
+            });
+        }
+
+      private:
+        /**
+         * @brief Submits one job per batch of a range, or runs the whole range inline without workers.
+         * @param copy True to copy the function into a pooled slot, false if it outlives the jobs.
+         */
+        static void SubmitBatches(JobCounter& counter, uint32_t count, uint32_t batchSize, const RangeFn& func,
+                                  const JobCounter* dependency, bool copy);
+
+        /**
+         * @brief Runs one job from the calling thread's queue, or stolen from another queue.
+         * @return True if a job was run, false if none was ready.
+         */
+        static bool RunPendingJob();
+
+        /**
+         * @brief The main loop of a worker thread.
+         * @param threadIndex The index of the worker, which is also the index of its queue.
+         */
+        static void WorkerLoop(uint32_t threadIndex);
+    };
+
+    /** @} */
+} // namespace Coffee
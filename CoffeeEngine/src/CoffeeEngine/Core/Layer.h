@@ -45,9 +45,11 @@ public:
 
     /**
      * Called when an event occurs.
+     * @deprecated The LayerStack no longer forwards events, so this is never called. Subscribe to the
+     * Application's EventBus instead, usually from OnAttach.
      * @param event The event that occurred.
      */
-    virtual void OnEvent(Event& event) {}
+    [[deprecated("Subscribe to the Application's EventBus instead")]] virtual void OnEvent(Event& event) {}
 
     /**
      * Gets the name of the layer.
@@ -0,0 +1,67 @@
+#include "CoffeeEngine/Core/LinearArena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace Coffee {
+
+    LinearArena::LinearArena(size_t blockSize) : m_BlockSize(blockSize) {}
+
+    void* LinearArena::Allocate(size_t size, size_t alignment)
+    {
+        while (m_CurrentBlock < m_Blocks.size())
+        {
+            Block& block = m_Blocks[m_CurrentBlock];
+
+            const uintptr_t base = reinterpret_cast<uintptr_t>(block.Data.get());
+            const uintptr_t aligned = (base + m_Offset + alignment - 1) & ~(uintptr_t(alignment) - 1);
+            const size_t offset = aligned - base;
+
+            if (offset + size <= block.Size)
+            {
+                m_Offset = offset + size;
+                return block.Data.get() + offset;
+            }
+
+            m_CurrentBlock++;
+            m_Offset = 0;
+        }
+
+        // Out of blocks: add one big enough for this allocation and its worst-case padding.
+        const size_t blockSize = std::max(m_BlockSize, size + alignment);
+        m_Blocks.push_back({std::make_unique<std::byte[]>(blockSize), blockSize});
+        m_CurrentBlock = m_Blocks.size() - 1;
+        m_Offset = 0;
+
+        return Allocate(size, alignment);
+    }
+
+    void LinearArena::Reset()
+    {
+        m_CurrentBlock = 0;
+        m_Offset = 0;
+    }
+
+    void LinearArena::Rewind(const Marker& marker)
+    {
+        m_CurrentBlock = marker.Block;
+        m_Offset = marker.Offset;
+    }
+
+    size_t LinearArena::GetUsedBytes() const
+    {
+        size_t used = 0;
+        for (size_t i = 0; i < m_CurrentBlock && i < m_Blocks.size(); i++)
+            used += m_Blocks[i].Size;
+        return used + m_Offset;
+    }
+
+    size_t LinearArena::GetCapacity() const
+    {
+        size_t capacity = 0;
+        for (const Block& block : m_Blocks)
+            capacity += block.Size;
+        return capacity;
+    }
+
+} // namespace Coffee
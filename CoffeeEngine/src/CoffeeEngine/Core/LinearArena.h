@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Coffee {
+
+    /**
+     * @defgroup core Core
+     * @{
+     */
+
+    /**
+     * @brief Bump allocator over a list of memory blocks.
+     *
+     * Allocating is a pointer bump, freeing single allocations is not supported: the whole arena is reset at
+     * once, or rewound to a marker. Blocks are kept when the arena is reset, so once it has grown to its working
+     * set it stops touching the heap. Not thread-safe; use one arena per thread.
+     */
+    class LinearArena
+    {
+      public:
+        /**
+         * @brief A position in the arena, used to free everything allocated after it.
+         */
+        struct Marker
+        {
+            size_t Block = 0;
+            size_t Offset = 0;
+        };
+
+        /**
+         * @brief Constructs an empty arena. No memory is allocated until the first allocation.
+         * @param blockSize The size of each block, in bytes. Larger allocations get a block of their own.
+         */
+        explicit LinearArena(size_t blockSize = 64 * 1024);
+
+        LinearArena(const LinearArena&) = delete;
+        LinearArena& operator=(const LinearArena&) = delete;
+
+        /**
+         * @brief Allocates memory from the arena.
+         * @param size The size of the allocation, in bytes.
+         * @param alignment The alignment of the allocation. Must be a power of two.
+         * @return A pointer to the memory, valid until the arena is reset or rewound past it.
+         */
+        void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        /**
+         * @brief Allocates uninitialized memory for an array.
+         * @tparam T The element type.
+         * @param count The number of elements.
+         * @return A pointer to the first element.
+         */
+        template<typename T>
+        T* AllocateArray(size_t count)
+        {
+            return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        /**
+         * @brief Frees every allocation, keeping the blocks for reuse.
+         */
+        void Reset();
+
+        /**
+         * @brief Gets the current position of the arena.
+         * @return A marker that can be passed to Rewind.
+         */
+        Marker GetMarker() const { return {m_CurrentBlock, m_Offset}; }
+
+        /**
+         * @brief Frees every allocation made after a marker.
+         * @param marker A marker returned by GetMarker since the last Reset.
+         */
+        void Rewind(const Marker& marker);
+
+        /**
+         * @brief Gets the number of bytes handed out since the last reset, including alignment padding.
+         * @return The number of used bytes.
+         */
+        size_t GetUsedBytes() const;
+
+        /**
+         * @brief Gets the total size of the blocks owned by the arena.
+         * @return The capacity of the arena, in bytes.
+         */
+        size_t GetCapacity() const;
+
+      private:
+        struct Block
+        {
+            std::unique_ptr<std::byte[]> Data;
+            size_t Size;
+        };
+
+        std::vector<Block> m_Blocks; ///< The memory blocks, in allocation order.
+        size_t m_CurrentBlock = 0; ///< The block being allocated from.
+        size_t m_Offset = 0; ///< The first free byte in the current block.
+        size_t m_BlockSize; ///< The default size of a new block.
+    };
+
+    /** @} */
+} // namespace Coffee
@@ -1,18 +1,115 @@
 #include "CoffeeEngine/Core/Log.h"
 
+#include "CoffeeEngine/Core/DataStructures/LockFreeRingBuffer.h"
+
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
+#include <spdlog/details/os.h>
 #include <spdlog/logger.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
 #include <string>
+#include <thread>
+#include <tracy/Tracy.hpp>
 #include <vector>
 
 namespace Coffee
 {
+    static constexpr size_t LogQueueCapacity = 4096;
+    static constexpr size_t LogBatchSize = 64;
+    static constexpr size_t LogBufferCapacity = 1024;
+    static constexpr size_t LogLineCapacity = 256;
+
     std::shared_ptr<spdlog::logger> Log::s_CoreLogger;
     std::shared_ptr<spdlog::logger> Log::s_ClientLogger;
-    std::vector<std::string> Log::s_LogBuffer;
+    LogBuffer Log::s_LogBuffer(LogBufferCapacity, LogLineCapacity);
+
+    struct LogData
+    {
+        std::unique_ptr<MPMCRingBuffer<Log::LogRecord>> Queue;
+        std::thread Thread;
+        std::atomic<bool> Running = false; ///< Keeps the logging thread alive.
+        std::atomic<bool> Accepting = false; ///< Whether new messages go to the queue, cleared first by Shutdown.
+        std::atomic<uint32_t> Writers = 0; ///< Threads inside Enqueue, Shutdown waits for them before freeing the queue.
+
+        std::atomic<uint64_t> Enqueued = 0;
+        std::atomic<uint64_t> Written = 0;
+        std::atomic<uint64_t> Overruns = 0; ///< Times a thread found the queue full and had to wait.
+    };
+
+    static LogData s_LogData;
+
+    LogBuffer::LogBuffer(size_t capacity, size_t lineCapacity) : m_Entries(capacity)
+    {
+        for (LogEntry& entry : m_Entries)
+            entry.Text.reserve(lineCapacity);
+    }
+
+    void LogBuffer::Push(spdlog::level::level_enum level, std::string_view text)
+    {
+        std::lock_guard lock(m_Mutex);
+
+        size_t index;
+        if (m_Size < m_Entries.size())
+        {
+            index = (m_Start + m_Size) % m_Entries.size();
+            m_Size++;
+        }
+        else
+        {
+            index = m_Start;
+            m_Start = (m_Start + 1) % m_Entries.size();
+        }
+
+        m_Entries[index].Level = level;
+        m_Entries[index].Text.assign(text.data(), text.size());
+    }
+
+    void LogBuffer::Clear()
+    {
+        std::lock_guard lock(m_Mutex);
+        m_Start = 0;
+        m_Size = 0;
+    }
+
+    size_t LogBuffer::Size() const
+    {
+        std::lock_guard lock(m_Mutex);
+        return m_Size;
+    }
+
+    Log::LogRecord& Log::LogRecord::operator=(LogRecord&& other) noexcept
+    {
+        if (this == &other)
+            return *this;
+
+        Reset();
+
+        Logger = other.Logger;
+        Level = other.Level;
+        Time = other.Time;
+        ThreadID = other.ThreadID;
+        Format = other.Format;
+        Formatter = other.Formatter;
+        Relocate = other.Relocate;
+        if (Relocate)
+            Relocate(Storage, other.Storage);
+
+        other.Formatter = nullptr;
+        other.Relocate = nullptr;
+        return *this;
+    }
+
+    void Log::LogRecord::Reset()
+    {
+        if (Relocate)
+            Relocate(nullptr, Storage);
+
+        Formatter = nullptr;
+        Relocate = nullptr;
+    }
 
     void Log::Init()
     {
@@ -28,6 +125,146 @@ namespace Coffee
         s_ClientLogger = spdlog::stdout_color_mt("APP");
         s_ClientLogger->set_level(spdlog::level::trace);
         s_ClientLogger.get()->sinks().push_back(imGuiSink);
+
+        s_LogData.Queue = std::make_unique<MPMCRingBuffer<LogRecord>>(LogQueueCapacity);
+        s_LogData.Running.store(true, std::memory_order_release);
+        s_LogData.Thread = std::thread(&Log::LoggingThread);
+        s_LogData.Accepting.store(true, std::memory_order_release);
+
+#ifdef COFFEE_BINARY_LOG
+        BinaryLog::Init("Coffee.clog");
+#endif
+    }
+
+    void Log::Shutdown()
+    {
+#ifdef COFFEE_BINARY_LOG
+        BinaryLog::Shutdown();
+#endif
+
+        if (!s_LogData.Accepting.exchange(false))
+            return;
+
+        // A thread may have seen Accepting set just before the exchange; let it finish its push.
+        while (s_LogData.Writers.load() > 0)
+            std::this_thread::yield();
+
+        // The logging thread drains the queue before returning.
+        s_LogData.Running.store(false, std::memory_order_release);
+        s_LogData.Thread.join();
+        s_LogData.Queue.reset();
+
+        if (s_LogData.Overruns.load(std::memory_order_relaxed) > 0)
+            COFFEE_CORE_WARN("Log: The queue was full {0} times, consider raising its capacity",
+                             s_LogData.Overruns.load(std::memory_order_relaxed));
+
+        s_CoreLogger->flush();
+        s_ClientLogger->flush();
+    }
+
+    void Log::Flush()
+    {
+        if (!IsAsync())
+            return;
+
+        const uint64_t target = s_LogData.Enqueued.load(std::memory_order_acquire);
+        while (s_LogData.Written.load(std::memory_order_acquire) < target && IsAsync())
+            std::this_thread::yield();
+    }
+
+    bool Log::IsAsync()
+    {
+        return s_LogData.Accepting.load(std::memory_order_acquire);
+    }
+
+    void Log::Enqueue(spdlog::logger& logger, spdlog::level::level_enum level, LogRecord&& record)
+    {
+        record.Logger = &logger;
+        record.Level = level;
+        record.Time = spdlog::log_clock::now();
+        record.ThreadID = spdlog::details::os::thread_id();
+
+        // Sequentially consistent with the exchange in Shutdown: either Shutdown sees this writer or the writer
+        // sees that the queue is closing.
+        s_LogData.Writers.fetch_add(1);
+        if (!s_LogData.Accepting.load())
+        {
+            s_LogData.Writers.fetch_sub(1, std::memory_order_release);
+            WriteRecord(record);
+            return;
+        }
+
+        if (!s_LogData.Queue->push_back(std::move(record)))
+        {
+            // Never drop messages: wait for the logging thread to make room.
+            s_LogData.Overruns.fetch_add(1, std::memory_order_relaxed);
+            while (!s_LogData.Queue->push_back(std::move(record)))
+                std::this_thread::yield();
+        }
+        s_LogData.Enqueued.fetch_add(1, std::memory_order_release);
+        s_LogData.Writers.fetch_sub(1, std::memory_order_release);
+
+        // Make sure critical messages reach the console before a possible crash.
+        if (level >= spdlog::level::critical)
+            Flush();
+    }
+
+    void Log::WriteRecord(LogRecord& record)
+    {
+        spdlog::logger& logger = *record.Logger;
+
+        spdlog::memory_buf_t payload;
+        try
+        {
+            record.Formatter(record.Format, record.Storage, payload);
+        }
+        catch (const std::exception& e)
+        {
+            payload.clear();
+            fmt::format_to(fmt::appender(payload), "Log: Could not format \"{}\": {}", record.Format, e.what());
+        }
+
+        spdlog::details::log_msg msg(logger.name(), record.Level,
+                                     spdlog::string_view_t(payload.data(), payload.size()));
+        msg.time = record.Time;
+        msg.thread_id = record.ThreadID;
+
+        for (auto& sink : logger.sinks())
+        {
+            if (sink->should_log(msg.level))
+                sink->log(msg);
+        }
+
+        if (msg.level >= logger.flush_level())
+            logger.flush();
+    }
+
+    void Log::LoggingThread()
+    {
+        tracy::SetThreadName("Log");
+
+        std::vector<LogRecord> batch(LogBatchSize);
+        while (true)
+        {
+            // Read the flag before draining, so the messages queued before Shutdown are always written.
+            const bool running = s_LogData.Running.load(std::memory_order_acquire);
+
+            const size_t count = s_LogData.Queue->pop_n(batch.data(), batch.size());
+            for (size_t i = 0; i < count; i++)
+            {
+                WriteRecord(batch[i]);
+                batch[i].Reset();
+            }
+            s_LogData.Written.fetch_add(count, std::memory_order_release);
+
+            if (count > 0)
+                continue;
+
+            if (!running)
+                break;
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
     }
 
 } // namespace Coffee
@@ -3,9 +3,15 @@
 #include <memory>
 #include <spdlog/logger.h>
 #include <spdlog/sinks/base_sink.h>
+#include <cstddef>
 #include <mutex>
-#include <vector>
+#include <new>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace Coffee
 {
@@ -15,17 +21,94 @@ namespace Coffee
      * @{
      */
 
+    /**
+     * @brief A line of the editor log.
+     */
+    struct LogEntry
+    {
+        spdlog::level::level_enum Level = spdlog::level::info;
+        std::string Text;
+    };
+
+    /**
+     * @brief Fixed-capacity ring of the last log lines, shown by the editor.
+     *
+     * Every slot keeps its string, reserved up front, so once the ring is full adding a line overwrites the
+     * oldest one in O(1) and usually without allocating. Thread-safe: lines are added by the logging thread
+     * and read by the editor.
+     */
+    class LogBuffer
+    {
+      public:
+        /**
+         * @brief Constructs the ring.
+         * @param capacity The number of lines kept.
+         * @param lineCapacity The number of characters reserved for every line.
+         */
+        LogBuffer(size_t capacity, size_t lineCapacity);
+
+        /**
+         * @brief Adds a line, overwriting the oldest one if the ring is full.
+         * @param level The level of the message.
+         * @param text The formatted line.
+         */
+        void Push(spdlog::level::level_enum level, std::string_view text);
+
+        /**
+         * @brief Removes every line.
+         */
+        void Clear();
+
+        /**
+         * @brief Gets the number of lines.
+         * @return The number of lines.
+         */
+        size_t Size() const;
+
+        /**
+         * @brief Calls a function for every line, oldest first. The ring is locked during the calls.
+         * @param func The function, taking a const LogEntry&.
+         */
+        template<typename F>
+        void ForEach(F&& func) const
+        {
+            std::lock_guard lock(m_Mutex);
+            for (size_t i = 0; i < m_Size; i++)
+                func(m_Entries[(m_Start + i) % m_Entries.size()]);
+        }
+
+      private:
+        mutable std::mutex m_Mutex;
+        std::vector<LogEntry> m_Entries;
+        size_t m_Start = 0; ///< The oldest line.
+        size_t m_Size = 0;
+    };
+
     /**
      * @brief The Log class is responsible for initializing and providing access to the core and client loggers.
+     *
+     * Messages are written by a background thread. The log macros only copy their arguments into a record of a
+     * lock-free queue; formatting and writing to the sinks (console, editor) happen on the logging thread. Before
+     * Init and after Shutdown messages are written synchronously.
      */
     class Log
     {
       public:
         /**
-         * @brief Initializes the logging system.
+         * @brief Initializes the logging system and starts the logging thread.
          */
         static void Init();
 
+        /**
+         * @brief Writes the pending messages and stops the logging thread.
+         */
+        static void Shutdown();
+
+        /**
+         * @brief Blocks until every message queued before the call has been written.
+         */
+        static void Flush();
+
         /**
          * @brief Gets the core logger.
          * @return A shared pointer to the core logger.
@@ -38,13 +121,134 @@ namespace Coffee
          */
         inline static std::shared_ptr<spdlog::logger>& GetClientLogger() { return s_ClientLogger; }
 
-        static const std::vector<std::string>& GetLogBuffer() { return s_LogBuffer; }
-        static void ClearLogBuffer() { s_LogBuffer.clear(); }
+        static const LogBuffer& GetLogBuffer() { return s_LogBuffer; }
+        static void ClearLogBuffer() { s_LogBuffer.Clear(); }
+
+        /**
+         * @brief Queues a message. Used by the log macros.
+         * @param logger The logger the message is written to.
+         * @param level The level of the message.
+         * @param format The format string.
+         * @param args The format arguments. Numbers, enums, pointers and strings are copied, strings included, so they
+         * may not outlive the call; any other argument makes the message be formatted on the calling thread.
+         */
+        template<typename... Args>
+        static void Write(spdlog::logger& logger, spdlog::level::level_enum level,
+                          spdlog::format_string_t<Args...> format, Args&&... args)
+        {
+            if (!logger.should_log(level))
+                return;
+
+            if (!IsAsync())
+            {
+                logger.log(level, format, std::forward<Args>(args)...);
+                return;
+            }
+
+            using Stored = std::tuple<StoredArg<Args>...>;
+
+            LogRecord record;
+            if constexpr (sizeof(Stored) <= LogRecord::StorageSize && alignof(Stored) <= alignof(std::max_align_t) &&
+                          (IsDeferrable<Args> && ...) && (std::is_constructible_v<StoredArg<Args>, Args&&> && ...))
+            {
+                const fmt::string_view view = format;
+                new (record.Storage) Stored(std::forward<Args>(args)...);
+                record.Format = std::string_view(view.data(), view.size());
+                record.Formatter = &FormatStored<StoredArg<Args>...>;
+                record.Relocate = &RelocateStored<Stored>;
+            }
+            else
+            {
+                // The arguments don't fit in a record or may point into the caller's data: format them now and
+                // queue the text.
+                new (record.Storage) std::tuple<std::string>(fmt::format(format, std::forward<Args>(args)...));
+                record.Format = "{}";
+                record.Formatter = &FormatStored<std::string>;
+                record.Relocate = &RelocateStored<std::tuple<std::string>>;
+            }
+
+            Enqueue(logger, level, std::move(record));
+        }
+
+        /**
+         * @brief Queues a message that is not a format string. Used by the log macros.
+         */
+        template<typename T>
+        static void Write(spdlog::logger& logger, spdlog::level::level_enum level, const T& message)
+        {
+            Write(logger, level, "{}", message);
+        }
 
       private:
+        friend struct LogData;
+
+        /**
+         * @brief A queued message: its format string and a copy of its arguments.
+         */
+        struct LogRecord
+        {
+            static constexpr size_t StorageSize = 192;
+
+            using FormatFn = void (*)(std::string_view format, const void* args, spdlog::memory_buf_t& out);
+            using RelocateFn = void (*)(void* destination, void* source); ///< Moves the arguments, or only destroys them if destination is null.
+
+            LogRecord() = default;
+            LogRecord(LogRecord&& other) noexcept { *this = std::move(other); }
+            LogRecord& operator=(LogRecord&& other) noexcept;
+            ~LogRecord() { Reset(); }
+
+            void Reset();
+
+            spdlog::logger* Logger = nullptr;
+            spdlog::level::level_enum Level = spdlog::level::off;
+            spdlog::log_clock::time_point Time;
+            size_t ThreadID = 0;
+            std::string_view Format; ///< The format string of the call site, a literal.
+            FormatFn Formatter = nullptr;
+            RelocateFn Relocate = nullptr;
+            alignas(std::max_align_t) std::byte Storage[StorageSize];
+        };
+
+        // Only the arguments that hold their value are formatted later. Views such as fmt::join, spans or user types
+        // that point into the caller's data may be gone by the time the logging thread gets to them.
+        template<typename T>
+        static constexpr bool IsDeferrable =
+            std::is_arithmetic_v<std::decay_t<T>> || std::is_enum_v<std::decay_t<T>> || std::is_pointer_v<std::decay_t<T>> ||
+            std::is_convertible_v<const std::decay_t<T>&, std::string_view>;
+
+        // Strings are copied, the caller's buffer may be gone by the time the message is formatted.
+        template<typename T>
+        using StoredArg = std::conditional_t<std::is_convertible_v<const std::decay_t<T>&, std::string_view>,
+                                             std::string, std::decay_t<T>>;
+
+        template<typename... Stored>
+        static void FormatStored(std::string_view format, const void* args, spdlog::memory_buf_t& out)
+        {
+            std::apply(
+                [&](const auto&... unpacked) {
+                    fmt::vformat_to(fmt::appender(out), fmt::string_view(format.data(), format.size()),
+                                    fmt::make_format_args(unpacked...));
+                },
+                *static_cast<const std::tuple<Stored...>*>(args));
+        }
+
+        template<typename Tuple>
+        static void RelocateStored(void* destination, void* source)
+        {
+            Tuple& tuple = *static_cast<Tuple*>(source);
+            if (destination)
+                new (destination) Tuple(std::move(tuple));
+            tuple.~Tuple();
+        }
+
+        static bool IsAsync();
+        static void Enqueue(spdlog::logger& logger, spdlog::level::level_enum level, LogRecord&& record);
+        static void WriteRecord(LogRecord& record);
+        static void LoggingThread();
+
         static std::shared_ptr<spdlog::logger> s_CoreLogger; ///< The core logger.
         static std::shared_ptr<spdlog::logger> s_ClientLogger; ///< The client logger.
-        static std::vector<std::string> s_LogBuffer; ///< The log buffer.
+        static LogBuffer s_LogBuffer; ///< The last lines, for the editor.
 
         template <typename Mutex>
         class LogSink : public spdlog::sinks::base_sink<Mutex>
@@ -52,14 +256,9 @@ namespace Coffee
         protected:
             void sink_it_(const spdlog::details::log_msg& msg) override
             {
-                if(s_LogBuffer.size() > 1024)
-                {
-                    s_LogBuffer.erase(s_LogBuffer.begin());
-                }
-
                 spdlog::memory_buf_t formatted;
                 this->formatter_->format(msg, formatted);
-                s_LogBuffer.push_back(fmt::to_string(formatted));
+                s_LogBuffer.Push(msg.level, std::string_view(formatted.data(), formatted.size()));
             }
 
             void flush_() override {}
@@ -68,16 +267,24 @@ namespace Coffee
     /** @} */
 } // namespace Coffee
 
+#ifdef COFFEE_BINARY_LOG
+    #include "CoffeeEngine/Core/BinaryLog.h"
+    // The lambda gives every call site its own BinaryLog::Write instantiation, and so its own format ID.
+    #define COFFEE_LOG_WRITE(logger, level, ...) ::Coffee::BinaryLog::Write([] {}, *logger, level, __VA_ARGS__)
+#else
+    #define COFFEE_LOG_WRITE(logger, level, ...) ::Coffee::Log::Write(*logger, level, __VA_ARGS__)
+#endif
+
 // Core log macros
-#define COFFEE_CORE_TRACE(...)    ::Coffee::Log::GetCoreLogger()->trace(__VA_ARGS__)
-#define COFFEE_CORE_INFO(...)     ::Coffee::Log::GetCoreLogger()->info(__VA_ARGS__)
-#define COFFEE_CORE_WARN(...)     ::Coffee::Log::GetCoreLogger()->warn(__VA_ARGS__)
-#define COFFEE_CORE_ERROR(...)    ::Coffee::Log::GetCoreLogger()->error(__VA_ARGS__)
-#define COFFEE_CORE_CRITICAL(...) ::Coffee::Log::GetCoreLogger()->critical(__VA_ARGS__)
+#define COFFEE_CORE_TRACE(...)    COFFEE_LOG_WRITE(::Coffee::Log::GetCoreLogger(), spdlog::level::trace, __VA_ARGS__)
+#define COFFEE_CORE_INFO(...)     COFFEE_LOG_WRITE(::Coffee::Log::GetCoreLogger(), spdlog::level::info, __VA_ARGS__)
+#define COFFEE_CORE_WARN(...)     COFFEE_LOG_WRITE(::Coffee::Log::GetCoreLogger(), spdlog::level::warn, __VA_ARGS__)
+#define COFFEE_CORE_ERROR(...)    COFFEE_LOG_WRITE(::Coffee::Log::GetCoreLogger(), spdlog::level::err, __VA_ARGS__)
+#define COFFEE_CORE_CRITICAL(...) COFFEE_LOG_WRITE(::Coffee::Log::GetCoreLogger(), spdlog::level::critical, __VA_ARGS__)
 
 // Client log macros
-#define COFFEE_TRACE(...)         ::Coffee::Log::GetClientLogger()->trace(__VA_ARGS__)
-#define COFFEE_INFO(...)          ::Coffee::Log::GetClientLogger()->info(__VA_ARGS__)
-#define COFFEE_WARN(...)          ::Coffee::Log::GetClientLogger()->warn(__VA_ARGS__)
-#define COFFEE_ERROR(...)         ::Coffee::Log::GetClientLogger()->error(__VA_ARGS__)
-#define COFFEE_CRITICAL(...)      ::Coffee::Log::GetClientLogger()->critical(__VA_ARGS__)
\ No newline at end of file
+#define COFFEE_TRACE(...)         COFFEE_LOG_WRITE(::Coffee::Log::GetClientLogger(), spdlog::level::trace, __VA_ARGS__)
+#define COFFEE_INFO(...)          COFFEE_LOG_WRITE(::Coffee::Log::GetClientLogger(), spdlog::level::info, __VA_ARGS__)
+#define COFFEE_WARN(...)          COFFEE_LOG_WRITE(::Coffee::Log::GetClientLogger(), spdlog::level::warn, __VA_ARGS__)
+#define COFFEE_ERROR(...)         COFFEE_LOG_WRITE(::Coffee::Log::GetClientLogger(), spdlog::level::err, __VA_ARGS__)
+#define COFFEE_CRITICAL(...)      COFFEE_LOG_WRITE(::Coffee::Log::GetClientLogger(), spdlog::level::critical, __VA_ARGS__)
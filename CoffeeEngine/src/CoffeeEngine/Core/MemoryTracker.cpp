@@ -0,0 +1,233 @@
+#include "CoffeeEngine/Core/MemoryTracker.h"
+
+#include <tracy/Tracy.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace Coffee {
+
+    namespace
+    {
+        constexpr size_t TagCount = static_cast<size_t>(MemoryTag::Count);
+
+        // Tracy identifies memory pools and plots by the address of their name, so these are the only copies.
+        constexpr const char* TagNames[TagCount] = {
+            "Untagged", "Renderer", "Resources", "Scene", "Scripting", "Audio", "Input",
+        };
+        constexpr const char* GPUPlotNames[TagCount] = {
+            "GPU Untagged", "GPU Renderer", "GPU Resources", "GPU Scene", "GPU Scripting", "GPU Audio", "GPU Input",
+        };
+        constexpr const char* ExternalPlotNames[TagCount] = {
+            "External Untagged", "External Renderer", "External Resources", "External Scene",
+            "External Scripting", "External Audio", "External Input",
+        };
+
+        // One cache line per tag, so threads allocating under different tags don't contend.
+        struct alignas(64) TagCounters
+        {
+            std::atomic<int64_t> LiveBytes{0};
+            std::atomic<int64_t> PeakBytes{0};
+            std::atomic<uint64_t> Allocations{0};
+            std::atomic<uint64_t> AllocatedBytes{0};
+            std::atomic<int64_t> GPUBytes{0};
+            std::atomic<int64_t> PeakGPUBytes{0};
+            std::atomic<int64_t> ExternalBytes{0};
+        };
+
+        void UpdatePeak(std::atomic<int64_t>& peak, int64_t value)
+        {
+            int64_t current = peak.load(std::memory_order_relaxed);
+            while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            {
+            }
+        }
+    } // namespace
+
+    // Constant-initialized, so operator new can use it before any constructor runs.
+    struct MemoryTrackerData
+    {
+        TagCounters Tags[TagCount];
+    };
+
+    static MemoryTrackerData s_Data;
+    static thread_local MemoryTag t_CurrentTag = MemoryTag::Untagged;
+
+    MemoryTag MemoryTracker::GetCurrentTag()
+    {
+        return t_CurrentTag;
+    }
+
+    MemoryTag MemoryTracker::SetCurrentTag(MemoryTag tag)
+    {
+        MemoryTag previous = t_CurrentTag;
+        t_CurrentTag = tag;
+        return previous;
+    }
+
+    void MemoryTracker::OnAllocate(MemoryTag tag, void* ptr, size_t size)
+    {
+        TagCounters& counters = s_Data.Tags[static_cast<size_t>(tag)];
+
+        const int64_t live = counters.LiveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+        UpdatePeak(counters.PeakBytes, live + counters.ExternalBytes.load(std::memory_order_relaxed));
+        counters.Allocations.fetch_add(1, std::memory_order_relaxed);
+        counters.AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+#ifdef COFFEE_MEMORY_TRACKING_TRACY
+        TracySecureAllocN(ptr, size, TagNames[static_cast<size_t>(tag)]);
+#endif
+    }
+
+    void MemoryTracker::OnFree(MemoryTag tag, void* ptr, size_t size)
+    {
+#ifdef COFFEE_MEMORY_TRACKING_TRACY
+        TracySecureFreeN(ptr, TagNames[static_cast<size_t>(tag)]);
+#endif
+
+        s_Data.Tags[static_cast<size_t>(tag)].LiveBytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    void MemoryTracker::OnGPUAllocate(MemoryTag tag, uint64_t size)
+    {
+        TagCounters& counters = s_Data.Tags[static_cast<size_t>(tag)];
+        UpdatePeak(counters.PeakGPUBytes, counters.GPUBytes.fetch_add(size, std::memory_order_relaxed) + size);
+    }
+
+    void MemoryTracker::OnGPUFree(MemoryTag tag, uint64_t size)
+    {
+        s_Data.Tags[static_cast<size_t>(tag)].GPUBytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    void MemoryTracker::SetExternalBytes(MemoryTag tag, uint64_t liveBytes)
+    {
+        TagCounters& counters = s_Data.Tags[static_cast<size_t>(tag)];
+        counters.ExternalBytes.store(liveBytes, std::memory_order_relaxed);
+        UpdatePeak(counters.PeakBytes, counters.LiveBytes.load(std::memory_order_relaxed) + liveBytes);
+    }
+
+    MemoryTagStats MemoryTracker::GetStats(MemoryTag tag)
+    {
+        const TagCounters& counters = s_Data.Tags[static_cast<size_t>(tag)];
+
+        MemoryTagStats stats;
+        stats.LiveBytes = counters.LiveBytes.load(std::memory_order_relaxed) +
+                          counters.ExternalBytes.load(std::memory_order_relaxed);
+        stats.PeakBytes = counters.PeakBytes.load(std::memory_order_relaxed);
+        stats.Allocations = counters.Allocations.load(std::memory_order_relaxed);
+        stats.AllocatedBytes = counters.AllocatedBytes.load(std::memory_order_relaxed);
+        stats.GPUBytes = counters.GPUBytes.load(std::memory_order_relaxed);
+        stats.PeakGPUBytes = counters.PeakGPUBytes.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    const char* MemoryTracker::GetTagName(MemoryTag tag)
+    {
+        return tag < MemoryTag::Count ? TagNames[static_cast<size_t>(tag)] : "Unknown";
+    }
+
+    bool MemoryTracker::IsAllocatorTracked()
+    {
+#ifdef COFFEE_MEMORY_TRACKING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void MemoryTracker::EndFrame()
+    {
+        for (size_t i = 0; i < TagCount; i++)
+        {
+            TracyPlot(GPUPlotNames[i], s_Data.Tags[i].GPUBytes.load(std::memory_order_relaxed));
+            TracyPlot(ExternalPlotNames[i], s_Data.Tags[i].ExternalBytes.load(std::memory_order_relaxed));
+        }
+    }
+
+} // namespace Coffee
+
+#ifdef COFFEE_MEMORY_TRACKING
+
+namespace {
+
+    /**
+     * Stored right before every block handed out by operator new.
+     */
+    struct AllocationHeader
+    {
+        uint64_t Size; ///< The requested size.
+        uint32_t Offset; ///< Distance from the start of the malloc block to the user pointer.
+        Coffee::MemoryTag Tag; ///< The tag the block is charged to.
+    };
+
+    constexpr size_t MallocAlignment = alignof(std::max_align_t);
+    constexpr size_t HeaderSize = 16;
+    static_assert(sizeof(AllocationHeader) <= HeaderSize && HeaderSize % MallocAlignment == 0);
+
+    void* Allocate(size_t size, size_t alignment)
+    {
+        alignment = alignment > MallocAlignment ? alignment : MallocAlignment;
+
+        // malloc already returns MallocAlignment-aligned blocks, only larger alignments need padding.
+        char* block = static_cast<char*>(std::malloc(size + HeaderSize + alignment - MallocAlignment));
+        if (!block)
+            return nullptr;
+
+        const uintptr_t address = reinterpret_cast<uintptr_t>(block) + HeaderSize;
+        char* ptr = reinterpret_cast<char*>((address + alignment - 1) & ~(uintptr_t)(alignment - 1));
+
+        AllocationHeader* header = reinterpret_cast<AllocationHeader*>(ptr) - 1;
+        header->Size = size;
+        header->Offset = static_cast<uint32_t>(ptr - block);
+        header->Tag = Coffee::MemoryTracker::GetCurrentTag();
+
+        Coffee::MemoryTracker::OnAllocate(header->Tag, ptr, size);
+        return ptr;
+    }
+
+    void* AllocateOrThrow(size_t size, size_t alignment)
+    {
+        void* ptr = Allocate(size, alignment);
+        if (!ptr)
+            throw std::bad_alloc();
+        return ptr;
+    }
+
+    void Free(void* ptr)
+    {
+        if (!ptr)
+            return;
+
+        const AllocationHeader* header = static_cast<const AllocationHeader*>(ptr) - 1;
+        Coffee::MemoryTracker::OnFree(header->Tag, ptr, header->Size);
+        std::free(static_cast<char*>(ptr) - header->Offset);
+    }
+
+} // namespace
+
+// Every replaceable form is defined, so none of them falls back to a library version with a different layout.
+
+void* operator new(std::size_t size) { return AllocateOrThrow(size, MallocAlignment); }
+void* operator new[](std::size_t size) { return AllocateOrThrow(size, MallocAlignment); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return AllocateOrThrow(size, static_cast<size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return AllocateOrThrow(size, static_cast<size_t>(alignment)); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size, MallocAlignment); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size, MallocAlignment); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return Allocate(size, static_cast<size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return Allocate(size, static_cast<size_t>(alignment)); }
+
+void operator delete(void* ptr) noexcept { Free(ptr); }
+void operator delete[](void* ptr) noexcept { Free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { Free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { Free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { Free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { Free(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { Free(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { Free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { Free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { Free(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { Free(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { Free(ptr); }
+
+#endif
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Coffee {
+
+    /**
+     * @defgroup core Core
+     * @{
+     */
+
+    /**
+     * @brief The subsystem an allocation is charged to.
+     */
+    enum class MemoryTag : uint8_t
+    {
+        Untagged = 0, ///< Allocations made outside of any tagged scope.
+        Renderer, ///< Render queues, framebuffers and other renderer state.
+        Resources, ///< Textures, meshes, models and materials, on the CPU and on the GPU.
+        Scene, ///< The EnTT registry, components and the scene tree.
+        Scripting, ///< The Lua state and the C++ side of script callbacks.
+        Audio, ///< The audio engine, including the memory Wwise allocates on its own.
+        Input, ///< Controllers, bindings and input events.
+        Count
+    };
+
+    /**
+     * @brief The counters of a MemoryTag.
+     */
+    struct MemoryTagStats
+    {
+        int64_t LiveBytes = 0; ///< CPU memory currently allocated.
+        int64_t PeakBytes = 0; ///< Highest value LiveBytes reached.
+        uint64_t Allocations = 0; ///< Number of allocations since start-up, for allocation rates.
+        uint64_t AllocatedBytes = 0; ///< Bytes allocated since start-up, for allocation rates.
+        int64_t GPUBytes = 0; ///< Estimated GPU memory of the textures and buffers created under the tag.
+        int64_t PeakGPUBytes = 0; ///< Highest value GPUBytes reached.
+    };
+
+    /**
+     * @brief Charges memory to the subsystem that allocated it.
+     *
+     * Every thread has a current tag, set with COFFEE_MEMORY_TAG at the entry points of a subsystem. When the engine
+     * is built with COFFEE_MEMORY_TRACKING the global operator new and delete are replaced: each allocation gets a
+     * small header recording its size and the tag that was current, so it is charged back to the same tag when it
+     * is freed, wherever that happens. The option is off by default and needs a static CRT on Windows. With
+     * TRACY_ON_DEMAND, allocations are also reported to Tracy as one named memory pool per tag.
+     *
+     * Memory that doesn't go through operator new is reported by its owner: Lua through its allocator function,
+     * Wwise through its memory manager statistics and GPU objects through a GPUMemory member.
+     *
+     * Counters are updated with relaxed atomics, so the stats of a tag are a consistent snapshot only once the
+     * threads allocating under it are idle. That's enough to see which subsystem grows.
+     */
+    class MemoryTracker
+    {
+      public:
+        /**
+         * @brief Gets the tag new allocations of the calling thread are charged to.
+         * @return The current tag.
+         */
+        static MemoryTag GetCurrentTag();
+
+        /**
+         * @brief Sets the tag new allocations of the calling thread are charged to.
+         * @param tag The new tag.
+         * @return The previous tag, to restore it afterwards.
+         */
+        static MemoryTag SetCurrentTag(MemoryTag tag);
+
+        /**
+         * @brief Records an allocation.
+         * @param tag The tag to charge.
+         * @param ptr The allocated memory, reported to Tracy.
+         * @param size The size of the allocation in bytes.
+         */
+        static void OnAllocate(MemoryTag tag, void* ptr, size_t size);
+
+        /**
+         * @brief Records a deallocation.
+         * @param tag The tag the memory was charged to.
+         * @param ptr The freed memory, reported to Tracy.
+         * @param size The size of the allocation in bytes.
+         */
+        static void OnFree(MemoryTag tag, void* ptr, size_t size);
+
+        /**
+         * @brief Records GPU memory, see GPUMemory.
+         * @param tag The tag to charge.
+         * @param size The estimated size in bytes.
+         */
+        static void OnGPUAllocate(MemoryTag tag, uint64_t size);
+
+        /**
+         * @brief Releases GPU memory recorded with OnGPUAllocate.
+         * @param tag The tag the memory was charged to.
+         * @param size The estimated size in bytes.
+         */
+        static void OnGPUFree(MemoryTag tag, uint64_t size);
+
+        /**
+         * @brief Sets the memory a third-party allocator holds for a tag, on top of what is tracked.
+         * @param tag The tag to charge.
+         * @param liveBytes The bytes currently in use by the allocator.
+         */
+        static void SetExternalBytes(MemoryTag tag, uint64_t liveBytes);
+
+        /**
+         * @brief Gets the counters of a tag.
+         * @param tag The tag.
+         * @return The counters, including the external bytes in LiveBytes.
+         */
+        static MemoryTagStats GetStats(MemoryTag tag);
+
+        /**
+         * @brief Gets the display name of a tag.
+         * @param tag The tag.
+         * @return The name, a string literal.
+         */
+        static const char* GetTagName(MemoryTag tag);
+
+        /**
+         * @brief Tells whether operator new is tracked in this build (COFFEE_MEMORY_TRACKING).
+         * @return True if allocations made with new are charged to tags.
+         */
+        static bool IsAllocatorTracked();
+
+        /**
+         * @brief Plots the GPU and external memory of every tag in Tracy. Called once per frame by the Application.
+         */
+        static void EndFrame();
+    };
+
+    /**
+     * @brief Sets the current MemoryTag of the thread until the end of the scope.
+     */
+    class MemoryTagScope
+    {
+      public:
+        explicit MemoryTagScope(MemoryTag tag) : m_Previous(MemoryTracker::SetCurrentTag(tag)) {}
+        ~MemoryTagScope() { MemoryTracker::SetCurrentTag(m_Previous); }
+
+        MemoryTagScope(const MemoryTagScope&) = delete;
+        MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+      private:
+        MemoryTag m_Previous;
+    };
+
+    /**
+     * @brief The estimated GPU memory of an object, charged to the tag that was current when it was set.
+     *
+     * Textures and buffers keep one as a member and set it when they create their storage. The memory is released
+     * when the member is reset or destroyed. Copies don't own the memory of the original.
+     */
+    class GPUMemory
+    {
+      public:
+        GPUMemory() = default;
+        GPUMemory(const GPUMemory&) {}
+        GPUMemory& operator=(const GPUMemory&) { return *this; }
+        ~GPUMemory() { Reset(); }
+
+        /**
+         * @brief Replaces the recorded size.
+         * @param size The estimated size in bytes.
+         */
+        void Set(uint64_t size)
+        {
+            Reset();
+            m_Tag = MemoryTracker::GetCurrentTag();
+            m_Size = size;
+            MemoryTracker::OnGPUAllocate(m_Tag, m_Size);
+        }
+
+        /**
+         * @brief Releases the recorded size.
+         */
+        void Reset()
+        {
+            if (m_Size > 0)
+                MemoryTracker::OnGPUFree(m_Tag, m_Size);
+            m_Size = 0;
+        }
+
+      private:
+        MemoryTag m_Tag = MemoryTag::Untagged;
+        uint64_t m_Size = 0;
+    };
+
+    /** @} */
+} // namespace Coffee
+
+#define COFFEE_MEMORY_TAG_CONCAT_IMPL(a, b) a##b
+#define COFFEE_MEMORY_TAG_CONCAT(a, b) COFFEE_MEMORY_TAG_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Charges the allocations of the calling thread to a tag until the end of the scope, e.g.
+ * COFFEE_MEMORY_TAG(MemoryTag::Scene). Scopes nest: the innermost one wins.
+ */
+#define COFFEE_MEMORY_TAG(tag) ::Coffee::MemoryTagScope COFFEE_MEMORY_TAG_CONCAT(coffeeMemoryTag, __LINE__)(tag)
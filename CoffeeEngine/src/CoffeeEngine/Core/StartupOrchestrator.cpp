@@ -0,0 +1,167 @@
+#include "CoffeeEngine/Core/StartupOrchestrator.h"
+
+#include "CoffeeEngine/Core/Assert.h"
+#include "CoffeeEngine/Core/FrameProfiler.h"
+#include "CoffeeEngine/Core/Log.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace Coffee {
+
+    static double MillisecondsSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void StartupOrchestrator::AddStage(const std::string& name, StartupThread thread,
+                                       const std::vector<std::string>& dependencies, StageFn func)
+    {
+        auto stage = std::make_unique<Stage>();
+        stage->Thread = thread;
+        stage->Func = std::move(func);
+
+        for (const std::string& dependency : dependencies)
+        {
+            auto it = std::find_if(m_Timings.begin(), m_Timings.end(),
+                                   [&](const StageTiming& timing) { return timing.Name == dependency; });
+            COFFEE_CORE_ASSERT(it != m_Timings.end(), "StartupOrchestrator::AddStage: Unknown dependency!");
+            if (it != m_Timings.end())
+                stage->Dependencies.push_back(it - m_Timings.begin());
+        }
+
+        m_Stages.push_back(std::move(stage));
+        m_Timings.push_back({name});
+    }
+
+    bool StartupOrchestrator::IsReady(const Stage& stage) const
+    {
+        for (size_t dependency : stage.Dependencies)
+        {
+            const Stage& other = *m_Stages[dependency];
+            if (!other.Finished && !(other.Started && other.Counter.IsDone()))
+                return false;
+        }
+        return true;
+    }
+
+    void StartupOrchestrator::RunStage(size_t index)
+    {
+        ZoneScoped;
+        ZoneName(m_Timings[index].Name.c_str(), m_Timings[index].Name.size());
+
+        StageTiming& timing = m_Timings[index];
+        timing.ThreadIndex = JobSystem::GetThreadIndex();
+        timing.StartMs = MillisecondsSince(m_RunStart);
+
+        m_Stages[index]->Func();
+
+        timing.DurationMs = MillisecondsSince(m_RunStart) - timing.StartMs;
+    }
+
+    void StartupOrchestrator::Run()
+    {
+        ZoneScoped;
+
+        m_RunStart = std::chrono::steady_clock::now();
+
+        size_t remaining = m_Stages.size();
+        while (remaining > 0)
+        {
+            bool progressed = false;
+
+            // Submit every stage that can run on any thread first, so they overlap with the main thread's stages.
+            for (size_t i = 0; i < m_Stages.size(); i++)
+            {
+                Stage& stage = *m_Stages[i];
+
+                // Jobs only touch their own timing, the main thread marks them finished.
+                if (stage.Started && !stage.Finished && stage.Counter.IsDone())
+                {
+                    stage.Finished = true;
+                    remaining--;
+                    progressed = true;
+                }
+
+                if (stage.Thread == StartupThread::Any && !stage.Started && IsReady(stage))
+                {
+                    stage.Started = true;
+                    progressed = true;
+                    JobSystem::Execute(stage.Counter, [this, i]() { RunStage(i); });
+                }
+            }
+
+            // Then run one main thread stage, and look again for what it unblocked.
+            for (size_t i = 0; i < m_Stages.size(); i++)
+            {
+                Stage& stage = *m_Stages[i];
+                if (stage.Thread == StartupThread::Main && !stage.Started && IsReady(stage))
+                {
+                    stage.Started = true;
+                    RunStage(i);
+                    stage.Finished = true;
+                    remaining--;
+                    progressed = true;
+                    break;
+                }
+            }
+
+            if (progressed)
+                continue;
+
+            // Nothing can start until a running stage finishes: wait for the one blocking the next stage, running
+            // jobs in the meantime.
+            const Stage* blocking = nullptr;
+            for (const auto& stage : m_Stages)
+            {
+                if (stage->Started)
+                    continue;
+
+                for (size_t dependency : stage->Dependencies)
+                {
+                    if (m_Stages[dependency]->Started && !m_Stages[dependency]->Finished)
+                    {
+                        blocking = m_Stages[dependency].get();
+                        break;
+                    }
+                }
+                break;
+            }
+
+            if (!blocking)
+            {
+                auto running = std::find_if(m_Stages.begin(), m_Stages.end(),
+                                            [](const auto& stage) { return stage->Started && !stage->Finished; });
+                COFFEE_CORE_ASSERT(running != m_Stages.end(), "StartupOrchestrator::Run: No stage can run!");
+                if (running == m_Stages.end())
+                    break;
+                blocking = running->get();
+            }
+
+            JobSystem::Wait(blocking->Counter);
+        }
+
+        m_TotalMs = MillisecondsSince(m_RunStart);
+
+        LogReport();
+    }
+
+    void StartupOrchestrator::LogReport() const
+    {
+        double serialMs = 0.0;
+        for (const StageTiming& timing : m_Timings)
+            serialMs += timing.DurationMs;
+
+        COFFEE_CORE_INFO("Startup took {0:.1f} ms ({1:.1f} ms of work in {2} stages)", m_TotalMs, serialMs,
+                         m_Timings.size());
+
+        for (const StageTiming& timing : m_Timings)
+        {
+            const std::string thread =
+                timing.ThreadIndex == 0 ? std::string("main") : "worker " + std::to_string(timing.ThreadIndex);
+            COFFEE_CORE_INFO("  {0:<24} {1:>9.1f} ms  (at {2:>7.1f} ms on {3})", timing.Name, timing.DurationMs,
+                             timing.StartMs, thread);
+        }
+    }
+
+} // namespace Coffee
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "CoffeeEngine/Core/JobSystem.h"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Coffee {
+
+    /**
+     * @defgroup core Core
+     * @{
+     */
+
+    /**
+     * @brief Where a startup stage is allowed to run.
+     */
+    enum class StartupThread
+    {
+        Main, ///< The main thread, for work tied to the window or the graphics context.
+        Any ///< Any thread of the job system, for CPU work such as decoding assets or starting middleware.
+    };
+
+    /**
+     * @brief Runs the initialization stages of the engine as a dependency graph.
+     *
+     * Every stage names the stages it depends on. Stages that may run on any thread are submitted to the job system
+     * as soon as their dependencies are done, while the main thread runs its own stages in the order they become
+     * ready, so independent work (e.g. starting Wwise and decoding textures while the window and the GL context are
+     * created) overlaps. When the job system has no workers everything runs on the main thread, in a valid order.
+     *
+     * Run logs how long every stage took, which thread ran it and when it started, so regressions in start-up time
+     * can be traced to a stage.
+     */
+    class StartupOrchestrator
+    {
+      public:
+        using StageFn = std::function<void()>;
+
+        /**
+         * @brief The timing of a stage, relative to the start of Run.
+         */
+        struct StageTiming
+        {
+            std::string Name; ///< The name of the stage.
+            uint32_t ThreadIndex = 0; ///< The job system thread that ran it, 0 for the main thread.
+            double StartMs = 0.0; ///< When it started.
+            double DurationMs = 0.0; ///< How long it took.
+        };
+
+        /**
+         * @brief Adds a stage.
+         * @param name The name of the stage, used by dependencies and in the report.
+         * @param thread Where the stage may run.
+         * @param dependencies The names of the stages that must finish before this one starts. They must be added
+         * before it.
+         * @param func The work of the stage.
+         */
+        void AddStage(const std::string& name, StartupThread thread, const std::vector<std::string>& dependencies,
+                      StageFn func);
+
+        /**
+         * @brief Runs every stage and waits for all of them, then logs the timings.
+         */
+        void Run();
+
+        /**
+         * @brief Gets the timings of the last run, in the order the stages were added.
+         * @return The timings.
+         */
+        const std::vector<StageTiming>& GetTimings() const { return m_Timings; }
+
+        /**
+         * @brief Gets the wall-clock duration of the last run.
+         * @return The duration in milliseconds.
+         */
+        double GetTotalMs() const { return m_TotalMs; }
+
+      private:
+        struct Stage
+        {
+            StartupThread Thread;
+            std::vector<size_t> Dependencies;
+            StageFn Func;
+            JobCounter Counter; ///< Non-zero while the stage runs on the job system.
+            bool Started = false;
+            bool Finished = false;
+        };
+
+        bool IsReady(const Stage& stage) const;
+        void RunStage(size_t index);
+        void LogReport() const;
+
+        std::vector<std::unique_ptr<Stage>> m_Stages; ///< Pointers, so the counters don't move while jobs run.
+        std::vector<StageTiming> m_Timings;
+        std::chrono::steady_clock::time_point m_RunStart;
+        double m_TotalMs = 0.0;
+    };
+
+    /** @} */
+} // namespace Coffee
@@ -51,4 +51,16 @@ namespace Coffee
     {
         return instance->GetProcessMemoryUsageImpl();
     }
+
+    ProcessStats SystemInfo::GetProcessStats()
+    {
+        ProcessStats stats;
+        instance->GetProcessStatsImpl(stats);
+        return stats;
+    }
+
+    void SystemInfo::GetThreadCPUTimes(std::vector<ThreadCPUTime>& threads)
+    {
+        instance->GetThreadCPUTimesImpl(threads);
+    }
 }
\ No newline at end of file
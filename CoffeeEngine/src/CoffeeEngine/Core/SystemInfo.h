@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
+#include <vector>
 
 namespace Coffee {
     /**
@@ -8,6 +10,30 @@ namespace Coffee {
      * @brief The SystemInfo class provides information about the Operating System.
      * @{
      */
+
+    /**
+     * @brief Counters of the whole process. All of them grow monotonically except ResidentBytes.
+     */
+    struct ProcessStats
+    {
+        uint64_t ResidentBytes = 0; ///< Physical memory currently used by the process (RSS / working set).
+        uint64_t PageFaults = 0; ///< Page faults served without I/O.
+        uint64_t MajorPageFaults = 0; ///< Page faults that had to read from disk.
+        uint64_t ContextSwitches = 0; ///< Times a thread gave up the CPU, e.g. to wait for a lock or I/O.
+        uint64_t InvoluntaryContextSwitches = 0; ///< Times the scheduler took the CPU away from a thread.
+        double CPUTime = 0.0; ///< User and kernel CPU time of all threads, in seconds.
+    };
+
+    /**
+     * @brief The CPU time a thread of the process has used.
+     */
+    struct ThreadCPUTime
+    {
+        uint64_t ThreadID = 0; ///< The OS thread ID.
+        std::string Name; ///< The OS thread name, as set by tracy::SetThreadName.
+        double CPUTime = 0.0; ///< User and kernel CPU time, in seconds.
+    };
+
     class SystemInfo
     {
     public:
@@ -37,6 +63,19 @@ namespace Coffee {
          */
         virtual uint64_t GetProcessMemoryUsageImpl() const = 0;
 
+        /**
+         * @brief Gets the counters of the process.
+         * @param stats Filled with the counters. The ones the platform doesn't provide stay 0.
+         * @return True if the counters could be read.
+         */
+        virtual bool GetProcessStatsImpl(ProcessStats& stats) const = 0;
+
+        /**
+         * @brief Gets the CPU time of every thread of the process.
+         * @param threads Filled with one entry per live thread. Cleared first.
+         */
+        virtual void GetThreadCPUTimesImpl(std::vector<ThreadCPUTime>& threads) const = 0;
+
         // Static methods to delegate to the instance
         static uint32_t GetLogicalProcessorCount(); ///< Gets the number of logical processors.
         static uint32_t GetPhysicalProcessorCount(); ///< Gets the number of physical processors.
@@ -44,6 +83,8 @@ namespace Coffee {
         static uint64_t GetAvailableMemory(); ///< Gets the available memory in the system.
         static uint64_t GetUsedMemory(); ///< Gets the used memory in the system.
         static uint64_t GetProcessMemoryUsage(); ///< Gets the memory used by the process.
+        static ProcessStats GetProcessStats(); ///< Gets the counters of the process.
+        static void GetThreadCPUTimes(std::vector<ThreadCPUTime>& threads); ///< Gets the CPU time of every thread.
 
     private:
         static SystemInfo* instance; ///< The instance of the SystemInfo class.
@@ -0,0 +1,275 @@
+#include "CoffeeEngine/Core/TelemetrySampler.h"
+
+#include "CoffeeEngine/Core/Log.h"
+#include "CoffeeEngine/Core/SystemInfo.h"
+
+#include <tracy/Tracy.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+namespace Coffee {
+
+    TelemetryWindow TelemetrySeries::GetWindow(size_t window) const
+    {
+        TelemetryWindow result;
+        window = std::min(window, m_Count);
+        if (window == 0)
+            return result;
+
+        result.Min = result.Max = (*this)[m_Count - window];
+        double sum = 0.0;
+        for (size_t i = m_Count - window; i < m_Count; i++)
+        {
+            const float value = (*this)[i];
+            result.Min = std::min(result.Min, value);
+            result.Max = std::max(result.Max, value);
+            sum += value;
+        }
+        result.Avg = static_cast<float>(sum / window);
+        return result;
+    }
+
+    struct TelemetrySamplerData
+    {
+        std::thread Thread;
+        std::mutex WakeMutex;
+        std::condition_variable Wake;
+        bool Running = false; ///< Guarded by WakeMutex.
+
+        double Interval = 0.1;
+        size_t HistorySize = 3000;
+
+        std::mutex HistoryMutex;
+        std::vector<TelemetrySeries> Series; ///< Guarded by HistoryMutex.
+        TelemetrySeries Time{"Time", "s", 1}; ///< When every sample was taken. Guarded by HistoryMutex.
+
+        // Written by the main thread every frame, drained by every sample.
+        std::atomic<uint64_t> FrameCount{0};
+        std::atomic<uint64_t> FrameTimeSum{0}; ///< In microseconds.
+        std::atomic<uint64_t> FrameTimeMax{0}; ///< In microseconds.
+
+        // Only touched by the sampler thread.
+        struct ThreadState
+        {
+            uint64_t ThreadID;
+            double LastCPUTime;
+            size_t Series; ///< Index of the thread's series.
+            bool Seen; ///< Whether the thread was alive in the current sample.
+        };
+        std::vector<ThreadState> Threads;
+        std::vector<ThreadCPUTime> ThreadTimes;
+        ProcessStats LastProcess;
+        std::chrono::steady_clock::time_point Start;
+        std::chrono::steady_clock::time_point LastSample;
+    };
+
+    static TelemetrySamplerData s_Data;
+
+    static void Sample()
+    {
+        ZoneScoped;
+
+        const auto now = std::chrono::steady_clock::now();
+        const double elapsed = std::max(std::chrono::duration<double>(now - s_Data.LastSample).count(), 1e-6);
+        s_Data.LastSample = now;
+
+        const uint64_t frames = s_Data.FrameCount.exchange(0, std::memory_order_relaxed);
+        const uint64_t frameTimeSum = s_Data.FrameTimeSum.exchange(0, std::memory_order_relaxed);
+        const uint64_t frameTimeMax = s_Data.FrameTimeMax.exchange(0, std::memory_order_relaxed);
+
+        // Read the OS counters before taking the lock, they are the slow part.
+        const ProcessStats process = SystemInfo::GetProcessStats();
+        SystemInfo::GetThreadCPUTimes(s_Data.ThreadTimes);
+
+        const ProcessStats& last = s_Data.LastProcess;
+        const auto rate = [elapsed](uint64_t current, uint64_t previous) {
+            return static_cast<float>((current - std::min(current, previous)) / elapsed);
+        };
+
+        std::lock_guard<std::mutex> lock(s_Data.HistoryMutex);
+        std::vector<TelemetrySeries>& series = s_Data.Series;
+
+        const auto push = [&series](TelemetryChannel channel, float value) {
+            series[static_cast<size_t>(channel)].Push(value);
+        };
+        push(TelemetryChannel::FrameTime, frames > 0 ? frameTimeSum / 1000.0f / frames : 0.0f);
+        push(TelemetryChannel::FrameTimeMax, frameTimeMax / 1000.0f);
+        push(TelemetryChannel::FPS, static_cast<float>(frames / elapsed));
+        push(TelemetryChannel::ResidentMemory, process.ResidentBytes / (1024.0f * 1024.0f));
+        push(TelemetryChannel::PageFaults, rate(process.PageFaults, last.PageFaults));
+        push(TelemetryChannel::MajorPageFaults, rate(process.MajorPageFaults, last.MajorPageFaults));
+        push(TelemetryChannel::ContextSwitches, rate(process.ContextSwitches, last.ContextSwitches));
+        push(TelemetryChannel::InvoluntaryContextSwitches,
+             rate(process.InvoluntaryContextSwitches, last.InvoluntaryContextSwitches));
+        push(TelemetryChannel::ProcessCPU, static_cast<float>((process.CPUTime - last.CPUTime) / elapsed * 100.0));
+
+        for (TelemetrySamplerData::ThreadState& state : s_Data.Threads)
+            state.Seen = false;
+
+        for (const ThreadCPUTime& thread : s_Data.ThreadTimes)
+        {
+            auto it = std::find_if(s_Data.Threads.begin(), s_Data.Threads.end(),
+                                   [&](const auto& state) { return state.ThreadID == thread.ThreadID; });
+
+            if (it == s_Data.Threads.end())
+            {
+                // Thread names don't have to be unique, CSV columns do.
+                std::string name = "CPU " + thread.Name;
+                if (std::any_of(series.begin(), series.end(), [&](const auto& s) { return s.GetName() == name; }))
+                    name += " (" + std::to_string(thread.ThreadID) + ")";
+
+                // Pad the new series so every series has the same number of samples.
+                TelemetrySeries& threadSeries = series.emplace_back(std::move(name), "%", s_Data.HistorySize);
+                for (size_t i = 0; i < s_Data.Time.GetSize(); i++)
+                    threadSeries.Push(0.0f);
+
+                s_Data.Threads.push_back({thread.ThreadID, thread.CPUTime, series.size() - 1, true});
+                threadSeries.Push(0.0f);
+                continue;
+            }
+
+            it->Seen = true;
+            series[it->Series].Push(static_cast<float>((thread.CPUTime - it->LastCPUTime) / elapsed * 100.0));
+            it->LastCPUTime = thread.CPUTime;
+        }
+
+        for (const TelemetrySamplerData::ThreadState& state : s_Data.Threads)
+        {
+            if (!state.Seen)
+                series[state.Series].Push(0.0f);
+        }
+
+        s_Data.Time.Push(static_cast<float>(std::chrono::duration<double>(now - s_Data.Start).count()));
+        s_Data.LastProcess = process;
+    }
+
+    void TelemetrySampler::Init(double interval, size_t historySize)
+    {
+        ZoneScoped;
+
+        s_Data.Interval = interval;
+        s_Data.HistorySize = historySize;
+
+        {
+            std::lock_guard<std::mutex> lock(s_Data.HistoryMutex);
+            s_Data.Series.clear();
+            s_Data.Series.reserve(static_cast<size_t>(TelemetryChannel::Count) + 32);
+            s_Data.Series.emplace_back("Frame Time", "ms", historySize);
+            s_Data.Series.emplace_back("Frame Time Max", "ms", historySize);
+            s_Data.Series.emplace_back("FPS", "", historySize);
+            s_Data.Series.emplace_back("Resident Memory", "MB", historySize);
+            s_Data.Series.emplace_back("Page Faults", "/s", historySize);
+            s_Data.Series.emplace_back("Major Page Faults", "/s", historySize);
+            s_Data.Series.emplace_back("Context Switches", "/s", historySize);
+            s_Data.Series.emplace_back("Involuntary Context Switches", "/s", historySize);
+            s_Data.Series.emplace_back("Process CPU", "%", historySize);
+            s_Data.Time = TelemetrySeries("Time", "s", historySize);
+            s_Data.Threads.clear();
+        }
+
+        s_Data.Start = s_Data.LastSample = std::chrono::steady_clock::now();
+        s_Data.LastProcess = SystemInfo::GetProcessStats();
+        s_Data.Running = true;
+
+        s_Data.Thread = std::thread([]() {
+            tracy::SetThreadName("Telemetry");
+
+            const auto interval = std::chrono::duration<double>(s_Data.Interval);
+            auto next = std::chrono::steady_clock::now();
+
+            std::unique_lock<std::mutex> lock(s_Data.WakeMutex);
+            while (s_Data.Running)
+            {
+                // Wait for absolute deadlines, so the time spent sampling doesn't make the interval drift.
+                next += std::chrono::duration_cast<std::chrono::steady_clock::duration>(interval);
+                if (s_Data.Wake.wait_until(lock, next, []() { return !s_Data.Running; }))
+                    break;
+
+                lock.unlock();
+                Sample();
+                lock.lock();
+            }
+        });
+    }
+
+    void TelemetrySampler::Shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(s_Data.WakeMutex);
+            s_Data.Running = false;
+        }
+        s_Data.Wake.notify_one();
+
+        if (s_Data.Thread.joinable())
+            s_Data.Thread.join();
+    }
+
+    void TelemetrySampler::RecordFrame(double frameTime)
+    {
+        const uint64_t microseconds = static_cast<uint64_t>(frameTime * 1e6);
+
+        s_Data.FrameCount.fetch_add(1, std::memory_order_relaxed);
+        s_Data.FrameTimeSum.fetch_add(microseconds, std::memory_order_relaxed);
+
+        // Only the main thread writes it, the sampler only swaps it with 0.
+        uint64_t max = s_Data.FrameTimeMax.load(std::memory_order_relaxed);
+        while (microseconds > max &&
+               !s_Data.FrameTimeMax.compare_exchange_weak(max, microseconds, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    double TelemetrySampler::GetInterval()
+    {
+        return s_Data.Interval;
+    }
+
+    void TelemetrySampler::ReadHistory(const std::function<void(const std::vector<TelemetrySeries>& series)>& reader)
+    {
+        std::lock_guard<std::mutex> lock(s_Data.HistoryMutex);
+        reader(s_Data.Series);
+    }
+
+    bool TelemetrySampler::ExportCSV(const std::filesystem::path& path)
+    {
+        ZoneScoped;
+
+        std::ofstream file(path);
+        if (!file)
+        {
+            COFFEE_CORE_ERROR("TelemetrySampler::ExportCSV: Could not open {0}", path.string());
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(s_Data.HistoryMutex);
+
+        file << "Time (s)";
+        for (const TelemetrySeries& series : s_Data.Series)
+        {
+            std::string name = series.GetName();
+            std::replace(name.begin(), name.end(), ',', ' ');
+            file << ',' << name;
+            if (!series.GetUnit().empty())
+                file << " (" << series.GetUnit() << ')';
+        }
+        file << '\n';
+
+        for (size_t i = 0; i < s_Data.Time.GetSize(); i++)
+        {
+            file << s_Data.Time[i];
+            for (const TelemetrySeries& series : s_Data.Series)
+                file << ',' << series[i];
+            file << '\n';
+        }
+
+        COFFEE_CORE_INFO("Exported {0} telemetry samples to {1}", s_Data.Time.GetSize(), path.string());
+        return true;
+    }
+
+} // namespace Coffee
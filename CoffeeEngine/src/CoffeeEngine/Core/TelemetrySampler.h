@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Coffee {
+
+    /**
+     * @defgroup core Core
+     * @{
+     */
+
+    /**
+     * @brief Minimum, average and maximum of the last samples of a TelemetrySeries.
+     */
+    struct TelemetryWindow
+    {
+        float Min = 0.0f;
+        float Avg = 0.0f;
+        float Max = 0.0f;
+    };
+
+    /**
+     * @brief A fixed-size history of one sampled value. Once full, every sample replaces the oldest one.
+     */
+    class TelemetrySeries
+    {
+      public:
+        TelemetrySeries(std::string name, std::string unit, size_t capacity)
+            : m_Name(std::move(name)), m_Unit(std::move(unit)), m_Values(capacity, 0.0f)
+        {
+        }
+
+        /**
+         * @brief Appends a sample, dropping the oldest one if the history is full.
+         * @param value The sample.
+         */
+        void Push(float value)
+        {
+            m_Values[m_Head] = value;
+            m_Head = (m_Head + 1) % m_Values.size();
+            if (m_Count < m_Values.size())
+                m_Count++;
+        }
+
+        /**
+         * @brief Gets a sample.
+         * @param index The index of the sample, 0 being the oldest one.
+         * @return The sample.
+         */
+        float operator[](size_t index) const
+        {
+            return m_Values[(m_Head + m_Values.size() - m_Count + index) % m_Values.size()];
+        }
+
+        /**
+         * @brief Gets the statistics of the newest samples.
+         * @param window The number of samples to include, clamped to the size of the history.
+         * @return The statistics, all 0 when the history is empty.
+         */
+        TelemetryWindow GetWindow(size_t window) const;
+
+        const std::string& GetName() const { return m_Name; }
+        const std::string& GetUnit() const { return m_Unit; }
+        size_t GetSize() const { return m_Count; }
+        float GetLast() const { return m_Count > 0 ? (*this)[m_Count - 1] : 0.0f; }
+
+      private:
+        std::string m_Name;
+        std::string m_Unit;
+        std::vector<float> m_Values;
+        size_t m_Head = 0; ///< Where the next sample goes.
+        size_t m_Count = 0;
+    };
+
+    /**
+     * @brief The series every TelemetrySampler records, in this order. The CPU usage of every thread follows them.
+     */
+    enum class TelemetryChannel
+    {
+        FrameTime, ///< Average frame time over the interval, in ms.
+        FrameTimeMax, ///< Longest frame of the interval, in ms.
+        FPS, ///< Frames per second over the interval.
+        ResidentMemory, ///< Physical memory of the process, in MB.
+        PageFaults, ///< Page faults per second.
+        MajorPageFaults, ///< Page faults that hit the disk, per second.
+        ContextSwitches, ///< Voluntary context switches per second, a sign of lock contention and I/O waits.
+        InvoluntaryContextSwitches, ///< Preemptions per second, a sign of oversubscribed cores.
+        ProcessCPU, ///< CPU usage of the whole process, in % of one core.
+        Count
+    };
+
+    /**
+     * @brief Records process telemetry on a background thread.
+     *
+     * Every interval the sampler thread reads the process counters (SystemInfo::GetProcessStats), the CPU time of
+     * every thread (SystemInfo::GetThreadCPUTimes) and the frames recorded by the main thread since the previous
+     * sample, and appends one value to every series. Counters are turned into rates per second and CPU times into
+     * a percentage of one core, so a thread using a whole core reads 100 %.
+     *
+     * The history of every series has a fixed size, the MonitorPanel plots it and the whole history can be
+     * exported as CSV, one row per sample, for regression dashboards.
+     */
+    class TelemetrySampler
+    {
+      public:
+        /**
+         * @brief Starts the sampler thread.
+         * @param interval The time between samples, in seconds.
+         * @param historySize The number of samples kept per series.
+         */
+        static void Init(double interval = 0.1, size_t historySize = 3000);
+
+        /**
+         * @brief Stops the sampler thread. The history is kept, so it can still be exported.
+         */
+        static void Shutdown();
+
+        /**
+         * @brief Records the duration of a frame. Called once per frame by the Application.
+         * @param frameTime The frame time in seconds.
+         */
+        static void RecordFrame(double frameTime);
+
+        /**
+         * @brief Gets the time between samples.
+         * @return The interval in seconds.
+         */
+        static double GetInterval();
+
+        /**
+         * @brief Gives read access to the history while the sampler is blocked from changing it.
+         *
+         * The series start with the TelemetryChannel values, then one "CPU <thread name>" series per thread seen so
+         * far. All of them have the same number of samples.
+         *
+         * @param reader Called with the series. Keep it short, the sampler waits for it.
+         */
+        static void ReadHistory(const std::function<void(const std::vector<TelemetrySeries>& series)>& reader);
+
+        /**
+         * @brief Writes the history as CSV: a time column in seconds since Init, then one column per series.
+         * @param path The file to write.
+         * @return True if the file was written.
+         */
+        static bool ExportCSV(const std::filesystem::path& path);
+    };
+
+    /** @} */
+} // namespace Coffee
@@ -1,32 +1,9 @@
 #include "Timer.h"
 #include "CoffeeEngine/Core/Assert.h"
 #include "CoffeeEngine/Core/Log.h"
-#include "SDL3/SDL_timer.h"
 
 namespace Coffee
 {
-    SDL_TimerCallback timerCallback = [](void* param, uint32_t interval, uint32_t elapsed) -> uint32_t
-    {
-        Timer* timer = static_cast<Timer*>(param);
-
-        if(timer->GetCallback())
-        {
-            timer->GetCallback()();
-        }
-
-        if(timer->isOneShot())
-        {
-            timer->Stop();
-            return 0;
-        }
-
-        if(timer->isAutoStart())
-        {
-            timer->Start(timer->getWaitTime());
-        }
-        return 0;
-    };
-
     Timer::Timer(double waitTime, bool autoStart, bool oneShot, TimerCallback callback)
             : m_WaitTime(waitTime), m_AutoStart(autoStart), m_OneShot(oneShot), m_Callback(callback)
     {
@@ -35,40 +12,47 @@ namespace Coffee
         if(m_AutoStart) Start(m_WaitTime);
     }
 
+    Timer::~Timer()
+    {
+        TimerWheel::Cancel(m_TimerID);
+    }
+
     void Timer::Start(double waitTime)
     {
         m_WaitTime = waitTime;
+        m_Paused = false;
 
-        m_Stopwatch.Reset();
-        m_Stopwatch.Start();
+        // Restarting a running timer replaces it.
+        TimerWheel::Cancel(m_TimerID);
 
-        m_TimerID = SDL_AddTimer(static_cast<Uint32>(m_WaitTime * 1000), timerCallback, this);
-        if(m_TimerID == 0)
+        // The callback is looked up when the timer fires, so SetCallback also affects a running timer.
+        m_TimerID = TimerWheel::Schedule(m_WaitTime, [this]()
         {
-            COFFEE_ERROR("Timer could not be created: {0}", SDL_GetError());
-        }
+            if(m_Callback)
+            {
+                m_Callback();
+            }
+        }, m_OneShot ? 0.0 : m_WaitTime);
     }
 
     void Timer::Stop()
     {
-        m_Stopwatch.Stop();
-
-        if(SDL_RemoveTimer(m_TimerID) == false)
-        {
-            COFFEE_ERROR("Timer could not be removed: {0}", SDL_GetError());
-        }
-
+        TimerWheel::Cancel(m_TimerID);
+        m_TimerID = TimerWheel::InvalidTimer;
+        m_Paused = false;
     }
 
     void Timer::setPaused(bool paused)
     {
+        m_Paused = paused;
+
         if(paused)
         {
-            Stop();
+            TimerWheel::Pause(m_TimerID);
         }
         else
         {
-            Start(GetTimeLeft());
+            TimerWheel::Resume(m_TimerID);
         }
     }
 
@@ -78,4 +62,4 @@ namespace Coffee
         m_WaitTime = waitTime;
     }
 
-} // namespace Coffee
\ No newline at end of file
+} // namespace Coffee
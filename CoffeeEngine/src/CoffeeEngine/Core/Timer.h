@@ -7,9 +7,8 @@
 #pragma once
 
 #include "CoffeeEngine/Core/Assert.h"
-#include "Stopwatch.h"
+#include "CoffeeEngine/Core/TimerWheel.h"
 
-#include "SDL3/SDL_timer.h"
 #include <functional>
 
 namespace Coffee
@@ -17,6 +16,9 @@ namespace Coffee
     /**
      * @class Timer
      * @brief A class that represents a timer with various functionalities.
+     *
+     * Timers are scheduled on the TimerWheel, so the callback runs on the main thread at the start of the frame
+     * update. A timer that is not one-shot fires repeatedly every wait time until it is stopped.
      */
     class Timer
     {
@@ -37,6 +39,14 @@ namespace Coffee
          */
         Timer(double waitTime, bool autoStart, bool oneShot, TimerCallback callback);
 
+        /**
+         * @brief Destructor. Stops the timer.
+         */
+        ~Timer();
+
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
         /**
          * @brief Starts the timer with a specified wait time.
          * @param waitTime The time to wait before the timer triggers.
@@ -98,14 +108,15 @@ namespace Coffee
 
         /**
          * @brief Checks if the timer is stopped.
+         * @return True if the timer is not running nor paused, false otherwise.
          */
-        void isStopped();
+        bool isStopped() const { return !TimerWheel::IsActive(m_TimerID); }
 
         /**
          * @brief Gets the remaining time before the timer triggers.
-         * @return The remaining time before the timer triggers.
+         * @return The remaining time before the timer triggers, or 0 if the timer is stopped.
          */
-        double GetTimeLeft() const { return m_WaitTime - m_Stopwatch.GetElapsedTime(); }
+        double GetTimeLeft() const { return TimerWheel::GetTimeLeft(m_TimerID); }
 
         /**
          * @brief Sets the callback function to be called when the timer triggers.
@@ -125,10 +136,8 @@ namespace Coffee
         bool m_AutoStart = false; ///< Whether the timer should start automatically.
         bool m_Paused = false; ///< Whether the timer is paused.
 
-        Stopwatch m_Stopwatch; ///< Stopwatch to measure elapsed time.
-
         TimerCallback m_Callback; ///< The callback function to be called when the timer triggers.
-        SDL_TimerID m_TimerID; ///< The SDL timer ID.
+        TimerWheel::TimerID m_TimerID = TimerWheel::InvalidTimer; ///< The timer scheduled on the TimerWheel.
     };
 
     /** @} */
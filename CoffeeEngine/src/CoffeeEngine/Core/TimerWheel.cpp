@@ -0,0 +1,368 @@
+#include "CoffeeEngine/Core/TimerWheel.h"
+
+#include "CoffeeEngine/Core/FrameProfiler.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <deque>
+#include <vector>
+
+namespace Coffee {
+
+    static constexpr double TicksPerSecond = 1000.0;
+    static constexpr uint32_t SlotBits = 8;
+    static constexpr uint32_t SlotCount = 1 << SlotBits;
+    static constexpr uint64_t SlotMask = SlotCount - 1;
+    static constexpr uint32_t LevelCount = 4;
+    static constexpr uint64_t MaxDelay = (1ull << (SlotBits * LevelCount)) - 1;
+
+    static constexpr uint32_t NoIndex = UINT32_MAX;
+    static constexpr uint32_t FiringList = LevelCount * SlotCount; ///< Timers taken out of the wheel to be fired.
+    static constexpr uint32_t NoList = FiringList + 1;
+
+    enum class TimerState : uint8_t
+    {
+        Free,
+        Scheduled,
+        Paused,
+        Firing
+    };
+
+    struct TimerNode
+    {
+        TimerWheel::TimerCallback Callback;
+        uint64_t Expires = 0; ///< The tick the timer fires at, while scheduled.
+        uint64_t Remaining = 0; ///< The ticks left, while paused.
+        uint64_t Period = 0; ///< The ticks between calls, 0 for one-shot timers.
+        uint32_t Prev = NoIndex;
+        uint32_t Next = NoIndex;
+        uint32_t List = NoList; ///< The slot (level * SlotCount + slot) or list the timer is linked into.
+        uint32_t Generation = 1; ///< Bumped every time the node is freed, so old IDs stop matching.
+        TimerState State = TimerState::Free;
+        bool Cancelled = false; ///< Cancelled from its own callback; freed once the callback returns.
+    };
+
+    struct TimerWheelData
+    {
+        TimerWheelData() { Heads.fill(NoIndex); }
+
+        std::deque<TimerNode> Nodes; ///< A deque so nodes don't move when a callback schedules new timers.
+        std::vector<uint32_t> FreeNodes;
+        std::array<uint32_t, FiringList + 1> Heads; ///< First node of every slot, plus the firing list.
+
+        uint64_t CurrentTick = 0; ///< The next tick to process.
+        double Accumulator = 0.0; ///< Elapsed ticks not processed yet.
+        uint32_t ActiveCount = 0;
+        uint32_t LinkedCount = 0;
+    };
+
+    static TimerWheelData s_TimerWheelData;
+
+    static uint64_t ToTicks(double seconds)
+    {
+        // The tolerance keeps delays like 2.007 s (2007.0000000000002 ticks in floating point) from rounding up.
+        const double ticks = std::ceil(seconds * TicksPerSecond - 1e-6);
+        return std::clamp<uint64_t>(static_cast<uint64_t>(std::max(ticks, 0.0)), 1, MaxDelay);
+    }
+
+    static TimerWheel::TimerID MakeID(uint32_t index)
+    {
+        return (static_cast<uint64_t>(s_TimerWheelData.Nodes[index].Generation) << 32) | index;
+    }
+
+    static TimerNode* Find(TimerWheel::TimerID id)
+    {
+        auto& data = s_TimerWheelData;
+
+        const uint32_t index = static_cast<uint32_t>(id);
+        if (index >= data.Nodes.size())
+            return nullptr;
+
+        TimerNode& node = data.Nodes[index];
+        if (node.Generation != static_cast<uint32_t>(id >> 32) || node.State == TimerState::Free || node.Cancelled)
+            return nullptr;
+
+        return &node;
+    }
+
+    static void Link(uint32_t index, uint32_t list)
+    {
+        auto& data = s_TimerWheelData;
+        TimerNode& node = data.Nodes[index];
+
+        node.List = list;
+        node.Prev = NoIndex;
+        node.Next = data.Heads[list];
+        if (node.Next != NoIndex)
+            data.Nodes[node.Next].Prev = index;
+        data.Heads[list] = index;
+
+        data.LinkedCount++;
+    }
+
+    static void Unlink(uint32_t index)
+    {
+        auto& data = s_TimerWheelData;
+        TimerNode& node = data.Nodes[index];
+
+        if (node.List == NoList)
+            return;
+
+        if (node.Prev != NoIndex)
+            data.Nodes[node.Prev].Next = node.Next;
+        else
+            data.Heads[node.List] = node.Next;
+
+        if (node.Next != NoIndex)
+            data.Nodes[node.Next].Prev = node.Prev;
+
+        node.List = NoList;
+        node.Prev = node.Next = NoIndex;
+
+        data.LinkedCount--;
+    }
+
+    /**
+     * Links a timer into the slot of its expiration tick, in the lowest level whose range still reaches it.
+     */
+    static void Insert(uint32_t index)
+    {
+        auto& data = s_TimerWheelData;
+        TimerNode& node = data.Nodes[index];
+
+        node.Expires = std::clamp(node.Expires, data.CurrentTick, data.CurrentTick + MaxDelay);
+        const uint64_t delta = node.Expires - data.CurrentTick;
+
+        uint32_t level = 0;
+        while (level < LevelCount - 1 && delta >= (1ull << (SlotBits * (level + 1))))
+            level++;
+
+        const uint32_t slot = static_cast<uint32_t>((node.Expires >> (SlotBits * level)) & SlotMask);
+        Link(index, level * SlotCount + slot);
+    }
+
+    static void Release(uint32_t index)
+    {
+        auto& data = s_TimerWheelData;
+        TimerNode& node = data.Nodes[index];
+
+        Unlink(index);
+        node.Callback = nullptr;
+        node.State = TimerState::Free;
+        node.Cancelled = false;
+        if (++node.Generation == 0)
+            node.Generation = 1;
+
+        data.FreeNodes.push_back(index);
+        data.ActiveCount--;
+    }
+
+    /**
+     * Moves every timer of a slot to the list it now belongs to: a lower level, or the firing list.
+     */
+    static void MoveSlot(uint32_t list, uint32_t target = NoList)
+    {
+        auto& data = s_TimerWheelData;
+
+        uint32_t index = data.Heads[list];
+        while (index != NoIndex)
+        {
+            const uint32_t next = data.Nodes[index].Next;
+
+            Unlink(index);
+            if (target == NoList)
+                Insert(index);
+            else
+                Link(index, target);
+
+            index = next;
+        }
+    }
+
+    static void ProcessTick()
+    {
+        auto& data = s_TimerWheelData;
+        const uint64_t tick = data.CurrentTick;
+
+        // When a level wraps around, the next slot of the level above comes into range: cascade it down.
+        for (uint32_t level = 1; level < LevelCount; level++)
+        {
+            if (((tick >> (SlotBits * (level - 1))) & SlotMask) != 0)
+                break;
+
+            MoveSlot(level * SlotCount + static_cast<uint32_t>((tick >> (SlotBits * level)) & SlotMask));
+        }
+
+        // Take the expired timers out of the wheel first, so callbacks that schedule a timer 256 ticks ahead
+        // (which lands in this same slot) don't get it fired now.
+        MoveSlot(static_cast<uint32_t>(tick & SlotMask), FiringList);
+        data.CurrentTick = tick + 1;
+
+        while (data.Heads[FiringList] != NoIndex)
+        {
+            const uint32_t index = data.Heads[FiringList];
+            TimerNode& node = data.Nodes[index];
+
+            Unlink(index);
+            node.State = TimerState::Firing;
+            node.Callback();
+
+            // The callback may have paused or rescheduled its own timer: only a one-shot timer that is still
+            // firing is done.
+            if (node.Cancelled || (node.Period == 0 && node.State == TimerState::Firing))
+            {
+                Release(index);
+            }
+            else if (node.State == TimerState::Firing)
+            {
+                node.Expires = tick + node.Period;
+                node.State = TimerState::Scheduled;
+                Insert(index);
+            }
+        }
+    }
+
+    void TimerWheel::Shutdown()
+    {
+        auto& data = s_TimerWheelData;
+
+        data.Nodes.clear();
+        data.FreeNodes.clear();
+        data.Heads.fill(NoIndex);
+        data.Accumulator = 0.0;
+        data.ActiveCount = 0;
+        data.LinkedCount = 0;
+    }
+
+    void TimerWheel::Advance(double deltaTime)
+    {
+        ZoneScoped;
+
+        auto& data = s_TimerWheelData;
+
+        data.Accumulator += deltaTime * TicksPerSecond;
+        const uint64_t ticks = static_cast<uint64_t>(data.Accumulator);
+        data.Accumulator -= static_cast<double>(ticks);
+
+        // Nothing to fire or cascade, just jump ahead.
+        if (data.LinkedCount == 0)
+        {
+            data.CurrentTick += ticks;
+            return;
+        }
+
+        for (uint64_t i = 0; i < ticks; i++)
+            ProcessTick();
+    }
+
+    TimerWheel::TimerID TimerWheel::Schedule(double delay, TimerCallback callback, double period)
+    {
+        auto& data = s_TimerWheelData;
+
+        uint32_t index;
+        if (!data.FreeNodes.empty())
+        {
+            index = data.FreeNodes.back();
+            data.FreeNodes.pop_back();
+        }
+        else
+        {
+            index = static_cast<uint32_t>(data.Nodes.size());
+            data.Nodes.emplace_back();
+        }
+
+        TimerNode& node = data.Nodes[index];
+        node.Callback = std::move(callback);
+        node.Period = period > 0.0 ? ToTicks(period) : 0;
+        node.Expires = data.CurrentTick + ToTicks(delay) - 1;
+        node.State = TimerState::Scheduled;
+        Insert(index);
+
+        data.ActiveCount++;
+        return MakeID(index);
+    }
+
+    void TimerWheel::Cancel(TimerID id)
+    {
+        TimerNode* node = Find(id);
+        if (!node)
+            return;
+
+        if (node->State == TimerState::Firing)
+            node->Cancelled = true;
+        else
+            Release(static_cast<uint32_t>(id));
+    }
+
+    void TimerWheel::Pause(TimerID id)
+    {
+        TimerNode* node = Find(id);
+        if (!node)
+            return;
+
+        if (node->State == TimerState::Scheduled)
+        {
+            node->Remaining = node->Expires + 1 - s_TimerWheelData.CurrentTick;
+            Unlink(static_cast<uint32_t>(id));
+            node->State = TimerState::Paused;
+        }
+        else if (node->State == TimerState::Firing)
+        {
+            node->Remaining = std::max<uint64_t>(node->Period, 1);
+            node->State = TimerState::Paused;
+        }
+    }
+
+    void TimerWheel::Resume(TimerID id)
+    {
+        TimerNode* node = Find(id);
+        if (!node || node->State != TimerState::Paused)
+            return;
+
+        node->Expires = s_TimerWheelData.CurrentTick + node->Remaining - 1;
+        node->State = TimerState::Scheduled;
+        Insert(static_cast<uint32_t>(id));
+    }
+
+    bool TimerWheel::IsActive(TimerID id)
+    {
+        return Find(id) != nullptr;
+    }
+
+    bool TimerWheel::IsPaused(TimerID id)
+    {
+        const TimerNode* node = Find(id);
+        return node && node->State == TimerState::Paused;
+    }
+
+    double TimerWheel::GetTimeLeft(TimerID id)
+    {
+        const TimerNode* node = Find(id);
+        if (!node)
+            return 0.0;
+
+        double ticks = 0.0;
+        switch (node->State)
+        {
+            case TimerState::Scheduled:
+                ticks = static_cast<double>(node->Expires + 1 - s_TimerWheelData.CurrentTick) - s_TimerWheelData.Accumulator;
+                break;
+            case TimerState::Paused:
+                ticks = static_cast<double>(node->Remaining);
+                break;
+            case TimerState::Firing:
+                ticks = static_cast<double>(node->Period);
+                break;
+            default:
+                break;
+        }
+        return std::max(ticks, 0.0) / TicksPerSecond;
+    }
+
+    uint32_t TimerWheel::GetActiveCount()
+    {
+        return s_TimerWheelData.ActiveCount;
+    }
+
+} // namespace Coffee
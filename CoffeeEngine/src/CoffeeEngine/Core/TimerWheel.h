@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace Coffee {
+
+    /**
+     * @defgroup core Core
+     * @{
+     */
+
+    /**
+     * @brief Main-thread scheduler for timers.
+     *
+     * A hierarchical timing wheel with a 1 ms tick: four levels of 256 slots, each level covering 256 times the
+     * range of the one below, so delays up to ~49 days are supported. Scheduling and cancelling a timer is O(1)
+     * (it is linked into or out of a slot), and a timer only moves down a level when the wheel below wraps around.
+     *
+     * Timers live in a pool that is reused, so a paused timer only leaves its slot and keeps its remaining time,
+     * no memory is freed or allocated. Callbacks run on the main thread inside Advance, which the Application
+     * calls once per frame before the layers update, so they fire at the same point of every frame. Callbacks
+     * may schedule, cancel or pause any timer, including their own.
+     */
+    class TimerWheel
+    {
+      public:
+        using TimerID = uint64_t;
+        using TimerCallback = std::function<void()>;
+
+        static constexpr TimerID InvalidTimer = 0;
+
+        /**
+         * @brief Cancels every timer and frees the pool.
+         */
+        static void Shutdown();
+
+        /**
+         * @brief Moves time forward and fires every timer that expired, in expiration order.
+         * @param deltaTime The elapsed time, in seconds.
+         */
+        static void Advance(double deltaTime);
+
+        /**
+         * @brief Schedules a timer.
+         * @param delay The time before the first call, in seconds. Rounded up to the next tick.
+         * @param callback The function to call.
+         * @param period The time between later calls, in seconds, or 0 for a one-shot timer.
+         * @return The ID of the timer.
+         */
+        static TimerID Schedule(double delay, TimerCallback callback, double period = 0.0);
+
+        /**
+         * @brief Cancels a timer. Does nothing if the timer already finished or was cancelled.
+         * @param id The ID of the timer.
+         */
+        static void Cancel(TimerID id);
+
+        /**
+         * @brief Stops a timer's countdown, keeping its remaining time.
+         * @param id The ID of the timer.
+         */
+        static void Pause(TimerID id);
+
+        /**
+         * @brief Restarts the countdown of a paused timer.
+         * @param id The ID of the timer.
+         */
+        static void Resume(TimerID id);
+
+        /**
+         * @brief Checks if a timer is scheduled or paused.
+         * @param id The ID of the timer.
+         * @return True if the timer has not finished nor been cancelled, false otherwise.
+         */
+        static bool IsActive(TimerID id);
+
+        /**
+         * @brief Checks if a timer is paused.
+         * @param id The ID of the timer.
+         * @return True if the timer is paused, false otherwise.
+         */
+        static bool IsPaused(TimerID id);
+
+        /**
+         * @brief Gets the time before a timer fires.
+         * @param id The ID of the timer.
+         * @return The remaining time in seconds, or 0 if the timer is not active.
+         */
+        static double GetTimeLeft(TimerID id);
+
+        /**
+         * @brief Gets the number of active timers.
+         * @return The number of scheduled and paused timers.
+         */
+        static uint32_t GetActiveCount();
+    };
+
+    /** @} */
+} // namespace Coffee
@@ -1,16 +1,60 @@
 #include "UUID.h"
 #include <random>
-#include <unordered_map>
 
 namespace Coffee {
 
-    static std::random_device s_RandomDevice;
-    static std::mt19937_64 s_Engine(s_RandomDevice());
-    static std::uniform_int_distribution<uint64_t> s_UniformDistribution;
+    static uint64_t SplitMix64(uint64_t& state)
+    {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * xoshiro256** generator. One per thread, so concurrent loaders never share state and need no lock.
+     */
+    class UUIDGenerator
+    {
+    public:
+        UUIDGenerator()
+        {
+            // Seeded once per thread from the OS; splitmix64 expands the seed into the four state words.
+            std::random_device randomDevice;
+            uint64_t seed = (static_cast<uint64_t>(randomDevice()) << 32) ^ randomDevice();
+            for (uint64_t& word : m_State)
+                word = SplitMix64(seed);
+        }
+
+        uint64_t Next()
+        {
+            const uint64_t result = Rotate(m_State[1] * 5, 7) * 9;
+            const uint64_t t = m_State[1] << 17;
+
+            m_State[2] ^= m_State[0];
+            m_State[3] ^= m_State[1];
+            m_State[1] ^= m_State[2];
+            m_State[0] ^= m_State[3];
+            m_State[2] ^= t;
+            m_State[3] = Rotate(m_State[3], 45);
+
+            return result;
+        }
+
+    private:
+        static uint64_t Rotate(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+        uint64_t m_State[4];
+    };
+
+    static thread_local UUIDGenerator s_Generator;
 
     UUID::UUID()
-        : m_UUID(s_UniformDistribution(s_Engine))
     {
+        // 0 is UUID::null.
+        do
+            m_UUID = s_Generator.Next();
+        while (m_UUID == 0);
     }
 
     UUID::UUID(uint64_t uuid)
@@ -18,4 +62,4 @@ namespace Coffee {
     {
     }
 
-}
\ No newline at end of file
+}
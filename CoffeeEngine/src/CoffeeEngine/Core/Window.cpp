@@ -2,6 +2,7 @@
 #include "CoffeeEngine/Core/Assert.h"
 #include "CoffeeEngine/Core/Base.h"
 #include "CoffeeEngine/Core/Log.h"
+#include "CoffeeEngine/Renderer/RendererAPI.h"
 #include "SDL3/SDL_init.h"
 #include "SDL3/SDL_pixels.h"
 #include "SDL3/SDL_surface.h"
@@ -9,7 +10,7 @@
 
 #include <SDL3/SDL.h>
 
-#include <tracy/Tracy.hpp>
+#include "CoffeeEngine/Core/FrameProfiler.h"
 
 #include <stb_image.h>
 
@@ -41,9 +42,16 @@ namespace Coffee {
 
 		COFFEE_CORE_INFO("Creating window {0} ({1}, {2})", props.Title, props.Width, props.Height);
 
+        const bool headless = RendererAPI::GetAPI() == RendererAPI::API::Null;
+
         if (s_SDLWindowCount == 0)
 		{
             ZoneScopedN("SDL3 Init");
+
+            // The dummy driver needs no display, so headless runs work on build machines and containers.
+            if (headless)
+                SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+
 			int success = SDL_Init(SDL_INIT_VIDEO);
 			COFFEE_CORE_ASSERT(success, "Could not initialize SDL!");
 		}
@@ -63,7 +71,9 @@ namespace Coffee {
 			SDL_GL_SetAttribute(SDL_GL_CONTEXT_FLAGS, SDL_GL_CONTEXT_DEBUG_FLAG);
 		    #endif
 
-            Uint32 windowFlags = SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE | SDL_WINDOW_HIDDEN | SDL_WINDOW_HIGH_PIXEL_DENSITY;
+            Uint32 windowFlags = SDL_WINDOW_RESIZABLE | SDL_WINDOW_HIDDEN | SDL_WINDOW_HIGH_PIXEL_DENSITY;
+            if (!headless)
+                windowFlags |= SDL_WINDOW_OPENGL;
 
 			m_Window = SDL_CreateWindow(m_Data.Title.c_str(), (int)props.Width, (int)props.Height, windowFlags);
 
@@ -77,9 +87,10 @@ namespace Coffee {
 		m_Context = GraphicsContext::Create(m_Window);
 		m_Context->Init();
 
-		SetVSync(true);
+		SetVSync(!headless);
 
-        SDL_ShowWindow(m_Window);
+        if (!headless)
+            SDL_ShowWindow(m_Window);
     }
 
 	void Window::Shutdown()
@@ -20,7 +20,7 @@ namespace Coffee {
     {
     public:
         WindowResizeEvent(unsigned int width, unsigned int height)
-            : m_Width(width), m_Height(height) {}
+            : Event(GetStaticType()), m_Width(width), m_Height(height) {}
 
         /**
          * @brief Get the width of the window.
@@ -57,7 +57,7 @@ namespace Coffee {
     class WindowCloseEvent : public Event
     {
     public:
-        WindowCloseEvent() = default;
+        WindowCloseEvent() : Event(GetStaticType()) {}
 
         EVENT_CLASS_TYPE(WindowClose)
         EVENT_CLASS_CATEGORY(EventCategoryApplication)
@@ -70,7 +70,7 @@ namespace Coffee {
     {
     public:
         FileDropEvent(uint64_t timestamp, uint32_t windowID, float x, float y, const std::string& source, const std::string& file)
-            : m_Timestamp(timestamp), m_WindowID(windowID), m_X(x), m_Y(y), m_Source(source), m_File(file) {}
+            : Event(GetStaticType()), m_Timestamp(timestamp), m_WindowID(windowID), m_X(x), m_Y(y), m_Source(source), m_File(file) {}
         
         /**
             * @brief Get the timestamp of the event.
@@ -136,7 +136,7 @@ namespace Coffee {
     class AppTickEvent : public Event
     {
     public:
-        AppTickEvent() = default;
+        AppTickEvent() : Event(GetStaticType()) {}
 
         EVENT_CLASS_TYPE(AppTick)
         EVENT_CLASS_CATEGORY(EventCategoryApplication)
@@ -148,7 +148,7 @@ namespace Coffee {
     class AppUpdateEvent : public Event
     {
     public:
-        AppUpdateEvent() = default;
+        AppUpdateEvent() : Event(GetStaticType()) {}
 
         EVENT_CLASS_TYPE(AppUpdate)
         EVENT_CLASS_CATEGORY(EventCategoryApplication)
@@ -160,7 +160,7 @@ namespace Coffee {
     class AppRenderEvent : public Event
     {
     public:
-        AppRenderEvent() = default;
+        AppRenderEvent() : Event(GetStaticType()) {}
 
         EVENT_CLASS_TYPE(AppRender)
         EVENT_CLASS_CATEGORY(EventCategoryApplication)
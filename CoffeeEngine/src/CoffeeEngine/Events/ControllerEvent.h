@@ -13,7 +13,7 @@ namespace Coffee
     class AxisMoveEvent : public Event
     {
     public:
-        AxisMoveEvent(ControllerCode id, AxisCode code, float value) : Controller(id), Axis(code), Value(value)
+        AxisMoveEvent(ControllerCode id, AxisCode code, float value) : Event(GetStaticType()), Controller(id), Axis(code), Value(value)
         {}
 
         ControllerCode Controller;
@@ -31,7 +31,7 @@ namespace Coffee
     class ButtonPressEvent : public Event
     {
     public:
-        ButtonPressEvent(ControllerCode id, ButtonCode code) : Controller(id), Button(code)
+        ButtonPressEvent(ControllerCode id, ButtonCode code) : Event(GetStaticType()), Controller(id), Button(code)
         {}
         ControllerCode Controller;
         ButtonCode Button;
@@ -47,7 +47,7 @@ namespace Coffee
     class ButtonReleaseEvent : public Event
     {
     public:
-        ButtonReleaseEvent(ControllerCode id, ButtonCode code) : Controller(id), Button(code)
+        ButtonReleaseEvent(ControllerCode id, ButtonCode code) : Event(GetStaticType()), Controller(id), Button(code)
         {}
         ControllerCode Controller;
         ButtonCode Button;
@@ -63,7 +63,7 @@ namespace Coffee
     class ControllerAddEvent : public Event
     {
     public:
-        ControllerAddEvent(ControllerCode id) : Controller(id)
+        ControllerAddEvent(ControllerCode id) : Event(GetStaticType()), Controller(id)
         {}
         ControllerCode Controller;
 
@@ -78,7 +78,7 @@ namespace Coffee
     class ControllerRemoveEvent : public Event
     {
     public:
-        ControllerRemoveEvent(ControllerCode id) :Controller(id)
+        ControllerRemoveEvent(ControllerCode id) : Event(GetStaticType()), Controller(id)
         {}
         ControllerCode Controller;
 
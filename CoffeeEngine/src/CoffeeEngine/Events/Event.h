@@ -24,6 +24,8 @@ namespace Coffee {
         MouseButtonPressed, MouseButtonReleased, MouseMoved, MouseScrolled,
         ButtonPressed, ButtonReleased, AxisMoved,
         ControllerConnected, ControllerDisconnected,
+
+        Count ///< Number of event types, used to size per-type tables.
     };
 
     /**
@@ -41,11 +43,50 @@ namespace Coffee {
         EventCategoryControllerButton = BIT(6),
     };
 
+    /**
+     * @brief Category flags of every event type, indexed by EventType.
+     *
+     * Lets category checks run without a virtual call. Keep in sync with the EVENT_CLASS_CATEGORY of each event.
+     */
+    inline constexpr int EventCategoryTable[static_cast<size_t>(EventType::Count)] = {
+        /* None */                   0,
+        /* WindowClose */            EventCategoryApplication,
+        /* WindowResize */           EventCategoryApplication,
+        /* WindowFocus */            EventCategoryApplication,
+        /* WindowLostFocus */        EventCategoryApplication,
+        /* WindowMoved */            EventCategoryApplication,
+        /* FileDrop */               EventCategoryApplication,
+        /* AppTick */                EventCategoryApplication,
+        /* AppUpdate */              EventCategoryApplication,
+        /* AppRender */              EventCategoryApplication,
+        /* KeyPressed */             EventCategoryKeyboard | EventCategoryInput,
+        /* KeyReleased */            EventCategoryKeyboard | EventCategoryInput,
+        /* KeyTyped */               EventCategoryKeyboard | EventCategoryInput,
+        /* MouseButtonPressed */     EventCategoryMouse | EventCategoryInput | EventCategoryMouseButton,
+        /* MouseButtonReleased */    EventCategoryMouse | EventCategoryInput | EventCategoryMouseButton,
+        /* MouseMoved */             EventCategoryMouse | EventCategoryInput,
+        /* MouseScrolled */          EventCategoryMouse | EventCategoryInput,
+        /* ButtonPressed */          EventCategoryControllerButton | EventCategoryInput,
+        /* ButtonReleased */         EventCategoryControllerButton | EventCategoryInput,
+        /* AxisMoved */              EventCategoryControllerAxis | EventCategoryInput,
+        /* ControllerConnected */    EventCategoryInput,
+        /* ControllerDisconnected */ EventCategoryInput,
+    };
+
+    /**
+     * @brief Get the category flags of an event type.
+     * @param type The event type.
+     * @return The category flags.
+     */
+    constexpr int GetEventCategoryFlags(EventType type)
+    {
+        return EventCategoryTable[static_cast<size_t>(type)];
+    }
+
     /**
      * @brief Macro to define the type of an event.
      */
     #define EVENT_CLASS_TYPE(type) static EventType GetStaticType() { return EventType::type; }\
-                                virtual EventType GetEventType() const override { return GetStaticType(); }\
                                 virtual const char* GetName() const override { return #type; }
 
     /**
@@ -64,10 +105,10 @@ namespace Coffee {
         bool Handled = false;
 
         /**
-         * @brief Get the type of the event.
+         * @brief Get the type of the event. Stored at construction, so no virtual call is needed.
          * @return The event type.
          */
-        virtual EventType GetEventType() const = 0;
+        EventType GetEventType() const { return m_Type; }
 
         /**
          * @brief Get the name of the event.
@@ -92,10 +133,19 @@ namespace Coffee {
          * @param category The category to check.
          * @return True if the event is in the category, false otherwise.
          */
-        bool IsInCategory(EventCategory category)
+        bool IsInCategory(EventCategory category) const
         {
-            return GetCategoryFlags() & category;
+            return GetEventCategoryFlags(m_Type) & category;
         }
+    protected:
+        /**
+         * @brief Constructor for Event.
+         * @param type The type of the concrete event, usually its GetStaticType().
+         */
+        explicit Event(EventType type) : m_Type(type) {}
+
+    private:
+        EventType m_Type;
     };
 
     /**
@@ -0,0 +1,119 @@
+#include "CoffeeEngine/Events/EventBus.h"
+
+#include <algorithm>
+
+namespace Coffee {
+
+    EventBus::SubscriptionID EventBus::Subscribe(EventType type, HandlerFn handler, int priority)
+    {
+        Subscriber subscriber{m_NextID++, priority, std::move(handler)};
+
+        if (m_PublishDepth > 0)
+            m_PendingSubscribes.emplace_back(type, subscriber);
+        else
+            Insert(type, subscriber);
+
+        return subscriber.ID;
+    }
+
+    EventBus::SubscriptionID EventBus::SubscribeCategory(int categoryFlags, HandlerFn handler, int priority)
+    {
+        Subscriber subscriber{m_NextID++, priority, std::move(handler), true};
+
+        // The same id is registered for every matching type so a single Unsubscribe removes all of them.
+        for (size_t i = 0; i < static_cast<size_t>(EventType::Count); i++)
+        {
+            EventType type = static_cast<EventType>(i);
+            if (!(GetEventCategoryFlags(type) & categoryFlags))
+                continue;
+
+            if (m_PublishDepth > 0)
+                m_PendingSubscribes.emplace_back(type, subscriber);
+            else
+                Insert(type, subscriber);
+        }
+
+        return subscriber.ID;
+    }
+
+    void EventBus::Unsubscribe(SubscriptionID id)
+    {
+        if (m_PublishDepth > 0)
+        {
+            m_PendingUnsubscribes.push_back(id);
+
+            // Stop the handler from running again during the current dispatch.
+            for (auto& subscribers : m_Subscribers)
+            {
+                for (auto& subscriber : subscribers)
+                {
+                    if (subscriber.ID == id)
+                        subscriber.Handler = nullptr;
+                }
+            }
+            return;
+        }
+
+        Remove(id);
+    }
+
+    void EventBus::Publish(Event& e)
+    {
+        const auto& subscribers = m_Subscribers[static_cast<size_t>(e.GetEventType())];
+        if (subscribers.empty())
+            return;
+
+        m_PublishDepth++;
+        for (const auto& subscriber : subscribers)
+        {
+            if (!subscriber.Handler)
+                continue;
+
+            e.Handled |= subscriber.Handler(e);
+            if (e.Handled)
+                break;
+        }
+        m_PublishDepth--;
+
+        if (m_PublishDepth == 0)
+        {
+            for (const auto& [type, subscriber] : m_PendingSubscribes)
+                Insert(type, subscriber);
+            m_PendingSubscribes.clear();
+
+            for (SubscriptionID id : m_PendingUnsubscribes)
+                Remove(id);
+            m_PendingUnsubscribes.clear();
+        }
+    }
+
+    void EventBus::Insert(EventType type, const Subscriber& subscriber)
+    {
+        auto& subscribers = m_Subscribers[static_cast<size_t>(type)];
+
+        // Before the first subscriber with the same or a lower priority, so newer subscribers run first.
+        auto it = std::find_if(subscribers.begin(), subscribers.end(),
+                               [&subscriber](const Subscriber& s) { return s.Priority <= subscriber.Priority; });
+        subscribers.insert(it, subscriber);
+
+        if (!subscriber.Category)
+            m_TypedSubscriberCounts[static_cast<size_t>(type)]++;
+    }
+
+    void EventBus::Remove(SubscriptionID id)
+    {
+        for (size_t i = 0; i < m_Subscribers.size(); i++)
+        {
+            std::erase_if(m_Subscribers[i], [this, i, id](const Subscriber& s) {
+                if (s.ID != id)
+                    return false;
+                if (!s.Category)
+                    m_TypedSubscriberCounts[i]--;
+                return true;
+            });
+        }
+
+        std::erase_if(m_PendingSubscribes, [id](const auto& pending) { return pending.second.ID == id; });
+    }
+
+} // namespace Coffee
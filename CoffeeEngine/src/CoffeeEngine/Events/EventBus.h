@@ -0,0 +1,125 @@
+#pragma once
+
+#include "CoffeeEngine/Events/Event.h"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace Coffee {
+
+    /**
+     * @defgroup events Events
+     * @{
+     */
+
+    namespace EventPriority
+    {
+        /**
+         * @brief Common subscriber priorities. Higher priorities receive events first.
+         */
+        enum : int
+        {
+            Low = -100,
+            Default = 0,
+            High = 100,
+            Overlay = 1000 ///< Overlays such as ImGui, which may consume events before the layers below.
+        };
+    } // namespace EventPriority
+
+    /**
+     * @brief Routes events to the handlers that subscribed to their type.
+     *
+     * Each EventType keeps its own subscriber list sorted by priority, so publishing an event only visits
+     * the interested handlers. Handlers run from the highest to the lowest priority (newest first among
+     * equal priorities, like the LayerStack) and dispatch stops as soon as one of them handles the event.
+     */
+    class EventBus
+    {
+      public:
+        using SubscriptionID = uint32_t;
+        using HandlerFn = std::function<bool(Event&)>; ///< Returns true to consume the event.
+
+        /**
+         * @brief Subscribes a handler to an event type.
+         * @param type The event type.
+         * @param handler The handler to call.
+         * @param priority The priority of the handler.
+         * @return The id of the subscription, used to unsubscribe.
+         */
+        SubscriptionID Subscribe(EventType type, HandlerFn handler, int priority = EventPriority::Default);
+
+        /**
+         * @brief Subscribes a handler to every event type in one or more categories.
+         * @param categoryFlags The EventCategory flags to match.
+         * @param handler The handler to call.
+         * @param priority The priority of the handler.
+         * @return The id of the subscription, used to unsubscribe.
+         */
+        SubscriptionID SubscribeCategory(int categoryFlags, HandlerFn handler, int priority = EventPriority::Default);
+
+        /**
+         * @brief Subscribes a typed handler to an event class.
+         * @tparam T The event class.
+         * @tparam F The function type, taking a T& and returning true to consume the event.
+         * @param func The handler to call.
+         * @param priority The priority of the handler.
+         * @return The id of the subscription, used to unsubscribe.
+         */
+        template<typename T, typename F>
+        SubscriptionID Subscribe(F&& func, int priority = EventPriority::Default)
+        {
+            return Subscribe(
+                T::GetStaticType(), [func = std::forward<F>(func)](Event& e) { return func(static_cast<T&>(e)); },
+                priority);
+        }
+
+        /**
+         * @brief Removes a subscription. Safe to call from inside a handler.
+         * @param id The id returned when subscribing.
+         */
+        void Unsubscribe(SubscriptionID id);
+
+        /**
+         * @brief Checks if anything subscribed to an event type by its type.
+         *
+         * Category subscriptions are not counted: they filter events for the handlers below them (like the ImGui
+         * overlay), so an event that only they would see can be skipped entirely.
+         * @param type The event type.
+         * @return True if the type has typed subscribers, false otherwise.
+         */
+        bool HasSubscribers(EventType type) const { return m_TypedSubscriberCounts[static_cast<size_t>(type)] > 0; }
+
+        /**
+         * @brief Dispatches an event to the subscribers of its type until one handles it.
+         * @param e The event to dispatch.
+         */
+        void Publish(Event& e);
+
+      private:
+        struct Subscriber
+        {
+            SubscriptionID ID;
+            int Priority;
+            HandlerFn Handler;
+            bool Category = false; ///< Registered by SubscribeCategory.
+        };
+
+        void Insert(EventType type, const Subscriber& subscriber);
+        void Remove(SubscriptionID id);
+
+        std::array<std::vector<Subscriber>, static_cast<size_t>(EventType::Count)> m_Subscribers;
+        std::array<uint32_t, static_cast<size_t>(EventType::Count)> m_TypedSubscriberCounts{};
+        SubscriptionID m_NextID = 1;
+
+        // Changes made by handlers are applied once the outermost Publish returns, so the lists never change
+        // while they are being iterated.
+        uint32_t m_PublishDepth = 0;
+        std::vector<std::pair<EventType, Subscriber>> m_PendingSubscribes;
+        std::vector<SubscriptionID> m_PendingUnsubscribes;
+    };
+
+    /** @} */ // end of events group
+} // namespace Coffee
@@ -0,0 +1,50 @@
+#include "CoffeeEngine/Events/EventQueue.h"
+
+#include "CoffeeEngine/Core/FrameProfiler.h"
+#include "CoffeeEngine/Core/Log.h"
+
+namespace Coffee {
+
+    EventQueue::~EventQueue()
+    {
+        Reset();
+    }
+
+    void EventQueue::Dispatch(EventBus& bus)
+    {
+        ZoneScoped;
+
+        // Events posted by handlers are delivered in later passes. The limit only guards against handlers that keep
+        // posting each other forever.
+        constexpr int MaxPasses = 8;
+
+        for (int pass = 0; pass < MaxPasses && m_Dispatched < m_Events.size(); pass++)
+        {
+            // Index-based on purpose: handlers may append to the queue while it is being delivered.
+            for (const size_t end = m_Events.size(); m_Dispatched < end; m_Dispatched++)
+                bus.Publish(*m_Events[m_Dispatched]);
+        }
+
+        if (m_Dispatched < m_Events.size())
+        {
+            COFFEE_CORE_WARN("EventQueue::Dispatch: Events are still being posted after {0} passes, {1} events are "
+                             "left for the next Dispatch", MaxPasses, m_Events.size() - m_Dispatched);
+        }
+    }
+
+    void EventQueue::Reset()
+    {
+        for (Event* event : m_Events)
+            event->~Event();
+        m_Events.clear();
+        m_Dispatched = 0;
+
+        m_Arena.Reset();
+    }
+
+    size_t EventQueue::GetPendingCount() const
+    {
+        return m_Events.size() - m_Dispatched;
+    }
+
+} // namespace Coffee
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoffeeEngine/Core/LinearArena.h"
+#include "CoffeeEngine/Events/Event.h"
+#include "CoffeeEngine/Events/EventBus.h"
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Coffee {
+
+    /**
+     * @defgroup events Events
+     * @{
+     */
+
+    /**
+     * @brief Per-frame queue of deferred events.
+     *
+     * Events are constructed in place in a linear arena owned by the queue, so posting never touches the heap once
+     * the arena has grown to the frame's working set. Dispatch delivers them in posting order, so a key release
+     * never overtakes its press. Handlers may post more events while the queue is dispatching; they are delivered
+     * after the ones already queued, in the same Dispatch call; past a pass limit the rest waits for the next Dispatch.
+     * Reset destroys the events, delivered or not, and rewinds the arena, keeping its memory.
+     */
+    class EventQueue
+    {
+      public:
+        EventQueue() = default;
+        ~EventQueue();
+
+        EventQueue(const EventQueue&) = delete;
+        EventQueue& operator=(const EventQueue&) = delete;
+
+        /**
+         * @brief Constructs an event in the queue.
+         * @tparam T The event class.
+         * @param args The arguments of the event constructor.
+         * @return A reference to the queued event, valid until Reset.
+         */
+        template<typename T, typename... Args>
+        T& Post(Args&&... args)
+        {
+            static_assert(std::is_base_of_v<Event, T>, "Only events can be posted");
+
+            void* memory = m_Arena.Allocate(sizeof(T), alignof(T));
+            T* event = new (memory) T(std::forward<Args>(args)...);
+            m_Events.push_back(event);
+            return *event;
+        }
+
+        /**
+         * @brief Publishes every pending event on an event bus, in posting order.
+         * @param bus The bus to publish the events on.
+         */
+        void Dispatch(EventBus& bus);
+
+        /**
+         * @brief Destroys every queued event and rewinds the arena. Call once per frame, after the last Dispatch.
+         */
+        void Reset();
+
+        /**
+         * @brief Gets the number of events waiting to be dispatched.
+         * @return The number of pending events.
+         */
+        size_t GetPendingCount() const;
+
+      private:
+        LinearArena m_Arena{16 * 1024}; ///< Storage of the queued events. Keeps its blocks between frames.
+
+        std::vector<Event*> m_Events; ///< The queued events, in posting order.
+        size_t m_Dispatched = 0; ///< The events already delivered.
+    };
+
+    /** @} */ // end of events group
+} // namespace Coffee
@@ -0,0 +1,315 @@
+#pragma once
+
+#include "CoffeeEngine/Core/ControllerCodes.h"
+#include "CoffeeEngine/Core/KeyCodes.h"
+#include "CoffeeEngine/Core/MouseCodes.h"
+#include "CoffeeEngine/Events/ControllerEvent.h"
+#include "CoffeeEngine/Events/Event.h"
+#include "CoffeeEngine/Events/KeyEvent.h"
+#include "CoffeeEngine/Events/MouseEvent.h"
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+namespace Coffee {
+
+    /**
+     * @defgroup events Events
+     * @{
+     */
+
+    /**
+     * @brief Compact, trivially copyable input event.
+     *
+     * Input events are produced at very high rates (1000 Hz mice, gamepad axes), so they are stored as a
+     * tagged union instead of a polymorphic Event. The type selects the active payload and the category
+     * flags come from the static EventCategoryTable, so inspecting an event never makes a virtual call.
+     */
+    struct InputEvent
+    {
+        struct KeyData
+        {
+            KeyCode Code;
+            bool IsRepeat;
+        };
+
+        struct MouseButtonData
+        {
+            MouseCode Button;
+        };
+
+        struct MouseMoveData
+        {
+            float X, Y; ///< Absolute position in the window.
+            float DeltaX, DeltaY; ///< Relative motion since the previous motion event.
+        };
+
+        struct MouseScrollData
+        {
+            float XOffset, YOffset;
+        };
+
+        struct ControllerButtonData
+        {
+            ControllerCode Controller;
+            ButtonCode Button;
+        };
+
+        struct ControllerAxisData
+        {
+            ControllerCode Controller;
+            AxisCode Axis;
+            float Value;
+        };
+
+        struct ControllerDeviceData
+        {
+            ControllerCode Controller;
+        };
+
+        EventType Type = EventType::None;
+        bool Handled = false;
+        uint64_t Timestamp = 0; ///< SDL timestamp in nanoseconds.
+
+        union
+        {
+            KeyData Key;
+            MouseButtonData MouseButton;
+            MouseMoveData MouseMove;
+            MouseScrollData MouseScroll;
+            ControllerButtonData ControllerButton;
+            ControllerAxisData ControllerAxis;
+            ControllerDeviceData ControllerDevice;
+        };
+
+        /**
+         * @brief Get the category flags of the event.
+         * @return The category flags.
+         */
+        int GetCategoryFlags() const { return GetEventCategoryFlags(Type); }
+
+        /**
+         * @brief Check if the event is in a specific category.
+         * @param category The category to check.
+         * @return True if the event is in the category, false otherwise.
+         */
+        bool IsInCategory(EventCategory category) const { return GetCategoryFlags() & category; }
+
+        static InputEvent MakeKey(EventType type, uint64_t timestamp, KeyCode code, bool isRepeat = false)
+        {
+            InputEvent e = Make(type, timestamp);
+            e.Key = {code, isRepeat};
+            return e;
+        }
+
+        static InputEvent MakeMouseButton(EventType type, uint64_t timestamp, MouseCode button)
+        {
+            InputEvent e = Make(type, timestamp);
+            e.MouseButton = {button};
+            return e;
+        }
+
+        static InputEvent MakeMouseMove(uint64_t timestamp, float x, float y, float deltaX, float deltaY)
+        {
+            InputEvent e = Make(EventType::MouseMoved, timestamp);
+            e.MouseMove = {x, y, deltaX, deltaY};
+            return e;
+        }
+
+        static InputEvent MakeMouseScroll(uint64_t timestamp, float xOffset, float yOffset)
+        {
+            InputEvent e = Make(EventType::MouseScrolled, timestamp);
+            e.MouseScroll = {xOffset, yOffset};
+            return e;
+        }
+
+        static InputEvent MakeControllerButton(EventType type, uint64_t timestamp, ControllerCode controller,
+                                               ButtonCode button)
+        {
+            InputEvent e = Make(type, timestamp);
+            e.ControllerButton = {controller, button};
+            return e;
+        }
+
+        static InputEvent MakeControllerAxis(uint64_t timestamp, ControllerCode controller, AxisCode axis, float value)
+        {
+            InputEvent e = Make(EventType::AxisMoved, timestamp);
+            e.ControllerAxis = {controller, axis, value};
+            return e;
+        }
+
+        static InputEvent MakeControllerDevice(EventType type, uint64_t timestamp, ControllerCode controller)
+        {
+            InputEvent e = Make(type, timestamp);
+            e.ControllerDevice = {controller};
+            return e;
+        }
+
+      private:
+        static InputEvent Make(EventType type, uint64_t timestamp)
+        {
+            InputEvent e;
+            e.Type = type;
+            e.Timestamp = timestamp;
+            return e;
+        }
+    };
+
+    static_assert(std::is_trivially_copyable_v<InputEvent>, "InputEvent must stay a POD so it can be copied and queued freely");
+
+    /**
+     * @brief Per-type table of input event handlers.
+     *
+     * Dispatch is a single indexed load and an indirect call, instead of a chain of type checks.
+     * A handler returns true to mark the event as handled.
+     */
+    class InputEventHandlerTable
+    {
+      public:
+        using HandlerFn = bool (*)(const InputEvent&);
+
+        /**
+         * @brief Sets the handler of an event type, replacing the previous one.
+         * @param type The event type.
+         * @param handler The handler, or nullptr to remove it.
+         */
+        constexpr void Bind(EventType type, HandlerFn handler) { m_Handlers[static_cast<size_t>(type)] = handler; }
+
+        /**
+         * @brief Calls the handler bound to the type of the event, if any.
+         * @param e The event to dispatch.
+         * @return True if a handler was called, false otherwise.
+         */
+        bool Dispatch(InputEvent& e) const
+        {
+            HandlerFn handler = m_Handlers[static_cast<size_t>(e.Type)];
+            if (!handler)
+                return false;
+
+            e.Handled |= handler(e);
+            return true;
+        }
+
+      private:
+        std::array<HandlerFn, static_cast<size_t>(EventType::Count)> m_Handlers{};
+    };
+
+    /**
+     * @brief Calls a function with the legacy Event matching an input event.
+     *
+     * Compatibility layer for code that still works with the Event class hierarchy. The Event is built once
+     * on the stack and its Handled flag is copied back into the input event. The function is called with the
+     * concrete event class, so it can also take it by `auto&` (e.g. to copy it into an EventQueue).
+     *
+     * @param e The input event.
+     * @param func The function to call, taking an Event& or auto&.
+     */
+    template<typename F>
+    void DispatchAsEvent(InputEvent& e, F&& func)
+    {
+        auto forward = [&e, &func](auto&& event) {
+            event.Handled = e.Handled;
+            func(event);
+            e.Handled = event.Handled;
+        };
+
+        switch (e.Type)
+        {
+            using enum EventType;
+            case KeyPressed:          forward(KeyPressedEvent(e.Key.Code, e.Key.IsRepeat)); break;
+            case KeyReleased:         forward(KeyReleasedEvent(e.Key.Code)); break;
+            case KeyTyped:            forward(KeyTypedEvent(e.Key.Code)); break;
+            case MouseButtonPressed:  forward(MouseButtonPressedEvent(e.MouseButton.Button)); break;
+            case MouseButtonReleased: forward(MouseButtonReleasedEvent(e.MouseButton.Button)); break;
+            case MouseMoved:          forward(MouseMovedEvent(e.MouseMove.X, e.MouseMove.Y)); break;
+            case MouseScrolled:       forward(MouseScrolledEvent(e.MouseScroll.XOffset, e.MouseScroll.YOffset)); break;
+            case ButtonPressed:
+                forward(ButtonPressEvent(e.ControllerButton.Controller, e.ControllerButton.Button));
+                break;
+            case ButtonReleased:
+                forward(ButtonReleaseEvent(e.ControllerButton.Controller, e.ControllerButton.Button));
+                break;
+            case AxisMoved:
+                forward(AxisMoveEvent(e.ControllerAxis.Controller, e.ControllerAxis.Axis, e.ControllerAxis.Value));
+                break;
+            case ControllerConnected:    forward(ControllerAddEvent(e.ControllerDevice.Controller)); break;
+            case ControllerDisconnected: forward(ControllerRemoveEvent(e.ControllerDevice.Controller)); break;
+            default: break;
+        }
+    }
+
+    /**
+     * @brief Converts a legacy input Event to its compact form.
+     * @param event The legacy event.
+     * @param out The converted event.
+     * @return True if the event is an input event and was converted, false otherwise.
+     */
+    inline bool ToInputEvent(const Event& event, InputEvent& out)
+    {
+        switch (event.GetEventType())
+        {
+            using enum EventType;
+            case KeyPressed:
+            {
+                const auto& e = static_cast<const KeyPressedEvent&>(event);
+                out = InputEvent::MakeKey(KeyPressed, 0, e.GetKeyCode(), e.IsRepeat());
+                break;
+            }
+            case KeyReleased:
+            case KeyTyped:
+                out = InputEvent::MakeKey(event.GetEventType(), 0, static_cast<const KeyEvent&>(event).GetKeyCode());
+                break;
+            case MouseButtonPressed:
+            case MouseButtonReleased:
+                out = InputEvent::MakeMouseButton(event.GetEventType(), 0,
+                                                  static_cast<const MouseButtonEvent&>(event).GetMouseButton());
+                break;
+            case MouseMoved:
+            {
+                const auto& e = static_cast<const MouseMovedEvent&>(event);
+                out = InputEvent::MakeMouseMove(0, e.GetX(), e.GetY(), 0.0f, 0.0f);
+                break;
+            }
+            case MouseScrolled:
+            {
+                const auto& e = static_cast<const MouseScrolledEvent&>(event);
+                out = InputEvent::MakeMouseScroll(0, e.GetXOffset(), e.GetYOffset());
+                break;
+            }
+            case ButtonPressed:
+            {
+                const auto& e = static_cast<const ButtonPressEvent&>(event);
+                out = InputEvent::MakeControllerButton(ButtonPressed, 0, e.Controller, e.Button);
+                break;
+            }
+            case ButtonReleased:
+            {
+                const auto& e = static_cast<const ButtonReleaseEvent&>(event);
+                out = InputEvent::MakeControllerButton(ButtonReleased, 0, e.Controller, e.Button);
+                break;
+            }
+            case AxisMoved:
+            {
+                const auto& e = static_cast<const AxisMoveEvent&>(event);
+                out = InputEvent::MakeControllerAxis(0, e.Controller, e.Axis, e.Value);
+                break;
+            }
+            case ControllerConnected:
+                out = InputEvent::MakeControllerDevice(ControllerConnected, 0,
+                                                       static_cast<const ControllerAddEvent&>(event).Controller);
+                break;
+            case ControllerDisconnected:
+                out = InputEvent::MakeControllerDevice(ControllerDisconnected, 0,
+                                                       static_cast<const ControllerRemoveEvent&>(event).Controller);
+                break;
+            default:
+                return false;
+        }
+
+        out.Handled = event.Handled;
+        return true;
+    }
+
+    /** @} */ // end of events group
+} // namespace Coffee
@@ -28,10 +28,11 @@ namespace Coffee {
     protected:
         /**
          * @brief Constructor for KeyEvent.
+         * @param type The type of the concrete event.
          * @param keycode The key code associated with the event.
          */
-        KeyEvent(const KeyCode keycode)
-            : m_KeyCode(keycode) {}
+        KeyEvent(EventType type, const KeyCode keycode)
+            : Event(type), m_KeyCode(keycode) {}
 
         KeyCode m_KeyCode;
     };
@@ -48,7 +49,7 @@ namespace Coffee {
          * @param isRepeat Whether the key press is a repeat.
          */
         KeyPressedEvent(const KeyCode keycode, bool isRepeat = false)
-            : KeyEvent(keycode), m_IsRepeat(isRepeat) {}
+            : KeyEvent(GetStaticType(), keycode), m_IsRepeat(isRepeat) {}
 
         /**
          * @brief Check if the key press is a repeat.
@@ -83,7 +84,7 @@ namespace Coffee {
          * @param keycode The key code associated with the event.
          */
         KeyReleasedEvent(const KeyCode keycode)
-            : KeyEvent(keycode) {}
+            : KeyEvent(GetStaticType(), keycode) {}
 
         /**
          * @brief Convert the event to a string representation.
@@ -110,7 +111,7 @@ namespace Coffee {
          * @param keycode The key code associated with the event.
          */
         KeyTypedEvent(const KeyCode keycode)
-            : KeyEvent(keycode) {}
+            : KeyEvent(GetStaticType(), keycode) {}
 
         /**
          * @brief Convert the event to a string representation.
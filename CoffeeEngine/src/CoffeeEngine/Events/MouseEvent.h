@@ -25,7 +25,7 @@ namespace Coffee {
          * @param y The y-coordinate of the mouse.
          */
         MouseMovedEvent(const float x, const float y)
-            : m_MouseX(x), m_MouseY(y) {}
+            : Event(GetStaticType()), m_MouseX(x), m_MouseY(y) {}
 
         /**
          * @brief Get the x-coordinate of the mouse.
@@ -69,7 +69,7 @@ namespace Coffee {
          * @param yOffset The scroll offset along the y-axis.
          */
         MouseScrolledEvent(const float xOffset, const float yOffset)
-            : m_XOffset(xOffset), m_YOffset(yOffset) {}
+            : Event(GetStaticType()), m_XOffset(xOffset), m_YOffset(yOffset) {}
 
         /**
          * @brief Get the scroll offset along the x-axis.
@@ -117,10 +117,11 @@ namespace Coffee {
     protected:
         /**
          * @brief Constructor for MouseButtonEvent.
+         * @param type The type of the concrete event.
          * @param button The mouse button associated with the event.
          */
-        MouseButtonEvent(const MouseCode button)
-            : m_Button(button) {}
+        MouseButtonEvent(EventType type, const MouseCode button)
+            : Event(type), m_Button(button) {}
 
         MouseCode m_Button;
     };
@@ -137,7 +138,7 @@ namespace Coffee {
          * @param button The mouse button associated with the event.
          */
         MouseButtonPressedEvent(const MouseCode button)
-            : MouseButtonEvent(button) {}
+            : MouseButtonEvent(GetStaticType(), button) {}
 
         /**
          * @brief Convert the event to a string representation.
@@ -165,7 +166,7 @@ namespace Coffee {
          * @param button The mouse button associated with the event.
          */
         MouseButtonReleasedEvent(const MouseCode button)
-            : MouseButtonEvent(button) {}
+            : MouseButtonEvent(GetStaticType(), button) {}
 
         /**
          * @brief Convert the event to a string representation.
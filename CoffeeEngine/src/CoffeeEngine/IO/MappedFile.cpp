@@ -0,0 +1,97 @@
+#include "MappedFile.h"
+
+#include "CoffeeEngine/Core/Log.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Coffee {
+
+#ifdef _WIN32
+
+    MappedFile::MappedFile(const std::filesystem::path& path)
+    {
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            COFFEE_CORE_ERROR("MappedFile: Could not open {0}", path.string());
+            return;
+        }
+        m_File = file;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+            return;
+
+        m_Mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_Mapping == nullptr)
+        {
+            COFFEE_CORE_ERROR("MappedFile: Could not map {0}", path.string());
+            return;
+        }
+
+        m_Data = static_cast<const std::byte*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+        if (m_Data != nullptr)
+            m_Size = static_cast<size_t>(size.QuadPart);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (m_Data != nullptr)
+            UnmapViewOfFile(m_Data);
+        if (m_Mapping != nullptr)
+            CloseHandle(m_Mapping);
+        if (m_File != nullptr)
+            CloseHandle(m_File);
+    }
+
+#else
+
+    MappedFile::MappedFile(const std::filesystem::path& path)
+    {
+        int file = open(path.c_str(), O_RDONLY);
+        if (file < 0)
+        {
+            COFFEE_CORE_ERROR("MappedFile: Could not open {0}", path.string());
+            return;
+        }
+
+        struct stat status;
+        if (fstat(file, &status) == 0 && status.st_size > 0)
+        {
+            void* data = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+            if (data != MAP_FAILED)
+            {
+                // The whole file is read front to back, let the kernel read ahead
+                madvise(data, status.st_size, MADV_SEQUENTIAL);
+                m_Data = static_cast<const std::byte*>(data);
+                m_Size = static_cast<size_t>(status.st_size);
+            }
+            else
+            {
+                COFFEE_CORE_ERROR("MappedFile: Could not map {0}", path.string());
+            }
+        }
+
+        // The mapping keeps its own reference to the file
+        close(file);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (m_Data != nullptr)
+            munmap(const_cast<std::byte*>(m_Data), m_Size);
+    }
+
+#endif
+
+}
@@ -0,0 +1,66 @@
+/**
+ * @defgroup io IO
+ * @brief IO components of the CoffeeEngine.
+ * @{
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+namespace Coffee {
+
+    /**
+     * @class MappedFile
+     * @brief Read-only memory mapping of a whole file.
+     *
+     * The pages are loaded by the OS on first access, so reading a large file does not copy it into a buffer first.
+     * The mapping is released when the object is destroyed.
+     */
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+
+        /**
+         * @brief Maps a file. Check IsOpen for the result.
+         * @param path The path of the file.
+         */
+        MappedFile(const std::filesystem::path& path);
+
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief Checks whether the file was mapped.
+         * @return True if the file is mapped, false if it could not be opened or is empty.
+         */
+        bool IsOpen() const { return m_Data != nullptr; }
+
+        /**
+         * @brief Gets the contents of the file.
+         * @return The first byte of the file. Page aligned.
+         */
+        const std::byte* GetData() const { return m_Data; }
+
+        /**
+         * @brief Gets the size of the file.
+         * @return The size in bytes.
+         */
+        size_t GetSize() const { return m_Size; }
+
+    private:
+        const std::byte* m_Data = nullptr;
+        size_t m_Size = 0;
+#ifdef _WIN32
+        void* m_File = nullptr;
+        void* m_Mapping = nullptr;
+#endif
+    };
+
+}
+
+/** @} */
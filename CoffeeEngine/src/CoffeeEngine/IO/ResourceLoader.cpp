@@ -1,6 +1,7 @@
 #include "ResourceLoader.h"
 #include "CoffeeEngine/Core/Base.h"
 #include "CoffeeEngine/Core/Log.h"
+#include "CoffeeEngine/Core/MemoryTracker.h"
 #include "CoffeeEngine/IO/CacheManager.h"
 #include "CoffeeEngine/IO/Resource.h"
 #include "CoffeeEngine/Renderer/Material.h"
@@ -21,6 +22,8 @@ namespace Coffee {
 
     void ResourceLoader::LoadFile(const std::filesystem::path& path)
     {
+        COFFEE_MEMORY_TAG(MemoryTag::Resources);
+
         if (!is_regular_file(path))
         {
             COFFEE_CORE_ERROR("ResourceLoader::LoadResources: {0} is not a file!", path.string());
@@ -80,6 +83,8 @@ namespace Coffee {
 
     void ResourceLoader::LoadDirectory(const std::filesystem::path& directory)
     {
+        COFFEE_MEMORY_TAG(MemoryTag::Resources);
+
         for (const auto& entry : std::filesystem::recursive_directory_iterator(directory))
         {
             // This two if statements are duplicated in LoadFile but are necessary to suppress errors
@@ -100,6 +105,8 @@ namespace Coffee {
 
     Ref<Texture2D> ResourceLoader::LoadTexture2D(const std::filesystem::path& path, bool srgb, bool cache)
     {
+        COFFEE_MEMORY_TAG(MemoryTag::Resources);
+
         if(GetResourceTypeFromExtension(path) != ResourceType::Texture2D)
         {
             COFFEE_CORE_ERROR("ResourceLoader::Load<Texture2D>: Resource is not a texture!");
@@ -122,6 +129,8 @@ namespace Coffee {
 
     Ref<Texture2D> ResourceLoader::LoadTexture2D(UUID uuid)
     {
+        COFFEE_MEMORY_TAG(MemoryTag::Resources);
+
         if(uuid == UUID::null)
             return nullptr;
 
@@ -138,6 +147,8 @@ namespace Coffee {
 
     Ref<Cubemap> ResourceLoader::LoadCubemap(const std::filesystem::path& path)
     {
+        COFFEE_MEMORY_TAG(MemoryTag::Resources);
+
         if(GetResourceTypeFromExtension(path) != ResourceType::Cubemap)
         {
             COFFEE_CORE_ERROR("ResourceLoader::Load<Cubemap>: Resource is not a cubemap!");
@@ -165,6 +176,8 @@ namespace Coffee {
 
     Ref<Model> ResourceLoader::LoadModel(const std::filesystem::path& path, bool cache)
     {
+        COFFEE_MEMORY_TAG(MemoryTag::Resources);
+
         if(GetResourceTypeFromExtension(path) != ResourceType::Model)
         {
             COFFEE_CORE_ERROR("ResourceLoader::Load<Model>: Resource is not a model!");
@@ -187,6 +200,8 @@ namespace Coffee {
 
     Ref<Mesh> ResourceLoader::LoadMesh(const std::string& name, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, Ref<Material>& material, const AABB& aabb)
     {
+        COFFEE_MEMORY_TAG(MemoryTag::Resources);
+
         if(ResourceRegistry::Exists(name))
         {
             return ResourceRegistry::Get<Mesh>(name);
@@ -203,6 +218,8 @@ namespace Coffee {
 
     Ref<Mesh> ResourceLoader::LoadMesh(UUID uuid)
     {
+        COFFEE_MEMORY_TAG(MemoryTag::Resources);
+
         if(ResourceRegistry::Exists(uuid))
         {
             return ResourceRegistry::Get<Mesh>(uuid);
@@ -216,6 +233,8 @@ namespace Coffee {
 
     Ref<Shader> ResourceLoader::LoadShader(const std::filesystem::path& shaderPath)
     {
+        COFFEE_MEMORY_TAG(MemoryTag::Resources);
+
         if(GetResourceTypeFromExtension(shaderPath) != ResourceType::Shader)
         {
             COFFEE_CORE_ERROR("ResourceLoader::Load<Shader>: Resource is not a shader!");
@@ -239,6 +258,8 @@ namespace Coffee {
 
     Ref<Material> ResourceLoader::LoadMaterial(const std::string& name)
     {
+        COFFEE_MEMORY_TAG(MemoryTag::Resources);
+
         std::string materialName = name;
 
         UUID uuid;
@@ -262,6 +283,8 @@ namespace Coffee {
 
     Ref<Material> ResourceLoader::LoadMaterial(const std::string& name, MaterialTextures& materialTextures)
     {
+        COFFEE_MEMORY_TAG(MemoryTag::Resources);
+
         std::string materialName = name;
 
         UUID uuid;
@@ -284,6 +307,8 @@ namespace Coffee {
     
     Ref<Material> ResourceLoader::LoadMaterial(UUID uuid)
     {
+        COFFEE_MEMORY_TAG(MemoryTag::Resources);
+
         if(ResourceRegistry::Exists(uuid))
         {
             return ResourceRegistry::Get<Material>(uuid);
@@ -3,7 +3,7 @@
 
 namespace Coffee {
 
-    std::unordered_map<UUID, Ref<Resource>> ResourceRegistry::m_Resources;
+    FlatHashMap<UUID, Ref<Resource>> ResourceRegistry::m_Resources;
     std::unordered_map<std::string, UUID> ResourceRegistry::m_NameToUUID;
 
 } // namespace Coffee
\ No newline at end of file
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "CoffeeEngine/Core/Base.h"
+#include "CoffeeEngine/Core/DataStructures/FlatHashMap.h"
 #include "CoffeeEngine/Core/UUID.h"
 #include "CoffeeEngine/IO/Resource.h"
 #include <unordered_map>
@@ -44,12 +45,13 @@ namespace Coffee {
         template<typename T>
         static Ref<T> Get(UUID uuid)
         {
-            if (!Exists(uuid))
+            auto it = m_Resources.find(uuid);
+            if (it == m_Resources.end())
             {
                 COFFEE_CORE_ERROR("Resource {0} not found!", (uint64_t)uuid);
                 return nullptr;
             }
-            return std::static_pointer_cast<T>(m_Resources[uuid]);
+            return std::static_pointer_cast<T>(it->second);
         }
 
         /**
@@ -73,7 +75,7 @@ namespace Coffee {
          * @param name The name of the resource.
          * @return True if the resource exists, false otherwise.
          */
-        static bool Exists(UUID uuid) { return m_Resources.find(uuid) != m_Resources.end(); }
+        static bool Exists(UUID uuid) { return m_Resources.contains(uuid); }
 
         /**
          * @brief Checks if a resource exists in the registry.
@@ -84,10 +86,11 @@ namespace Coffee {
 
         static void Remove(UUID uuid)
         {
-            if (Exists(uuid))
+            auto it = m_Resources.find(uuid);
+            if (it != m_Resources.end())
             {
-                m_NameToUUID.erase(m_Resources[uuid]->GetName());
-                m_Resources.erase(uuid);
+                m_NameToUUID.erase(it->second->GetName());
+                m_Resources.erase(it);
             }
         }
 
@@ -106,10 +109,10 @@ namespace Coffee {
          * @brief Gets the entire resource registry.
          * @return A constant reference to the resource registry.
          */
-        static const std::unordered_map<UUID, Ref<Resource>>& GetResourceRegistry() { return m_Resources; }
+        static const FlatHashMap<UUID, Ref<Resource>>& GetResourceRegistry() { return m_Resources; }
 
     private:
-        static std::unordered_map<UUID, Ref<Resource>> m_Resources; ///< The resource registry.
+        static FlatHashMap<UUID, Ref<Resource>> m_Resources; ///< The resource registry.
         static std::unordered_map<std::string, UUID> m_NameToUUID; ///< The mapping of resource names to UUIDs.
     };
 
@@ -2,6 +2,7 @@
 
 #include "CoffeeEngine/Core/Application.h"
 #include "CoffeeEngine/Core/Window.h"
+#include "CoffeeEngine/Renderer/RendererAPI.h"
 #include "SDL3/SDL_video.h"
 
 #include <imgui.h>
@@ -14,7 +15,9 @@
 
 #include <IconsLucide.h>
 
-#include <tracy/Tracy.hpp>
+#include "CoffeeEngine/Core/FrameProfiler.h"
+
+#include <algorithm>
 
 namespace Coffee {
 
@@ -58,16 +61,39 @@ namespace Coffee {
         Application& app = Application::Get();
         SDL_Window* window = static_cast<SDL_Window*>(app.GetWindow().GetNativeWindow());
 
-        ImGui_ImplSDL3_InitForOpenGL(window, SDL_GL_GetCurrentContext());
-        ImGui_ImplOpenGL3_Init("#version 410");
+        // Without a GL context there is nothing for the backends to draw with; the panels are still built every
+        // frame, so their cost shows up in headless runs too.
+        m_Headless = RendererAPI::GetAPI() == RendererAPI::API::Null;
+        if (m_Headless)
+        {
+            io.Fonts->Build();
+        }
+        else
+        {
+            ImGui_ImplSDL3_InitForOpenGL(window, SDL_GL_GetCurrentContext());
+            ImGui_ImplOpenGL3_Init("#version 410");
+        }
+
+        m_EventSubscription = app.GetEventBus().SubscribeCategory(
+            EventCategoryMouse | EventCategoryKeyboard,
+            [this](Event& e) {
+                OnEvent(e);
+                return e.Handled;
+            },
+            EventPriority::Overlay);
     }
 
     void ImGuiLayer::OnDetach()
     {
         ZoneScoped;
 
-        ImGui:ImGui_ImplOpenGL3_Shutdown();
-        ImGui_ImplSDL3_Shutdown();
+        Application::Get().GetEventBus().Unsubscribe(m_EventSubscription);
+
+        if (!m_Headless)
+        {
+            ImGui_ImplOpenGL3_Shutdown();
+            ImGui_ImplSDL3_Shutdown();
+        }
         ImGui::DestroyContext();
     }
 
@@ -85,8 +111,19 @@ namespace Coffee {
 	{
         ZoneScoped;
 
-		ImGui_ImplOpenGL3_NewFrame();
-		ImGui_ImplSDL3_NewFrame();
+        if (m_Headless)
+        {
+            ImGuiIO& io = ImGui::GetIO();
+            Application& app = Application::Get();
+            const float fixedDeltaTime = Application::GetSettings().FixedDeltaTime;
+            io.DisplaySize = ImVec2((float)app.GetWindow().GetWidth(), (float)app.GetWindow().GetHeight());
+            io.DeltaTime = fixedDeltaTime > 0.0f ? fixedDeltaTime : std::max(app.GetFrameTime() / 1000.0f, 0.0001f);
+        }
+        else
+        {
+            ImGui_ImplOpenGL3_NewFrame();
+            ImGui_ImplSDL3_NewFrame();
+        }
 		ImGui::NewFrame();
 	}
 
@@ -100,7 +137,8 @@ namespace Coffee {
 
 		// Rendering
 		ImGui::Render();
-		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+		if (!m_Headless)
+			ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
       	/* if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) //Comment this for disable the detached imgui windows from the main window
 		{
@@ -120,7 +158,8 @@ namespace Coffee {
 
 	void ImGuiLayer::ProcessEvents(const SDL_Event& event)
 	{
-		ImGui_ImplSDL3_ProcessEvent(&event);
+		if (!m_Headless)
+			ImGui_ImplSDL3_ProcessEvent(&event);
 	}
 
 	void ImGuiLayer::SetTeaColorStyle()
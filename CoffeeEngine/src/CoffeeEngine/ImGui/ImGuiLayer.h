@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CoffeeEngine/Core/Layer.h"
+#include "CoffeeEngine/Events/EventBus.h"
 #include <SDL3/SDL_events.h>
 
 namespace Coffee {
@@ -38,7 +39,7 @@ namespace Coffee {
         void OnDetach() override;
 
         /**
-         * @brief Handles events for the ImGui layer.
+         * @brief Handles events for the ImGui layer. Subscribed to mouse and keyboard events with overlay priority.
          * @param e The event to handle.
          */
         void OnEvent(Event& e) override;
@@ -83,6 +84,8 @@ namespace Coffee {
 
       private:
         bool m_BlockEvents = true; ///< Indicates whether events are blocked.
+        EventBus::SubscriptionID m_EventSubscription = 0; ///< The subscription to mouse and keyboard events.
+        bool m_Headless = false; ///< Builds the UI every frame but has no platform or renderer backend to draw it.
     };
 
     /** @} */
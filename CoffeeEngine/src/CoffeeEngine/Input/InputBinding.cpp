@@ -4,6 +4,12 @@
 
 namespace Coffee {
 
+    InputBinding::InputBinding(const CompiledBinding& compiled, const std::string& name)
+        : Name(name), KeyPos(compiled.KeyPos), KeyNeg(compiled.KeyNeg), ButtonPos(compiled.ButtonPos),
+          ButtonNeg(compiled.ButtonNeg), Axis(compiled.Axis), IsAnalog(compiled.IsAnalog)
+    {
+    }
+
     float InputBinding::GetValue(ControllerCode controller) const // ASK about the unused controller parameter
     {
         if (IsAnalog && Axis != Axis::Invalid)
@@ -20,4 +26,9 @@ namespace Coffee {
         return value;
     }
 
+    CompiledBinding InputBinding::Compile() const
+    {
+        return CompiledBinding{KeyPos, KeyNeg, ButtonPos, ButtonNeg, Axis, IsAnalog};
+    }
+
 }
@@ -1,12 +1,66 @@
 #pragma once
 
+#include "CoffeeEngine/Core/Base.h"
 #include "CoffeeEngine/Core/ControllerCodes.h"
 #include "CoffeeEngine/Core/KeyCodes.h"
 
+#include <cereal/cereal.hpp>
+#include <cereal/types/string.hpp>
 #include <string>
 
 namespace Coffee
 {
+	// TODO Change for better action map layers method?
+	/**
+	 * @brief Current action context. Each key/button can only be in one InputAction per context layer
+	 */
+	enum class InputLayer : int
+	{
+		None = 0,
+		Gameplay = BIT(1),
+		Menu = BIT(2)
+	};
+
+    /**
+     * @brief List of possible actions in ActionMap v0.1
+     */
+    enum class InputAction
+    {
+        // UI
+    	Up,
+    	Down,
+    	Left,
+    	Right,
+        Confirm,
+        Cancel,
+
+        // Gameplay
+    	MoveHorizontal,
+		MoveVertical,
+        Attack,
+        Ability,
+        Pause,
+
+        // Action count for array creation and iteration
+        ActionCount
+    };
+
+    /**
+     * @brief Trivially copyable form of an InputBinding as stored in the compiled action table.
+     *
+     * Profiles are read from disk straight into arrays of this struct, so its layout is part of the
+     * binding profile file format. Bump InputProfile::Version when changing it.
+     */
+    struct CompiledBinding
+    {
+        KeyCode KeyPos = Key::Unknown;
+        KeyCode KeyNeg = Key::Unknown;
+        ButtonCode ButtonPos = Button::Invalid;
+        ButtonCode ButtonNeg = Button::Invalid;
+        AxisCode Axis = Axis::Invalid;
+        bool IsAnalog = false;
+    };
+
     class InputBinding
     {
       public:
@@ -20,6 +74,15 @@ namespace Coffee
         AxisCode Axis = Axis::Invalid;
         bool IsAnalog = false;
 
+        InputBinding() = default;
+
+        /**
+         * @brief Builds an editable binding from its compiled form.
+         * @param compiled The compiled binding.
+         * @param name The display name of the binding.
+         */
+        InputBinding(const CompiledBinding& compiled, const std::string& name = "Undefined");
+
         /**
          * @brief Retrieves an input value based on whether it's analog or digital.
          *
@@ -27,5 +90,24 @@ namespace Coffee
          */
         float GetValue(ControllerCode controller) const;
 
+        /**
+         * @brief Converts the binding to the compact form used by the action table.
+         * @return The compiled binding.
+         */
+        CompiledBinding Compile() const;
+
+        /**
+         * @brief Serializes the InputBinding.
+         * @tparam Archive The type of the archive.
+         * @param archive The archive to serialize to.
+         */
+        template<class Archive>
+        void serialize(Archive& archive)
+        {
+            archive(cereal::make_nvp("Name", Name), cereal::make_nvp("KeyPos", KeyPos),
+                    cereal::make_nvp("KeyNeg", KeyNeg), cereal::make_nvp("ButtonPos", ButtonPos),
+                    cereal::make_nvp("ButtonNeg", ButtonNeg), cereal::make_nvp("Axis", Axis),
+                    cereal::make_nvp("IsAnalog", IsAnalog));
+        }
     };
 } // namespace Coffee
@@ -0,0 +1,69 @@
+#include "CoffeeEngine/Input/InputEventCoalescer.h"
+
+namespace Coffee {
+
+    static bool IsContinuous(EventType type)
+    {
+        return type == EventType::MouseMoved || type == EventType::MouseScrolled || type == EventType::AxisMoved;
+    }
+
+    static bool IsSameSource(const InputEvent& a, const InputEvent& b)
+    {
+        if (a.Type != b.Type)
+            return false;
+
+        if (a.Type == EventType::AxisMoved)
+        {
+            return a.ControllerAxis.Controller == b.ControllerAxis.Controller &&
+                   a.ControllerAxis.Axis == b.ControllerAxis.Axis;
+        }
+
+        // SDL reports all mice as a single pointer, so there is one source per type.
+        return true;
+    }
+
+    void InputEventCoalescer::Push(const InputEvent& e)
+    {
+        m_ReceivedCount++;
+
+        if (!IsContinuous(e.Type))
+        {
+            m_Events.push_back(e);
+            m_RunStart = m_Events.size();
+            return;
+        }
+
+        // A run only holds one pending event per source, so this scan is short.
+        for (size_t i = m_RunStart; i < m_Events.size(); i++)
+        {
+            InputEvent& pending = m_Events[i];
+            if (!IsSameSource(pending, e))
+                continue;
+
+            switch (e.Type)
+            {
+                case EventType::MouseMoved:
+                    pending.MouseMove.X = e.MouseMove.X;
+                    pending.MouseMove.Y = e.MouseMove.Y;
+                    pending.MouseMove.DeltaX += e.MouseMove.DeltaX;
+                    pending.MouseMove.DeltaY += e.MouseMove.DeltaY;
+                    break;
+                case EventType::MouseScrolled:
+                    pending.MouseScroll.XOffset += e.MouseScroll.XOffset;
+                    pending.MouseScroll.YOffset += e.MouseScroll.YOffset;
+                    break;
+                case EventType::AxisMoved:
+                    pending.ControllerAxis.Value = e.ControllerAxis.Value;
+                    break;
+                default:
+                    break;
+            }
+
+            pending.Timestamp = e.Timestamp;
+            return;
+        }
+
+        m_Events.push_back(e);
+    }
+
+} // namespace Coffee
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoffeeEngine/Events/InputEvent.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Coffee {
+
+    /**
+     * @defgroup core Core
+     * @{
+     */
+
+    /**
+     * @brief Collects the input events of a frame and merges redundant continuous events before dispatch.
+     *
+     * Continuous events are merged per device: mouse motion keeps the last absolute position and sums the
+     * deltas, scrolling sums the offsets and each gamepad axis keeps its final value. Discrete events
+     * (presses, releases, connections) are never merged and act as barriers: continuous events are only
+     * merged with events after the last discrete one, so every discrete event still sees the state that
+     * preceded it and the relative order and timestamps of discrete events are preserved.
+     */
+    class InputEventCoalescer
+    {
+      public:
+        /**
+         * @brief Queues an event, merging it into a pending event of the same device if possible.
+         * @param e The event to queue.
+         */
+        void Push(const InputEvent& e);
+
+        /**
+         * @brief Calls a function for every pending event in order and clears the queue.
+         * @tparam F The function type, taking an InputEvent&.
+         * @param func The function to call.
+         */
+        template<typename F>
+        void Flush(F&& func)
+        {
+            for (InputEvent& e : m_Events)
+                func(e);
+
+            m_ReceivedCount = 0;
+            m_Events.clear();
+            m_RunStart = 0;
+        }
+
+        /**
+         * @brief Gets the number of events received since the last flush.
+         * @return The number of events pushed.
+         */
+        uint32_t GetReceivedCount() const { return m_ReceivedCount; }
+
+        /**
+         * @brief Gets the number of events that will be dispatched on the next flush.
+         * @return The number of pending events after merging.
+         */
+        uint32_t GetPendingCount() const { return static_cast<uint32_t>(m_Events.size()); }
+
+      private:
+        std::vector<InputEvent> m_Events; ///< The pending events. Keeps its capacity between frames.
+        size_t m_RunStart = 0; ///< The first event after the last discrete event.
+        uint32_t m_ReceivedCount = 0; ///< The number of events pushed since the last flush.
+    };
+
+    /** @} */
+} // namespace Coffee
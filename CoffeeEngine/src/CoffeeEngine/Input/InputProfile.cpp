@@ -0,0 +1,232 @@
+#include "CoffeeEngine/Input/InputProfile.h"
+
+#include "CoffeeEngine/Core/Log.h"
+#include "CoffeeEngine/IO/CacheManager.h"
+
+#include <algorithm>
+#include <cereal/archives/binary.hpp>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace Coffee {
+
+    static_assert(std::is_trivially_copyable_v<CompiledBinding>, "CompiledBinding is read from disk as raw bytes");
+    static_assert(std::is_trivially_copyable_v<DeviceBindingOverride>, "DeviceBindingOverride is read from disk as raw bytes");
+
+    static bool GuidEquals(const SDL_GUID& a, const SDL_GUID& b)
+    {
+        return std::memcmp(a.data, b.data, sizeof(a.data)) == 0;
+    }
+
+    InputProfile::~InputProfile()
+    {
+        StopWatching();
+    }
+
+    std::filesystem::path InputProfile::GetCachedProfilePath(const std::string& name)
+    {
+        return CacheManager::GetCachedFilePath("InputProfile_" + name);
+    }
+
+    bool InputProfile::Save(const std::filesystem::path& path) const
+    {
+        std::ofstream file{path, std::ios::binary};
+        if (!file)
+        {
+            COFFEE_CORE_ERROR("InputProfile::Save: Could not open {0} for writing!", path.string());
+            return false;
+        }
+
+        try
+        {
+            cereal::BinaryOutputArchive archive(file);
+
+            uint32_t overrideCount = static_cast<uint32_t>(m_Overrides.size());
+            archive(Magic, Version, overrideCount);
+            archive(cereal::binary_data(m_Bindings.data(), sizeof(ActionTable)));
+            archive(cereal::binary_data(m_Overrides.data(), overrideCount * sizeof(DeviceBindingOverride)));
+        }
+        catch (const cereal::Exception& e)
+        {
+            COFFEE_CORE_ERROR("InputProfile::Save: Could not write {0}: {1}", path.string(), e.what());
+            return false;
+        }
+
+        if (!file.flush())
+        {
+            COFFEE_CORE_ERROR("InputProfile::Save: Could not write {0}", path.string());
+            return false;
+        }
+        return true;
+    }
+
+    bool InputProfile::Load(const std::filesystem::path& path)
+    {
+        std::ifstream file{path, std::ios::binary};
+        if (!file)
+        {
+            COFFEE_CORE_ERROR("InputProfile::Load: Could not open {0}!", path.string());
+            return false;
+        }
+
+        // Read into locals first so a truncated or stale file never leaves a half-written table behind.
+        ActionTable bindings;
+        std::vector<DeviceBindingOverride> overrides;
+
+        try
+        {
+            cereal::BinaryInputArchive archive(file);
+
+            uint32_t magic = 0, version = 0, overrideCount = 0;
+            archive(magic, version, overrideCount);
+
+            if (magic != Magic || version != Version)
+            {
+                COFFEE_CORE_WARN("InputProfile::Load: {0} has an unsupported format (version {1}), ignoring it", path.string(), version);
+                return false;
+            }
+
+            // The count comes straight from the file, so check it against what is actually left before allocating.
+            const std::streamoff headerEnd = file.tellg();
+            file.seekg(0, std::ios::end);
+            const std::streamoff fileEnd = file.tellg();
+            file.seekg(headerEnd);
+
+            const uint64_t remaining = headerEnd >= 0 && fileEnd >= headerEnd ? static_cast<uint64_t>(fileEnd - headerEnd) : 0;
+            if (remaining < sizeof(ActionTable) ||
+                overrideCount > (remaining - sizeof(ActionTable)) / sizeof(DeviceBindingOverride))
+            {
+                COFFEE_CORE_ERROR("InputProfile::Load: {0} is corrupted: {1} device overrides do not fit in the file", path.string(), overrideCount);
+                return false;
+            }
+
+            overrides.resize(overrideCount);
+            archive(cereal::binary_data(bindings.data(), sizeof(ActionTable)));
+            archive(cereal::binary_data(overrides.data(), overrideCount * sizeof(DeviceBindingOverride)));
+        }
+        catch (const cereal::Exception& e)
+        {
+            COFFEE_CORE_ERROR("InputProfile::Load: {0} is corrupted: {1}", path.string(), e.what());
+            return false;
+        }
+
+        m_Bindings = bindings;
+        m_Overrides = std::move(overrides);
+        return true;
+    }
+
+    bool InputProfile::Watch(const std::filesystem::path& path)
+    {
+#ifdef __linux__
+        StopWatching();
+
+        m_WatchHandle = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_WatchHandle < 0)
+        {
+            COFFEE_CORE_ERROR("InputProfile::Watch: Could not initialize inotify!");
+            return false;
+        }
+
+        // Watch the directory instead of the file: saving usually replaces the file, which drops file watches.
+        std::filesystem::path directory = path.has_parent_path() ? path.parent_path() : std::filesystem::path(".");
+        if (inotify_add_watch(m_WatchHandle, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+        {
+            COFFEE_CORE_ERROR("InputProfile::Watch: Could not watch {0}!", directory.string());
+            StopWatching();
+            return false;
+        }
+
+        m_WatchedPath = path;
+        return true;
+#else
+        COFFEE_CORE_WARN("InputProfile::Watch: Hot reload is not supported on this platform");
+        return false;
+#endif
+    }
+
+    void InputProfile::StopWatching()
+    {
+#ifdef __linux__
+        if (m_WatchHandle >= 0)
+        {
+            close(m_WatchHandle);
+        }
+#endif
+        m_WatchHandle = -1;
+        m_WatchedPath.clear();
+    }
+
+    bool InputProfile::PollChanges()
+    {
+#ifdef __linux__
+        if (m_WatchHandle < 0)
+            return false;
+
+        alignas(inotify_event) char buffer[4096];
+        const std::string filename = m_WatchedPath.filename().string();
+        bool changed = false;
+
+        ssize_t length;
+        while ((length = read(m_WatchHandle, buffer, sizeof(buffer))) > 0)
+        {
+            for (char* ptr = buffer; ptr < buffer + length;)
+            {
+                const auto* event = reinterpret_cast<const inotify_event*>(ptr);
+                if (event->len > 0 && filename == event->name)
+                {
+                    changed = true;
+                }
+                ptr += sizeof(inotify_event) + event->len;
+            }
+        }
+
+        if (changed && Load(m_WatchedPath))
+        {
+            COFFEE_CORE_INFO("InputProfile: Reloaded {0}", m_WatchedPath.string());
+            return true;
+        }
+#endif
+        return false;
+    }
+
+    const ActionTable& InputProfile::GetBindings(const SDL_GUID& guid) const
+    {
+        for (const auto& deviceOverride : m_Overrides)
+        {
+            if (GuidEquals(deviceOverride.Guid, guid))
+                return deviceOverride.Bindings;
+        }
+        return m_Bindings;
+    }
+
+    void InputProfile::SetBinding(InputAction action, const CompiledBinding& binding)
+    {
+        m_Bindings[static_cast<size_t>(action)] = binding;
+    }
+
+    void InputProfile::SetDeviceBinding(const SDL_GUID& guid, InputAction action, const CompiledBinding& binding)
+    {
+        auto it = std::find_if(m_Overrides.begin(), m_Overrides.end(), [&guid](const DeviceBindingOverride& o) {
+            return GuidEquals(o.Guid, guid);
+        });
+
+        if (it == m_Overrides.end())
+        {
+            it = m_Overrides.insert(m_Overrides.end(), DeviceBindingOverride{guid, m_Bindings});
+        }
+
+        it->Bindings[static_cast<size_t>(action)] = binding;
+    }
+
+    void InputProfile::ClearDeviceOverride(const SDL_GUID& guid)
+    {
+        std::erase_if(m_Overrides, [&guid](const DeviceBindingOverride& o) { return GuidEquals(o.Guid, guid); });
+    }
+
+} // namespace Coffee
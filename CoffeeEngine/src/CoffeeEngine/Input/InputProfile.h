@@ -0,0 +1,140 @@
+#pragma once
+
+#include "CoffeeEngine/Input/InputBinding.h"
+
+#include <SDL3/SDL_guid.h>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Coffee {
+
+    /**
+     * @defgroup core Core
+     * @{
+     */
+
+    /**
+     * @brief One compiled binding per InputAction, indexed by the action value.
+     */
+    using ActionTable = std::array<CompiledBinding, static_cast<size_t>(InputAction::ActionCount)>;
+
+    /**
+     * @brief Action table that replaces the default one for a specific device.
+     */
+    struct DeviceBindingOverride
+    {
+        SDL_GUID Guid; ///< The SDL GUID of the device.
+        ActionTable Bindings; ///< The bindings used when the input comes from this device.
+    };
+
+    /**
+     * @brief A set of input bindings with optional per-device overrides.
+     *
+     * Profiles are stored in binary form under the CacheManager cache path. The action tables are written
+     * as raw blocks, so loading is a bulk read straight into the compiled table with no parsing step.
+     * On Linux the profile file can be watched with inotify and is recompiled in place when it changes;
+     * input state (pressed buttons, axis values) lives in Input and is not touched by a reload.
+     */
+    class InputProfile
+    {
+    public:
+        static constexpr uint32_t Magic = 0x50494643; ///< "CFIP" in little endian.
+        static constexpr uint32_t Version = 1; ///< Bumped whenever CompiledBinding or the file layout changes.
+
+        InputProfile() = default;
+        ~InputProfile();
+
+        InputProfile(const InputProfile&) = delete;
+        InputProfile& operator=(const InputProfile&) = delete;
+
+        /**
+         * @brief Gets the cache file path for a profile name.
+         * @param name The name of the profile.
+         * @return The path of the binary profile inside the cache directory.
+         */
+        static std::filesystem::path GetCachedProfilePath(const std::string& name);
+
+        /**
+         * @brief Saves the profile in binary form.
+         * @param path The file to write.
+         * @return True if the profile was written, false otherwise.
+         */
+        bool Save(const std::filesystem::path& path) const;
+
+        /**
+         * @brief Loads a binary profile, replacing the current tables.
+         *
+         * The current tables are kept if the file is missing or invalid.
+         *
+         * @param path The file to read.
+         * @return True if the profile was loaded, false otherwise.
+         */
+        bool Load(const std::filesystem::path& path);
+
+        /**
+         * @brief Starts watching a profile file and reloads it when it changes on disk.
+         * @param path The profile file to watch.
+         * @return True if the watch was set up, false otherwise (or on platforms without support).
+         */
+        bool Watch(const std::filesystem::path& path);
+
+        /**
+         * @brief Stops watching the profile file.
+         */
+        void StopWatching();
+
+        /**
+         * @brief Checks for pending file changes and reloads the profile if needed. Never blocks.
+         * @return True if the profile was reloaded, false otherwise.
+         */
+        bool PollChanges();
+
+        /**
+         * @brief Gets the action table for a device, falling back to the default table.
+         * @param guid The GUID of the device.
+         * @return The action table to use for this device.
+         */
+        const ActionTable& GetBindings(const SDL_GUID& guid) const;
+
+        /**
+         * @brief Gets the default action table.
+         * @return The default action table.
+         */
+        const ActionTable& GetBindings() const { return m_Bindings; }
+
+        /**
+         * @brief Sets a binding in the default action table.
+         * @param action The action to bind.
+         * @param binding The binding to use.
+         */
+        void SetBinding(InputAction action, const CompiledBinding& binding);
+
+        /**
+         * @brief Sets a binding for a specific device. The override starts as a copy of the default table.
+         * @param guid The GUID of the device.
+         * @param action The action to bind.
+         * @param binding The binding to use.
+         */
+        void SetDeviceBinding(const SDL_GUID& guid, InputAction action, const CompiledBinding& binding);
+
+        /**
+         * @brief Removes the override of a device.
+         * @param guid The GUID of the device.
+         */
+        void ClearDeviceOverride(const SDL_GUID& guid);
+
+        const std::vector<DeviceBindingOverride>& GetDeviceOverrides() const { return m_Overrides; }
+
+    private:
+        ActionTable m_Bindings{}; ///< The default action table.
+        std::vector<DeviceBindingOverride> m_Overrides; ///< The per-device action tables.
+
+        std::filesystem::path m_WatchedPath; ///< The file being watched for hot reload.
+        int m_WatchHandle = -1; ///< The inotify descriptor, -1 when not watching.
+    };
+
+    /** @} */
+} // namespace Coffee
@@ -1,7 +1,8 @@
 #include "CoffeeEngine/Renderer/Buffer.h"
 
+#include "CoffeeEngine/Core/FrameProfiler.h"
+
 #include <glad/glad.h>
-#include <tracy/Tracy.hpp>
 
 namespace Coffee {
 
@@ -12,6 +13,7 @@ namespace Coffee {
         glGenBuffers(1, &m_vboID);
         glBindBuffer(GL_ARRAY_BUFFER, m_vboID);
         glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+        m_GPUMemory.Set(size);
     }
 
     VertexBuffer::VertexBuffer(float* vertices, uint32_t size)
@@ -21,6 +23,7 @@ namespace Coffee {
         glGenBuffers(1, &m_vboID);
         glBindBuffer(GL_ARRAY_BUFFER, m_vboID);
         glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+        m_GPUMemory.Set(size);
     }
 
     VertexBuffer::~VertexBuffer()
@@ -67,6 +70,7 @@ namespace Coffee {
         glGenBuffers(1, &m_eboID);
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_eboID);
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+        m_GPUMemory.Set(count * sizeof(uint32_t));
     }
 
     IndexBuffer::~IndexBuffer()
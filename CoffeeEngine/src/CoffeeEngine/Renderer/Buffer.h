@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CoffeeEngine/Core/Base.h"
+#include "CoffeeEngine/Core/MemoryTracker.h"
 #include <cstdint>
 
 namespace Coffee {
@@ -243,6 +244,7 @@ namespace Coffee {
     private:
         uint32_t m_vboID; ///< The ID of the vertex buffer object.
         BufferLayout m_Layout; ///< The layout of the vertex buffer.
+        GPUMemory m_GPUMemory; ///< The size of the buffer storage.
     };
 
     /**
@@ -290,6 +292,7 @@ namespace Coffee {
     private:
         uint32_t m_eboID; ///< The ID of the element buffer object.
         uint32_t m_Count; ///< The number of indices in the buffer.
+        GPUMemory m_GPUMemory; ///< The size of the buffer storage.
     };
 
     /** @} */
@@ -1,10 +1,11 @@
 #include "Framebuffer.h"
 #include "CoffeeEngine/Core/Base.h"
+#include "CoffeeEngine/Core/FrameProfiler.h"
+#include "CoffeeEngine/Core/MemoryTracker.h"
 #include "CoffeeEngine/Renderer/Texture.h"
 
 #include <cstdint>
 #include <glad/glad.h>
-#include <tracy/Tracy.hpp>
 
 #include <glm/vec4.hpp>
 
@@ -16,6 +17,7 @@ namespace Coffee {
         : m_Width(width), m_Height(height), m_Attachments(attachments)
     {
         ZoneScoped;
+        COFFEE_MEMORY_TAG(MemoryTag::Renderer);
 
         glCreateFramebuffers(1, &m_fboID);
 
@@ -30,6 +32,7 @@ namespace Coffee {
     void Framebuffer::Resize(uint32_t width, uint32_t height)
     {
         ZoneScoped;
+        COFFEE_MEMORY_TAG(MemoryTag::Renderer);
 
         if(width == 0 || height == 0 || width > s_MaxFramebufferSize || height > s_MaxFramebufferSize)
         {
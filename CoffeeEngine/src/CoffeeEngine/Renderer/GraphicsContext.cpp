@@ -1,9 +1,11 @@
 #include "CoffeeEngine/Renderer/GraphicsContext.h"
+#include "CoffeeEngine/Core/FrameProfiler.h"
+#include "CoffeeEngine/Renderer/NullGL.h"
+#include "CoffeeEngine/Renderer/RendererAPI.h"
 #include "SDL3/SDL.h"
 #include "SDL3/SDL_video.h"
 
 #include <glad/glad.h>
-#include <tracy/Tracy.hpp>
 
 namespace Coffee {
 
@@ -20,9 +22,18 @@ namespace Coffee {
     {
         ZoneScoped;
 
-        m_Context = SDL_GL_CreateContext(m_WindowHandle);
-        SDL_GL_MakeCurrent(m_WindowHandle, m_Context);
-        int status = gladLoadGLLoader((GLADloadproc)SDL_GL_GetProcAddress);
+        int status;
+        if (RendererAPI::GetAPI() == RendererAPI::API::Null)
+        {
+            m_Context = nullptr;
+            status = NullGL::Load();
+        }
+        else
+        {
+            m_Context = SDL_GL_CreateContext(m_WindowHandle);
+            SDL_GL_MakeCurrent(m_WindowHandle, m_Context);
+            status = gladLoadGLLoader((GLADloadproc)SDL_GL_GetProcAddress);
+        }
 		COFFEE_CORE_ASSERT(status, "Failed to initialize Glad!");
 
         COFFEE_CORE_INFO("OpenGL Info:");
@@ -37,14 +48,16 @@ namespace Coffee {
     {
         ZoneScoped;
 
-        SDL_GL_DestroyContext(m_Context);
+        if (m_Context)
+            SDL_GL_DestroyContext(m_Context);
     }
 
     void GraphicsContext::SwapBuffers()
     {
         ZoneScoped;
 
-        SDL_GL_SwapWindow(m_WindowHandle);
+        if (m_Context)
+            SDL_GL_SwapWindow(m_WindowHandle);
 
         FrameMark;
     }
@@ -53,7 +66,7 @@ namespace Coffee {
     {
         ZoneScoped;
 
-        return SDL_GL_SetSwapInterval(interval);
+        return m_Context ? SDL_GL_SetSwapInterval(interval) : false;
     }
 
     Scope<GraphicsContext> GraphicsContext::Create(SDL_Window* window)
@@ -51,7 +51,7 @@ namespace Coffee {
     private:
         SDL_Window* m_WindowHandle; ///< The handle to the SDL window.
 
-        SDL_GLContext m_Context;
+        SDL_GLContext m_Context; ///< The OpenGL context, null when running on the null backend.
     };
 
     /** @} */
@@ -1,5 +1,6 @@
 #include "Material.h"
 #include "CoffeeEngine/Core/Base.h"
+#include "CoffeeEngine/Core/FrameProfiler.h"
 #include "CoffeeEngine/IO/Resource.h"
 #include "CoffeeEngine/IO/ResourceLoader.h"
 #include "CoffeeEngine/IO/ResourceRegistry.h"
@@ -7,7 +8,6 @@
 #include "CoffeeEngine/Embedded/StandardShader.inl"
 #include <cstdint>
 #include <glm/fwd.hpp>
-#include <tracy/Tracy.hpp>
 
 namespace Coffee {
 
@@ -1,7 +1,8 @@
 #include "CoffeeEngine/Renderer/Mesh.h"
 #include "CoffeeEngine/Core/Base.h"
+#include "CoffeeEngine/Core/FrameProfiler.h"
+#include "CoffeeEngine/Core/MemoryTracker.h"
 #include "CoffeeEngine/Renderer/VertexArray.h"
-#include <tracy/Tracy.hpp>
 
 namespace Coffee {
 
@@ -9,6 +10,7 @@ namespace Coffee {
         : Resource(ResourceType::Mesh)
     {
         ZoneScoped;
+        COFFEE_MEMORY_TAG(MemoryTag::Resources);
 
         m_Vertices = vertices;
         m_Indices = indices;
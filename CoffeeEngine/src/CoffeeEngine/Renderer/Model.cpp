@@ -1,6 +1,8 @@
 #include "CoffeeEngine/Renderer/Model.h"
 #include "CoffeeEngine/Core/Base.h"
+#include "CoffeeEngine/Core/FrameProfiler.h"
 #include "CoffeeEngine/Core/Log.h"
+#include "CoffeeEngine/Core/MemoryTracker.h"
 #include "CoffeeEngine/Renderer/Material.h"
 #include "CoffeeEngine/Renderer/Mesh.h"
 #include "CoffeeEngine/Renderer/Texture.h"
@@ -15,7 +17,6 @@
 #include <cstdint>
 #include <filesystem>
 #include <string>
-#include <tracy/Tracy.hpp>
 #include <vector>
 
 
@@ -35,6 +36,7 @@ namespace Coffee {
         : Resource(ResourceType::Model)
     {
         ZoneScoped;
+        COFFEE_MEMORY_TAG(MemoryTag::Resources);
 
         m_FilePath = path;
 
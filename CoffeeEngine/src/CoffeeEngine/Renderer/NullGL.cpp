@@ -0,0 +1,213 @@
+#include "CoffeeEngine/Renderer/NullGL.h"
+
+#include <glad/glad.h>
+
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+
+namespace Coffee {
+
+    namespace
+    {
+        GLuint s_NextName = 1; // 0 is never a valid object name.
+
+        /**
+         * The default null implementation of an entry point: ignores its arguments and returns zero.
+         */
+        template<typename Function>
+        struct NullFunction;
+
+        template<typename R, typename... Args>
+        struct NullFunction<R(APIENTRYP)(Args...)>
+        {
+            static R APIENTRY Call(Args...) { return R(); }
+        };
+
+        const GLubyte* APIENTRY GetString(GLenum name)
+        {
+            switch (name)
+            {
+                case GL_VENDOR: return reinterpret_cast<const GLubyte*>("Coffee Engine");
+                case GL_RENDERER: return reinterpret_cast<const GLubyte*>("Null");
+                case GL_VERSION: return reinterpret_cast<const GLubyte*>("4.5.0 Null");
+                case GL_SHADING_LANGUAGE_VERSION: return reinterpret_cast<const GLubyte*>("4.50 Null");
+                default: return reinterpret_cast<const GLubyte*>("");
+            }
+        }
+
+        void APIENTRY GetIntegerv(GLenum name, GLint* data)
+        {
+            switch (name)
+            {
+                case GL_MAJOR_VERSION: *data = 4; break;
+                case GL_MINOR_VERSION: *data = 5; break;
+                case GL_NUM_EXTENSIONS: *data = 1; break; // GLAD fails to load when there are none.
+                default: *data = 0; break;
+            }
+        }
+
+        const GLubyte* APIENTRY GetStringi(GLenum, GLuint)
+        {
+            return reinterpret_cast<const GLubyte*>("GL_COFFEE_null");
+        }
+
+        void APIENTRY GenNames(GLsizei count, GLuint* names)
+        {
+            for (GLsizei i = 0; i < count; i++)
+                names[i] = s_NextName++;
+        }
+
+        void APIENTRY CreateTextures(GLenum, GLsizei count, GLuint* textures)
+        {
+            GenNames(count, textures);
+        }
+
+        GLuint APIENTRY CreateShader(GLenum)
+        {
+            return s_NextName++;
+        }
+
+        GLuint APIENTRY CreateProgram()
+        {
+            return s_NextName++;
+        }
+
+        void APIENTRY GetShaderiv(GLuint, GLenum name, GLint* params)
+        {
+            *params = name == GL_COMPILE_STATUS || name == GL_LINK_STATUS ? GL_TRUE : 0;
+        }
+
+        GLenum APIENTRY CheckFramebufferStatus(GLenum)
+        {
+            return GL_FRAMEBUFFER_COMPLETE;
+        }
+
+        GLenum APIENTRY CheckNamedFramebufferStatus(GLuint, GLenum)
+        {
+            return GL_FRAMEBUFFER_COMPLETE;
+        }
+
+        void APIENTRY ReadPixels(GLint, GLint, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels)
+        {
+            // Callers read the result (e.g. entity picking), give them zeros instead of garbage.
+            const size_t components = format == GL_RGBA || format == GL_RGBA_INTEGER ? 4
+                                      : format == GL_RGB || format == GL_RGB_INTEGER ? 3
+                                                                                      : 1;
+            const size_t componentSize = type == GL_UNSIGNED_BYTE || type == GL_BYTE ? 1 : 4;
+            std::memset(pixels, 0, static_cast<size_t>(width) * height * components * componentSize);
+        }
+    } // namespace
+
+#define COFFEE_NULL_GL(name) {#name, reinterpret_cast<void*>(&NullFunction<decltype(glad_##name)>::Call)}
+#define COFFEE_NULL_GL_AS(name, function) {#name, reinterpret_cast<void*>(static_cast<decltype(glad_##name)>(&function))}
+
+    void* NullGL::GetProcAddress(const char* name)
+    {
+        static const std::unordered_map<std::string_view, void*> s_Functions = {
+            // Queried by GLAD itself while loading.
+            COFFEE_NULL_GL_AS(glGetString, GetString),
+            COFFEE_NULL_GL_AS(glGetIntegerv, GetIntegerv),
+            COFFEE_NULL_GL_AS(glGetStringi, GetStringi),
+
+            // Objects.
+            COFFEE_NULL_GL_AS(glGenTextures, GenNames),
+            COFFEE_NULL_GL_AS(glGenBuffers, GenNames),
+            COFFEE_NULL_GL_AS(glGenVertexArrays, GenNames),
+            COFFEE_NULL_GL_AS(glGenFramebuffers, GenNames),
+            COFFEE_NULL_GL_AS(glCreateTextures, CreateTextures),
+            COFFEE_NULL_GL_AS(glCreateBuffers, GenNames),
+            COFFEE_NULL_GL_AS(glCreateVertexArrays, GenNames),
+            COFFEE_NULL_GL_AS(glCreateFramebuffers, GenNames),
+            COFFEE_NULL_GL(glDeleteTextures),
+            COFFEE_NULL_GL(glDeleteBuffers),
+            COFFEE_NULL_GL(glDeleteVertexArrays),
+            COFFEE_NULL_GL(glDeleteFramebuffers),
+
+            // Shaders.
+            COFFEE_NULL_GL_AS(glCreateShader, CreateShader),
+            COFFEE_NULL_GL_AS(glCreateProgram, CreateProgram),
+            COFFEE_NULL_GL_AS(glGetShaderiv, GetShaderiv),
+            COFFEE_NULL_GL_AS(glGetProgramiv, GetShaderiv),
+            COFFEE_NULL_GL(glGetShaderInfoLog),
+            COFFEE_NULL_GL(glGetProgramInfoLog),
+            COFFEE_NULL_GL(glShaderSource),
+            COFFEE_NULL_GL(glCompileShader),
+            COFFEE_NULL_GL(glAttachShader),
+            COFFEE_NULL_GL(glLinkProgram),
+            COFFEE_NULL_GL(glDeleteShader),
+            COFFEE_NULL_GL(glDeleteProgram),
+            COFFEE_NULL_GL(glUseProgram),
+            COFFEE_NULL_GL(glGetUniformLocation),
+            COFFEE_NULL_GL(glUniform1i),
+            COFFEE_NULL_GL(glUniform1f),
+            COFFEE_NULL_GL(glUniform2fv),
+            COFFEE_NULL_GL(glUniform3fv),
+            COFFEE_NULL_GL(glUniform4fv),
+            COFFEE_NULL_GL(glUniformMatrix2fv),
+            COFFEE_NULL_GL(glUniformMatrix3fv),
+            COFFEE_NULL_GL(glUniformMatrix4fv),
+
+            // Buffers and vertex arrays.
+            COFFEE_NULL_GL(glBindBuffer),
+            COFFEE_NULL_GL(glBindBufferBase),
+            COFFEE_NULL_GL(glBufferData),
+            COFFEE_NULL_GL(glBufferSubData),
+            COFFEE_NULL_GL(glNamedBufferData),
+            COFFEE_NULL_GL(glNamedBufferSubData),
+            COFFEE_NULL_GL(glBindVertexArray),
+            COFFEE_NULL_GL(glEnableVertexAttribArray),
+            COFFEE_NULL_GL(glVertexAttribPointer),
+            COFFEE_NULL_GL(glVertexAttribIPointer),
+            COFFEE_NULL_GL(glVertexAttribDivisor),
+
+            // Textures.
+            COFFEE_NULL_GL(glBindTexture),
+            COFFEE_NULL_GL(glBindTextureUnit),
+            COFFEE_NULL_GL(glTexImage2D),
+            COFFEE_NULL_GL(glTexParameteri),
+            COFFEE_NULL_GL(glTextureParameteri),
+            COFFEE_NULL_GL(glTextureParameterf),
+            COFFEE_NULL_GL(glTextureStorage2D),
+            COFFEE_NULL_GL(glTextureSubImage2D),
+            COFFEE_NULL_GL(glGenerateTextureMipmap),
+            COFFEE_NULL_GL(glClearTexImage),
+
+            // Framebuffers.
+            COFFEE_NULL_GL(glBindFramebuffer),
+            COFFEE_NULL_GL(glNamedFramebufferTexture),
+            COFFEE_NULL_GL(glNamedFramebufferDrawBuffers),
+            COFFEE_NULL_GL_AS(glCheckFramebufferStatus, CheckFramebufferStatus),
+            COFFEE_NULL_GL_AS(glCheckNamedFramebufferStatus, CheckNamedFramebufferStatus),
+            COFFEE_NULL_GL(glReadBuffer),
+            COFFEE_NULL_GL_AS(glReadPixels, ReadPixels),
+
+            // State and drawing.
+            COFFEE_NULL_GL(glEnable),
+            COFFEE_NULL_GL(glDisable),
+            COFFEE_NULL_GL(glBlendFunc),
+            COFFEE_NULL_GL(glCullFace),
+            COFFEE_NULL_GL(glDepthFunc),
+            COFFEE_NULL_GL(glDepthMask),
+            COFFEE_NULL_GL(glLineWidth),
+            COFFEE_NULL_GL(glViewport),
+            COFFEE_NULL_GL(glClearColor),
+            COFFEE_NULL_GL(glClear),
+            COFFEE_NULL_GL(glDrawArrays),
+            COFFEE_NULL_GL(glDrawElements),
+            COFFEE_NULL_GL(glDebugMessageCallback),
+            COFFEE_NULL_GL(glDebugMessageControl),
+        };
+
+        auto it = s_Functions.find(name);
+        return it != s_Functions.end() ? it->second : nullptr;
+    }
+
+#undef COFFEE_NULL_GL
+#undef COFFEE_NULL_GL_AS
+
+    bool NullGL::Load()
+    {
+        return gladLoadGLLoader(&NullGL::GetProcAddress) != 0;
+    }
+}
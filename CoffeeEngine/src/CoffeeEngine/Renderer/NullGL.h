@@ -0,0 +1,36 @@
+#pragma once
+
+namespace Coffee {
+
+    /**
+     * @defgroup renderer Renderer
+     * @brief Renderer components of the CoffeeEngine.
+     * @{
+     */
+
+    /**
+     * @brief OpenGL entry points that do nothing, used by the null renderer backend.
+     *
+     * The renderer calls OpenGL through the GLAD function pointers. Loading these instead of the driver's lets the
+     * whole renderer run without a GPU or a GL context: render commands are still queued, sorted and counted, only
+     * the GL calls themselves are dropped. The few functions whose results the engine depends on answer like a
+     * working driver would: objects get unique names, shaders compile, framebuffers are complete and the version
+     * is 4.5.
+     */
+    class NullGL
+    {
+    public:
+        /**
+         * @brief Points the GLAD entry points used by the engine at the null implementations.
+         * @return True if GLAD accepted them.
+         * @note An entry point that is not implemented stays null, add it to the table in NullGL.cpp when the
+         * renderer starts using a new GL function.
+         */
+        static bool Load();
+
+    private:
+        static void* GetProcAddress(const char* name);
+    };
+
+    /** @} */
+}
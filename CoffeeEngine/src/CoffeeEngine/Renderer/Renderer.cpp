@@ -1,4 +1,6 @@
 #include "Renderer.h"
+#include "CoffeeEngine/Core/FrameProfiler.h"
+#include "CoffeeEngine/Core/MemoryTracker.h"
 #include "CoffeeEngine/Renderer/Material.h"
 #include "CoffeeEngine/Scene/PrimitiveMesh.h"
 #include "CoffeeEngine/Renderer/DebugRenderer.h"
@@ -17,12 +19,20 @@
 #include <cstdint>
 #include <glm/fwd.hpp>
 #include <glm/matrix.hpp>
-#include <tracy/Tracy.hpp>
 
 namespace Coffee {
 
     static bool s_viewportResized = false;
     static uint32_t s_viewportWidth = 0, s_viewportHeight = 0;
+    static size_t s_lastRenderQueueSize = 0;
+
+    // The render queue lives in the frame arena: every scene starts with a fresh queue sized for the previous
+    // one, so submitting doesn't grow it in the common case and never touches the heap.
+    static void ResetRenderQueue(FrameVector<RenderCommand>& renderQueue)
+    {
+        renderQueue = FrameVector<RenderCommand>();
+        renderQueue.reserve(s_lastRenderQueueSize);
+    }
 
     RendererData Renderer::s_RendererData;
     RendererStats Renderer::s_Stats;
@@ -40,29 +50,24 @@ namespace Coffee {
     Ref<Shader> Renderer::s_ToneMappingShader;
     Ref<Shader> Renderer::s_FinalPassShader;
 
+    static constexpr const char* EnvironmentMapPath = "assets/textures/StandardCubeMap.hdr";
+    static constexpr const char* MissingMeshPath = "assets/models/MissingMesh.glb";
+
     static Ref<Cubemap> s_EnvironmentMap;
     static Ref<Mesh> s_SkyboxMesh;
     static Ref<Shader> s_SkyboxShader;
 
-    void Renderer::Init()
+    void Renderer::PreloadAssets()
     {
-        /*std::vector<std::filesystem::path> paths = {
-            "assets/textures/skybox/right.jpg",
-            "assets/textures/skybox/left.jpg",
-            "assets/textures/skybox/top.jpg",
-            "assets/textures/skybox/bottom.jpg",
-            "assets/textures/skybox/front.jpg",
-            "assets/textures/skybox/back.jpg"
-        };
-        s_EnvironmentMap = CreateRef<Cubemap>(paths);*/
-
-        s_EnvironmentMap = /* CreateRef<Cubemap>("assets/textures/StandardCubeMap.hdr"); */ Cubemap::Load("assets/textures/StandardCubeMap.hdr");
-
-        s_SkyboxMesh = PrimitiveMesh::CreateCube({-1.0f, -1.0f, -1.0f});
+        ZoneScoped;
 
-        s_SkyboxShader = CreateRef<Shader>("assets/shaders/SkyboxShader.glsl");
+        s_EnvironmentMap = Cubemap::Decode(EnvironmentMapPath);
+    }
 
+    void Renderer::Init()
+    {
         ZoneScoped;
+        COFFEE_MEMORY_TAG(MemoryTag::Renderer);
 
         RendererAPI::Init();
         DebugRenderer::Init();
@@ -73,10 +78,6 @@ namespace Coffee {
         Ref<Shader> missingShader = CreateRef<Shader>("MissingShader", std::string(missingShaderSource));
         s_RendererData.DefaultMaterial = CreateRef<Material>("Missing Material", missingShader); //TODO: Port it to use the Material::Create
 
-        // TODO: This is a hack to get the missing mesh add it to the PrimitiveMesh class
-        Ref<Model> m = Model::Load("assets/models/MissingMesh.glb");
-        s_RendererData.MissingMesh = m->GetMeshes()[0];
-
         s_MainFramebuffer = Framebuffer::Create(1280, 720, { ImageFormat::RGBA32F, ImageFormat::RGB8, ImageFormat::DEPTH24STENCIL8 });
         s_PostProcessingFramebuffer = Framebuffer::Create(1280, 720, { ImageFormat::RGBA8 });
 
@@ -96,8 +97,42 @@ namespace Coffee {
     {
     }
 
+    const Ref<Mesh>& Renderer::GetMissingMesh()
+    {
+        // Only needed when a mesh fails to load, so it is imported the first time that happens.
+        if (!s_RendererData.MissingMesh)
+        {
+            ZoneScopedN("Load Missing Mesh");
+
+            // TODO: This is a hack to get the missing mesh add it to the PrimitiveMesh class
+            Ref<Model> m = Model::Load(MissingMeshPath);
+            s_RendererData.MissingMesh = m->GetMeshes()[0];
+        }
+
+        return s_RendererData.MissingMesh;
+    }
+
+    void Renderer::InitSkybox()
+    {
+        ZoneScoped;
+        COFFEE_MEMORY_TAG(MemoryTag::Renderer);
+
+        // Decoded during startup by PreloadAssets, unless the application skipped it.
+        if (!s_EnvironmentMap)
+            s_EnvironmentMap = Cubemap::Decode(EnvironmentMapPath);
+        s_EnvironmentMap->Upload();
+
+        s_SkyboxMesh = PrimitiveMesh::CreateCube({-1.0f, -1.0f, -1.0f});
+
+        s_SkyboxShader = CreateRef<Shader>("assets/shaders/SkyboxShader.glsl");
+    }
+
     void Renderer::BeginScene(EditorCamera& camera)
     {
+        COFFEE_MEMORY_TAG(MemoryTag::Renderer);
+
+        ResetRenderQueue(s_RendererData.renderQueue);
+
         s_Stats.DrawCalls = 0;
         s_Stats.VertexCount = 0;
         s_Stats.IndexCount = 0;
@@ -119,6 +154,10 @@ namespace Coffee {
 
     void Renderer::BeginScene(Camera& camera, const glm::mat4& transform)
     {
+        COFFEE_MEMORY_TAG(MemoryTag::Renderer);
+
+        ResetRenderQueue(s_RendererData.renderQueue);
+
         s_Stats.DrawCalls = 0;
         s_Stats.VertexCount = 0;
         s_Stats.IndexCount = 0;
@@ -136,6 +175,8 @@ namespace Coffee {
 
     void Renderer::EndScene()
     {
+        COFFEE_MEMORY_TAG(MemoryTag::Renderer);
+
         s_MainFramebuffer->Bind();
         s_MainFramebuffer->SetDrawBuffers({0, 1});
 
@@ -181,7 +222,7 @@ namespace Coffee {
             
             if(mesh == nullptr)
             {
-                mesh = s_RendererData.MissingMesh.get();
+                mesh = GetMissingMesh().get();
             }
             
             RendererAPI::DrawIndexed(mesh->GetVertexArray());
@@ -193,7 +234,11 @@ namespace Coffee {
         }
 
         // Test drawing the skybox
+        if (!s_SkyboxShader)
+            InitSkybox();
+
         RendererAPI::SetDepthMask(false);
+        s_EnvironmentMap->Bind(0);
         s_SkyboxShader->Bind();
         RendererAPI::DrawIndexed(s_SkyboxMesh->GetVertexArray());
         RendererAPI::SetDepthMask(true);
@@ -239,6 +284,7 @@ namespace Coffee {
 
         s_MainFramebuffer->UnBind();
 
+        s_lastRenderQueueSize = s_RendererData.renderQueue.size();
         s_RendererData.renderQueue.clear();
     }
 
@@ -266,6 +312,8 @@ namespace Coffee {
 
     void Renderer::Submit(const RenderCommand& command)
     {
+        COFFEE_MEMORY_TAG(MemoryTag::Renderer);
+
         s_RendererData.renderQueue.push_back(command);
     }
 
@@ -302,6 +350,8 @@ namespace Coffee {
 
     void Renderer::ResizeFramebuffers()
     {
+        COFFEE_MEMORY_TAG(MemoryTag::Renderer);
+
         s_MainFramebuffer->Resize(s_viewportWidth, s_viewportHeight);
         s_PostProcessingFramebuffer->Resize(s_viewportWidth, s_viewportHeight);
     }
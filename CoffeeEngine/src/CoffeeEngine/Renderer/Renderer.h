@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CoffeeEngine/Core/Base.h"
+#include "CoffeeEngine/Core/FrameAllocator.h"
 #include "CoffeeEngine/Renderer/EditorCamera.h"
 #include "CoffeeEngine/Renderer/Framebuffer.h"
 #include "CoffeeEngine/Renderer/Material.h"
@@ -59,11 +60,11 @@ namespace Coffee {
         Ref<UniformBuffer> RenderDataUniformBuffer; ///< Uniform buffer for render data.
 
         Ref<Material> DefaultMaterial; ///< Default material.
-        Ref<Mesh> MissingMesh; ///< Missing mesh.
+        Ref<Mesh> MissingMesh; ///< Missing mesh. Loaded on first use, see Renderer::GetMissingMesh.
 
         Ref<Texture2D> RenderTexture; ///< Render texture.
 
-        std::vector<RenderCommand> renderQueue; ///< Render queue.
+        FrameVector<RenderCommand> renderQueue; ///< Render queue. Allocated from the frame arena.
     };
 
     /**
@@ -97,8 +98,18 @@ namespace Coffee {
     class Renderer
     {
     public:
+        /**
+         * @brief Decodes the renderer's built-in assets on the CPU. Touches no GPU state, so it can run on a worker
+         * thread while the window and the graphics context are being created. Optional: what is not preloaded is
+         * loaded on first use.
+         */
+        static void PreloadAssets();
+
         /**
          * @brief Initializes the renderer.
+         *
+         * Only creates what every frame needs. The skybox is uploaded the first time a scene is drawn and the
+         * missing mesh the first time it is needed.
          */
         static void Init();
 
@@ -180,6 +191,12 @@ namespace Coffee {
          */
         static const RendererData& GetData() { return s_RendererData; }
 
+        /**
+         * @brief Gets the mesh drawn in place of the meshes that failed to load, loading it if needed.
+         * @return The missing mesh.
+         */
+        static const Ref<Mesh>& GetMissingMesh();
+
         /**
          * @brief Gets the renderer statistics.
          * @return A reference to the renderer statistics.
@@ -195,6 +212,7 @@ namespace Coffee {
     private:
 
         static void ResizeFramebuffers();
+        static void InitSkybox();
 
     private:
         static RendererData s_RendererData; ///< Renderer data.
@@ -1,11 +1,13 @@
 #include "CoffeeEngine/Renderer/RendererAPI.h"
 
+#include "CoffeeEngine/Core/FrameProfiler.h"
+
 #include <glad/glad.h>
-#include <tracy/Tracy.hpp>
 
 namespace Coffee {
 
 	Scope<RendererAPI> RendererAPI::s_RendererAPI = RendererAPI::Create();
+	RendererAPI::API RendererAPI::s_API = RendererAPI::API::OpenGL;
 
     void OpenGLMessageCallback(
 		unsigned source,
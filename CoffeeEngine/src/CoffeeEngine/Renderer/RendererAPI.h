@@ -18,6 +18,27 @@ namespace Coffee {
      */
     class RendererAPI {
     public:
+        /**
+         * @brief The graphics backends the renderer can run on.
+         */
+        enum class API
+        {
+            OpenGL, ///< Renders through the driver's OpenGL 4.5 implementation.
+            Null ///< Records and counts the render commands but draws nothing, for headless runs. See NullGL.
+        };
+
+        /**
+         * @brief Selects the graphics backend. Must be called before the window is created.
+         * @param api The backend to use.
+         */
+        static void SetAPI(API api) { s_API = api; }
+
+        /**
+         * @brief Gets the graphics backend in use.
+         * @return The backend.
+         */
+        static API GetAPI() { return s_API; }
+
         /**
          * @brief Initializes the Renderer API.
          */
@@ -62,6 +83,7 @@ namespace Coffee {
 
     private:
         static Scope<RendererAPI> s_RendererAPI; ///< The Renderer API instance.
+        static API s_API; ///< The graphics backend in use.
     };
 
     /** @} */
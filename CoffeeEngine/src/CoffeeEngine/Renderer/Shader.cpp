@@ -1,11 +1,11 @@
 #include "CoffeeEngine/Renderer/Shader.h"
+#include "CoffeeEngine/Core/FrameProfiler.h"
 #include "CoffeeEngine/IO/ResourceLoader.h"
 #include "CoffeeEngine/IO/ResourceRegistry.h"
 
 #include <fstream>
 #include <sstream>
 #include <iostream>
-#include <tracy/Tracy.hpp>
 
 namespace Coffee {
 
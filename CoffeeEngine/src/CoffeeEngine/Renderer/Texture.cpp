@@ -1,6 +1,8 @@
 #include "CoffeeEngine/Renderer/Texture.h"
 #include "CoffeeEngine/Core/Base.h"
+#include "CoffeeEngine/Core/FrameProfiler.h"
 #include "CoffeeEngine/Core/Log.h"
+#include "CoffeeEngine/Core/MemoryTracker.h"
 #include "CoffeeEngine/IO/Resource.h"
 #include "CoffeeEngine/IO/ResourceLoader.h"
 
@@ -14,7 +16,6 @@
 #include <glad/glad.h>
 #include <stb_image.h>
 #include <glm/vec4.hpp>
-#include <tracy/Tracy.hpp>
 
 namespace Coffee {
 
@@ -69,6 +70,25 @@ namespace Coffee {
         }
     }
 
+    // Estimates the GPU memory of a texture from its format and mip chain; drivers may pad it further.
+    uint64_t EstimateTextureSize(ImageFormat format, int width, int height, int mipLevels, int layers = 1)
+    {
+        uint64_t bytesPerPixel;
+        switch(format)
+        {
+            case ImageFormat::R32F:
+            case ImageFormat::RGB32F:
+            case ImageFormat::RGBA32F: bytesPerPixel = ImageFormatToChannelCount(format) * sizeof(float); break;
+            case ImageFormat::DEPTH24STENCIL8: bytesPerPixel = 4; break;
+            default: bytesPerPixel = ImageFormatToChannelCount(format); break;
+        }
+
+        uint64_t size = 0;
+        for (int level = 0; level < mipLevels; level++)
+            size += (uint64_t)std::max(width >> level, 1) * std::max(height >> level, 1) * bytesPerPixel;
+        return size * layers;
+    }
+
     Texture2D::Texture2D(const TextureProperties& properties)
         : m_Properties(properties), m_Width(properties.Width), m_Height(properties.Height)
     {
@@ -89,6 +109,7 @@ namespace Coffee {
 
         glCreateTextures(GL_TEXTURE_2D, 1, &m_textureID);
         glTextureStorage2D(m_textureID, mipLevels, internalFormat, m_Width, m_Height);
+        m_GPUMemory.Set(EstimateTextureSize(m_Properties.Format, m_Width, m_Height, mipLevels));
 
         glTextureParameteri(m_textureID, GL_TEXTURE_WRAP_S, GL_REPEAT);
         glTextureParameteri(m_textureID, GL_TEXTURE_WRAP_T, GL_REPEAT);
@@ -104,6 +125,7 @@ namespace Coffee {
         : Texture(ResourceType::Texture2D)
     {
         ZoneScoped;
+        COFFEE_MEMORY_TAG(MemoryTag::Resources);
 
         m_FilePath = path;
         m_Name = path.filename().string();
@@ -111,7 +133,8 @@ namespace Coffee {
         m_Properties.srgb = srgb;
 
         int nrComponents;
-        stbi_set_flip_vertically_on_load(true);
+        // Per thread, so a cubemap decoded on a worker at the same time isn't flipped.
+        stbi_set_flip_vertically_on_load_thread(true);
         unsigned char* data = stbi_load(m_FilePath.string().c_str(), &m_Width, &m_Height, &nrComponents, 0);
 
         m_Properties.Width = m_Width, m_Properties.Height = m_Height;
@@ -141,6 +164,7 @@ namespace Coffee {
 
             glCreateTextures(GL_TEXTURE_2D, 1, &m_textureID);
             glTextureStorage2D(m_textureID, mipLevels, internalFormat, m_Width, m_Height);
+            m_GPUMemory.Set(EstimateTextureSize(m_Properties.Format, m_Width, m_Height, mipLevels));
 
             glTextureParameteri(m_textureID, GL_TEXTURE_WRAP_S, GL_REPEAT);
             glTextureParameteri(m_textureID, GL_TEXTURE_WRAP_T, GL_REPEAT);
@@ -197,6 +221,7 @@ namespace Coffee {
 
         glCreateTextures(GL_TEXTURE_2D, 1, &m_textureID);
         glTextureStorage2D(m_textureID, mipLevels, internalFormat, m_Width, m_Height);
+        m_GPUMemory.Set(EstimateTextureSize(m_Properties.Format, m_Width, m_Height, mipLevels));
 
         glTextureParameteri(m_textureID, GL_TEXTURE_WRAP_S, GL_REPEAT);
         glTextureParameteri(m_textureID, GL_TEXTURE_WRAP_T, GL_REPEAT);
@@ -280,11 +305,23 @@ namespace Coffee {
     {
         ZoneScoped;
 
+        ReadFromFile(path);
+        Upload();
+    }
+
+    void Cubemap::ReadFromFile(const std::filesystem::path& path)
+    {
+        COFFEE_MEMORY_TAG(MemoryTag::Resources);
+
         m_FilePath = path;
         m_Name = path.filename().string();
 
         m_Properties.srgb = false;
 
+        // Cubemaps are never flipped. Per thread, since Texture2D sets it the other way and both can be loading at
+        // the same time during startup.
+        stbi_set_flip_vertically_on_load_thread(false);
+
         if(path.extension() == ".hdr")
         {
             LoadHDRFromFile(path);
@@ -331,8 +368,6 @@ namespace Coffee {
                 m_Properties.Format = ImageFormat::RGBA8;
             break;
         }
-
-        LoadStandardFromData(m_Data);
     }
 
     void Cubemap::LoadHDRFromFile(const std::filesystem::path& path)
@@ -359,8 +394,6 @@ namespace Coffee {
                 m_Properties.Format = ImageFormat::RGBA32F;
                 break;
         }
-        
-        LoadHDRFromData(m_HDRData);
     }
 
     void Cubemap::LoadStandardFromData(const std::vector<unsigned char>& data)
@@ -424,6 +457,7 @@ namespace Coffee {
 
             delete[] faceBuffer;
         }
+        m_GPUMemory.Set(EstimateTextureSize(m_Properties.Format, faceSize, faceSize, 1, 6));
 
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -492,6 +526,7 @@ namespace Coffee {
         
             delete[] faceBuffer;
         }
+        m_GPUMemory.Set(EstimateTextureSize(m_Properties.Format, faceSize, faceSize, 1, 6));
         
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -509,4 +544,28 @@ namespace Coffee {
         return CreateRef<Cubemap>(path);
     }
 
+    Ref<Cubemap> Cubemap::Decode(const std::filesystem::path& path)
+    {
+        ZoneScoped;
+
+        Ref<Cubemap> cubemap = CreateRef<Cubemap>();
+        cubemap->m_Type = ResourceType::Cubemap;
+        cubemap->ReadFromFile(path);
+        return cubemap;
+    }
+
+    void Cubemap::Upload()
+    {
+        ZoneScoped;
+        COFFEE_MEMORY_TAG(MemoryTag::Resources);
+
+        if (m_textureID != 0)
+            return;
+
+        if (!m_HDRData.empty())
+            LoadHDRFromData(m_HDRData);
+        else if (!m_Data.empty())
+            LoadStandardFromData(m_Data);
+    }
+
 } // namespace Coffee
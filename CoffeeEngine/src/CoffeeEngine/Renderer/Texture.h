@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CoffeeEngine/Core/Base.h"
+#include "CoffeeEngine/Core/MemoryTracker.h"
 #include "CoffeeEngine/IO/Resource.h"
 #include "CoffeeEngine/IO/Serialization/FilesystemPathSerialization.h"
 
@@ -129,6 +130,7 @@ namespace Coffee {
         std::vector<unsigned char> m_Data;
         uint32_t m_textureID;
         int m_Width, m_Height;
+        GPUMemory m_GPUMemory; ///< The estimated size of the texture storage.
     };
 
     class Cubemap : public Texture
@@ -149,8 +151,21 @@ namespace Coffee {
 
         static Ref<Cubemap> Load(const std::filesystem::path& path);
         static Ref<Cubemap> Create(const std::filesystem::path& path);
+
+        /**
+         * @brief Reads and decodes a cubemap image without touching the GPU, so it can run on any thread.
+         * @param path The path of the image, laid out as a horizontal cross.
+         * @return The cubemap. Upload must be called on the render thread before it is used.
+         */
+        static Ref<Cubemap> Decode(const std::filesystem::path& path);
+
+        /**
+         * @brief Creates the GPU texture from the decoded image. Does nothing if it already exists.
+         */
+        void Upload();
     private:
 
+        void ReadFromFile(const std::filesystem::path& path);
         void LoadStandardFromFile(const std::filesystem::path& path);
         void LoadHDRFromFile(const std::filesystem::path& path);
         void LoadStandardFromData(const std::vector<unsigned char>& data);
@@ -193,8 +208,9 @@ namespace Coffee {
         TextureProperties m_Properties;
         std::vector<unsigned char> m_Data;
         std::vector<float> m_HDRData;
-        uint32_t m_textureID;
+        uint32_t m_textureID = 0;
         int m_Width, m_Height;
+        GPUMemory m_GPUMemory; ///< The estimated size of the six faces.
     };
 
 }
@@ -10,6 +10,7 @@ namespace Coffee {
     {
         glCreateBuffers(1, &m_uboID);
         glNamedBufferData(m_uboID, size, nullptr, GL_DYNAMIC_DRAW); //or GL_DYNAMIC_DRAW? Search what are the differences
+        m_GPUMemory.Set(size);
         glBindBufferBase(GL_UNIFORM_BUFFER, binding, m_uboID);
     }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CoffeeEngine/Core/Base.h"
+#include "CoffeeEngine/Core/MemoryTracker.h"
 #include <cstdint>
 
 namespace Coffee {
@@ -46,6 +47,7 @@ namespace Coffee {
         static Ref<UniformBuffer> Create(uint32_t size, uint32_t binding);
     private:
         uint32_t m_uboID; ///< The ID of the uniform buffer.
+        GPUMemory m_GPUMemory; ///< The size of the buffer storage.
     };
 
     /** @} */
@@ -1,7 +1,8 @@
 #include "CoffeeEngine/Renderer/VertexArray.h"
 
+#include "CoffeeEngine/Core/FrameProfiler.h"
+
 #include <glad/glad.h>
-#include <tracy/Tracy.hpp>
 
 namespace Coffee {
 
@@ -0,0 +1,593 @@
+#include "BinarySceneSerializer.h"
+
+#include "CoffeeEngine/Core/Log.h"
+#include "CoffeeEngine/Core/MemoryTracker.h"
+#include "CoffeeEngine/IO/MappedFile.h"
+#include "CoffeeEngine/Scene/Components.h"
+#include "CoffeeEngine/Scene/Scene.h"
+#include "CoffeeEngine/Scene/SceneTree.h"
+
+#include <cereal/archives/binary.hpp>
+#include <tracy/Tracy.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <sstream>
+#include <streambuf>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace Coffee {
+
+    // The raw blocks are copied straight from the mapped file
+    static_assert(std::is_trivially_copyable_v<TransformComponent>);
+    static_assert(std::is_trivially_copyable_v<HierarchyComponent>);
+    static_assert(std::is_trivially_copyable_v<LightComponent>);
+    static_assert(sizeof(entt::entity) == sizeof(uint32_t));
+
+    static constexpr size_t BlockAlignment = 16;
+
+    static size_t AlignBlock(size_t offset)
+    {
+        return (offset + BlockAlignment - 1) & ~(BlockAlignment - 1);
+    }
+
+    static const char* GetBlockName(BinarySceneBlockType type)
+    {
+        switch (type)
+        {
+            using enum BinarySceneBlockType;
+        case Entities: return "Entities";
+        case Tag: return "Tag";
+        case Transform: return "Transform";
+        case Hierarchy: return "Hierarchy";
+        case Camera: return "Camera";
+        case Mesh: return "Mesh";
+        case Material: return "Material";
+        case Light: return "Light";
+        case Script: return "Script";
+        case AudioSource: return "AudioSource";
+        case AudioListener: return "AudioListener";
+        case AudioZone: return "AudioZone";
+        }
+        return "Unknown";
+    }
+
+    /**
+     * @brief Gets the layout version of the elements of a raw block.
+     *
+     * A component can change without changing its size, bump its version whenever the fields of its component or
+     * record change so the old files are rejected instead of read as garbage.
+     */
+    static uint32_t GetLayoutVersion(BinarySceneBlockType type)
+    {
+        switch (type)
+        {
+            using enum BinarySceneBlockType;
+        case Tag: return 1;
+        case Transform: return 1;
+        case Hierarchy: return 1;
+        case Mesh: return 1;
+        case Material: return 1;
+        case Light: return 1;
+        default: return 0;
+        }
+    }
+
+    // Raw elements of the blocks whose components hold strings or resources
+    struct TagRecord
+    {
+        uint32_t Offset; ///< Offset of the name in the string table.
+        uint32_t Length;
+    };
+
+    struct MeshRecord
+    {
+        uint64_t Mesh; ///< The UUID of the mesh, 0 for none.
+        uint32_t DrawAABB;
+        uint32_t Padding;
+    };
+
+    struct MaterialRecord
+    {
+        uint64_t Material; ///< The UUID of the material, 0 for none.
+    };
+
+    /**
+     * @brief Builds the file in memory, block by block.
+     */
+    class BinarySceneWriter
+    {
+    public:
+        BinarySceneWriter(entt::registry& registry) : m_Registry(registry)
+        {
+            m_Data.resize(sizeof(BinarySceneHeader));
+        }
+
+        void WriteEntities()
+        {
+            std::vector<entt::entity> entities;
+            for (auto entity : m_Registry.view<entt::entity>())
+                entities.push_back(entity);
+
+            BeginBlock(BinarySceneBlockType::Entities, BinarySceneEncoding::Raw, entities.size(), 0, 0);
+            Append(entities.data(), entities.size() * sizeof(entt::entity));
+            EndBlock();
+        }
+
+        /**
+         * @brief Writes a raw block, converting every component to a record.
+         * @param convert Called with a component, returns its record.
+         */
+        template<typename Component, typename Record, typename Convert>
+        void WriteRawBlock(BinarySceneBlockType type, Convert&& convert)
+        {
+            auto& storage = m_Registry.storage<Component>();
+
+            std::vector<entt::entity> entities;
+            std::vector<Record> records;
+            entities.reserve(storage.size());
+            records.reserve(storage.size());
+            for (auto [entity, component] : storage.each())
+            {
+                entities.push_back(entity);
+                records.push_back(convert(component));
+            }
+
+            BeginBlock(type, BinarySceneEncoding::Raw, entities.size(), sizeof(Record), GetLayoutVersion(type));
+            Append(entities.data(), entities.size() * sizeof(entt::entity));
+            m_Data.resize(AlignBlock(m_Data.size()));
+            Append(records.data(), records.size() * sizeof(Record));
+            EndBlock();
+        }
+
+        template<typename Component>
+        void WriteRawBlock(BinarySceneBlockType type)
+        {
+            WriteRawBlock<Component, Component>(type, [](const Component& component) { return component; });
+        }
+
+        template<typename Component>
+        void WriteCerealBlock(BinarySceneBlockType type)
+        {
+            auto& storage = m_Registry.storage<Component>();
+
+            std::vector<entt::entity> entities;
+            entities.reserve(storage.size());
+            std::ostringstream stream(std::ios::binary);
+            {
+                cereal::BinaryOutputArchive archive(stream);
+                for (auto [entity, component] : storage.each())
+                {
+                    entities.push_back(entity);
+                    archive(component);
+                }
+            }
+
+            BeginBlock(type, BinarySceneEncoding::Cereal, entities.size(), 0, 0);
+            Append(entities.data(), entities.size() * sizeof(entt::entity));
+            m_Data.resize(AlignBlock(m_Data.size()));
+            const std::string components = std::move(stream).str();
+            Append(components.data(), components.size());
+            EndBlock();
+        }
+
+        uint32_t AddString(const std::string& string)
+        {
+            const uint32_t offset = static_cast<uint32_t>(m_Strings.size());
+            m_Strings += string;
+            return offset;
+        }
+
+        bool WriteFile(const std::filesystem::path& path)
+        {
+            BinarySceneHeader header = {};
+            std::memcpy(header.Magic, BinarySceneSerializer::Magic, sizeof(header.Magic));
+            header.Version = BinarySceneSerializer::Version;
+            header.BlockCount = static_cast<uint32_t>(m_Blocks.size());
+
+            m_Data.resize(AlignBlock(m_Data.size()));
+            header.StringTableOffset = m_Data.size();
+            header.StringTableSize = m_Strings.size();
+            Append(m_Strings.data(), m_Strings.size());
+
+            m_Data.resize(AlignBlock(m_Data.size()));
+            header.BlockTableOffset = m_Data.size();
+            Append(m_Blocks.data(), m_Blocks.size() * sizeof(BinarySceneBlock));
+
+            std::memcpy(m_Data.data(), &header, sizeof(header));
+
+            std::ofstream file(path, std::ios::binary);
+            if (!file.write(m_Data.data(), m_Data.size()))
+            {
+                COFFEE_CORE_ERROR("BinarySceneSerializer::Save: Could not write {0}", path.string());
+                return false;
+            }
+            return true;
+        }
+
+    private:
+        void BeginBlock(BinarySceneBlockType type, BinarySceneEncoding encoding, size_t count, uint32_t elementSize,
+                        uint32_t layoutVersion)
+        {
+            m_Data.resize(AlignBlock(m_Data.size()));
+            m_Blocks.push_back({type, encoding, static_cast<uint32_t>(count), elementSize, layoutVersion, 0, m_Data.size(), 0});
+        }
+
+        void EndBlock()
+        {
+            m_Blocks.back().Size = m_Data.size() - m_Blocks.back().Offset;
+        }
+
+        void Append(const void* data, size_t size)
+        {
+            const size_t offset = m_Data.size();
+            m_Data.resize(offset + size);
+            if (size > 0)
+                std::memcpy(m_Data.data() + offset, data, size);
+        }
+
+    private:
+        entt::registry& m_Registry;
+        std::vector<char> m_Data; ///< The header and the blocks.
+        std::vector<BinarySceneBlock> m_Blocks;
+        std::string m_Strings;
+    };
+
+    // Lets cereal read a block of the mapped file without copying it
+    class MemoryStreamBuffer : public std::streambuf
+    {
+    public:
+        MemoryStreamBuffer(const std::byte* data, size_t size)
+        {
+            char* begin = const_cast<char*>(reinterpret_cast<const char*>(data));
+            setg(begin, begin, begin + size);
+        }
+    };
+
+    /**
+     * @brief Reads the blocks of a mapped file into a registry.
+     */
+    class BinarySceneReader
+    {
+    public:
+        BinarySceneReader(entt::registry& registry, const MappedFile& file, std::string_view strings)
+            : m_Registry(registry), m_File(file), m_Strings(strings)
+        {
+        }
+
+        void ReadEntities(const BinarySceneBlock& block)
+        {
+            const entt::entity* entities = GetEntities(block);
+            for (uint32_t i = 0; i < block.Count; i++)
+            {
+                if (m_Registry.valid(entities[i]) || m_Registry.create(entities[i]) != entities[i])
+                {
+                    COFFEE_CORE_ERROR("BinarySceneSerializer::Load: Entity {0} is duplicated", (uint32_t)entities[i]);
+                    m_Failed = true;
+                    return;
+                }
+            }
+        }
+
+        template<typename Component>
+        void ReadRawBlock(const BinarySceneBlock& block)
+        {
+            if (!CheckLayout(block, sizeof(Component)) || !CheckEntities<Component>(block))
+                return;
+
+            const entt::entity* entities = GetEntities(block);
+            const Component* components = GetComponents<Component>(block);
+            m_Registry.insert<Component>(entities, entities + block.Count, components);
+        }
+
+        /**
+         * @brief Reads a raw block of records.
+         * @param convert Called with a record, returns the component.
+         */
+        template<typename Component, typename Record, typename Convert>
+        void ReadRawBlock(const BinarySceneBlock& block, Convert&& convert)
+        {
+            if (!CheckLayout(block, sizeof(Record)) || !CheckEntities<Component>(block))
+                return;
+
+            const entt::entity* entities = GetEntities(block);
+            const Record* records = GetComponents<Record>(block);
+
+            std::vector<Component> components;
+            components.reserve(block.Count);
+            for (uint32_t i = 0; i < block.Count; i++)
+                components.push_back(convert(records[i]));
+
+            m_Registry.insert<Component>(entities, entities + block.Count, components.begin());
+        }
+
+        template<typename Component>
+        void ReadCerealBlock(const BinarySceneBlock& block)
+        {
+            const entt::entity* entities = GetEntities(block);
+            const size_t componentsOffset = AlignBlock(block.Count * sizeof(entt::entity));
+            if (block.Encoding != BinarySceneEncoding::Cereal || componentsOffset > block.Size)
+            {
+                COFFEE_CORE_ERROR("BinarySceneSerializer::Load: The {0} block is corrupted", GetBlockName(block.Type));
+                m_Failed = true;
+                return;
+            }
+
+            if (!CheckEntities<Component>(block))
+                return;
+
+            MemoryStreamBuffer buffer(m_File.GetData() + block.Offset + componentsOffset, block.Size - componentsOffset);
+            std::istream stream(&buffer);
+            cereal::BinaryInputArchive archive(stream);
+
+            try
+            {
+                for (uint32_t i = 0; i < block.Count; i++)
+                {
+                    Component component;
+                    archive(component);
+                    m_Registry.emplace<Component>(entities[i], std::move(component));
+                }
+            }
+            catch (const cereal::Exception& e)
+            {
+                COFFEE_CORE_ERROR("BinarySceneSerializer::Load: The {0} block is corrupted: {1}", GetBlockName(block.Type), e.what());
+                m_Failed = true;
+            }
+        }
+
+        /**
+         * @brief Checks whether a block was corrupted. The scene is incomplete and must be discarded.
+         */
+        bool HasFailed() const { return m_Failed; }
+
+        std::string_view GetString(uint32_t offset, uint32_t length) const
+        {
+            if (static_cast<uint64_t>(offset) + length > m_Strings.size())
+            {
+                COFFEE_CORE_ERROR("BinarySceneSerializer::Load: A name is outside the string table");
+                return {};
+            }
+            return m_Strings.substr(offset, length);
+        }
+
+    private:
+        const entt::entity* GetEntities(const BinarySceneBlock& block) const
+        {
+            return reinterpret_cast<const entt::entity*>(m_File.GetData() + block.Offset);
+        }
+
+        template<typename Element>
+        const Element* GetComponents(const BinarySceneBlock& block) const
+        {
+            return reinterpret_cast<const Element*>(m_File.GetData() + block.Offset +
+                                                    AlignBlock(block.Count * sizeof(entt::entity)));
+        }
+
+        /**
+         * @brief Checks that every entity of a component block was created by the Entities block and has no component
+         * of the block yet. Fails the load otherwise, inserting would be undefined behaviour.
+         */
+        template<typename Component>
+        bool CheckEntities(const BinarySceneBlock& block)
+        {
+            const entt::entity* entities = GetEntities(block);
+            const auto& storage = m_Registry.storage<Component>();
+            for (uint32_t i = 0; i < block.Count; i++)
+            {
+                if (!m_Registry.valid(entities[i]) || storage.contains(entities[i]))
+                {
+                    COFFEE_CORE_ERROR("BinarySceneSerializer::Load: The {0} block has an invalid entity {1}",
+                                      GetBlockName(block.Type), (uint32_t)entities[i]);
+                    m_Failed = true;
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool CheckLayout(const BinarySceneBlock& block, size_t elementSize) const
+        {
+            const uint64_t size = AlignBlock(block.Count * sizeof(entt::entity)) + uint64_t(block.Count) * elementSize;
+            if (block.Encoding != BinarySceneEncoding::Raw || block.ElementSize != elementSize ||
+                block.LayoutVersion != GetLayoutVersion(block.Type) || block.Size < size)
+            {
+                COFFEE_CORE_ERROR("BinarySceneSerializer::Load: The {0} block was saved with another component layout, "
+                                  "it is skipped. Convert the scene again from its JSON file",
+                                  GetBlockName(block.Type));
+                return false;
+            }
+            return true;
+        }
+
+    private:
+        entt::registry& m_Registry;
+        const MappedFile& m_File;
+        std::string_view m_Strings;
+        bool m_Failed = false;
+    };
+
+    bool BinarySceneSerializer::IsBinaryScene(const std::filesystem::path& path)
+    {
+        char magic[sizeof(Magic)] = {};
+        std::ifstream file(path, std::ios::binary);
+        return file.read(magic, sizeof(magic)) && std::memcmp(magic, Magic, sizeof(Magic)) == 0;
+    }
+
+    bool BinarySceneSerializer::Save(const std::filesystem::path& path, const Ref<Scene>& scene)
+    {
+        ZoneScoped;
+        COFFEE_MEMORY_TAG(MemoryTag::Scene);
+
+        BinarySceneWriter writer(scene->m_Registry);
+
+        writer.WriteEntities();
+        writer.WriteRawBlock<TagComponent, TagRecord>(BinarySceneBlockType::Tag, [&writer](const TagComponent& tag) {
+            return TagRecord{writer.AddString(tag.Tag), static_cast<uint32_t>(tag.Tag.size())};
+        });
+        writer.WriteRawBlock<TransformComponent>(BinarySceneBlockType::Transform);
+        writer.WriteRawBlock<HierarchyComponent>(BinarySceneBlockType::Hierarchy);
+        writer.WriteCerealBlock<CameraComponent>(BinarySceneBlockType::Camera);
+        writer.WriteRawBlock<MeshComponent, MeshRecord>(BinarySceneBlockType::Mesh, [](const MeshComponent& mesh) {
+            return MeshRecord{mesh.mesh ? (uint64_t)mesh.mesh->GetUUID() : 0, mesh.drawAABB, 0};
+        });
+        writer.WriteRawBlock<MaterialComponent, MaterialRecord>(BinarySceneBlockType::Material, [](const MaterialComponent& material) {
+            return MaterialRecord{material.material ? (uint64_t)material.material->GetUUID() : 0};
+        });
+        writer.WriteRawBlock<LightComponent>(BinarySceneBlockType::Light);
+        writer.WriteCerealBlock<ScriptComponent>(BinarySceneBlockType::Script);
+        writer.WriteCerealBlock<AudioSourceComponent>(BinarySceneBlockType::AudioSource);
+        writer.WriteCerealBlock<AudioListenerComponent>(BinarySceneBlockType::AudioListener);
+        writer.WriteCerealBlock<AudioZoneComponent>(BinarySceneBlockType::AudioZone);
+
+        if (!writer.WriteFile(path))
+            return false;
+
+        scene->m_FilePath = path;
+        return true;
+    }
+
+    Ref<Scene> BinarySceneSerializer::Load(const std::filesystem::path& path)
+    {
+        ZoneScoped;
+        COFFEE_MEMORY_TAG(MemoryTag::Scene);
+
+        MappedFile file(path);
+        if (!file.IsOpen())
+            return nullptr;
+
+        BinarySceneHeader header;
+        if (file.GetSize() < sizeof(header))
+        {
+            COFFEE_CORE_ERROR("BinarySceneSerializer::Load: {0} is not a binary scene", path.string());
+            return nullptr;
+        }
+        std::memcpy(&header, file.GetData(), sizeof(header));
+
+        if (std::memcmp(header.Magic, Magic, sizeof(Magic)) != 0)
+        {
+            COFFEE_CORE_ERROR("BinarySceneSerializer::Load: {0} is not a binary scene", path.string());
+            return nullptr;
+        }
+        if (header.Version != Version)
+        {
+            COFFEE_CORE_ERROR("BinarySceneSerializer::Load: {0} has version {1}, this build reads version {2}. "
+                              "Convert the scene again from its JSON file",
+                              path.string(), header.Version, Version);
+            return nullptr;
+        }
+        if (header.BlockTableOffset + uint64_t(header.BlockCount) * sizeof(BinarySceneBlock) > file.GetSize() ||
+            header.StringTableOffset + header.StringTableSize > file.GetSize())
+        {
+            COFFEE_CORE_ERROR("BinarySceneSerializer::Load: {0} is truncated", path.string());
+            return nullptr;
+        }
+
+        std::vector<BinarySceneBlock> blocks(header.BlockCount);
+        std::memcpy(blocks.data(), file.GetData() + header.BlockTableOffset, blocks.size() * sizeof(BinarySceneBlock));
+
+        for (const BinarySceneBlock& block : blocks)
+        {
+            if (block.Offset % BlockAlignment != 0 || block.Offset + block.Size > file.GetSize() ||
+                uint64_t(block.Count) * sizeof(entt::entity) > block.Size)
+            {
+                COFFEE_CORE_ERROR("BinarySceneSerializer::Load: The {0} block of {1} is corrupted",
+                                  GetBlockName(block.Type), path.string());
+                return nullptr;
+            }
+        }
+
+        Ref<Scene> scene = CreateRef<Scene>();
+        entt::registry& registry = scene->m_Registry;
+
+        const std::string_view strings(reinterpret_cast<const char*>(file.GetData() + header.StringTableOffset),
+                                       header.StringTableSize);
+        BinarySceneReader reader(registry, file, strings);
+
+        // The components need their entities, read them first
+        for (const BinarySceneBlock& block : blocks)
+        {
+            if (block.Type == BinarySceneBlockType::Entities)
+                reader.ReadEntities(block);
+        }
+
+        if (reader.HasFailed())
+            return nullptr;
+
+        // The files store the child lists, don't let OnConstruct append the entities to their parents again
+        registry.on_construct<HierarchyComponent>().disconnect<&HierarchyComponent::OnConstruct>();
+
+        for (const BinarySceneBlock& block : blocks)
+        {
+            switch (block.Type)
+            {
+                using enum BinarySceneBlockType;
+            case Entities:
+                break;
+            case Tag:
+                reader.ReadRawBlock<TagComponent, TagRecord>(block, [&reader](const TagRecord& record) {
+                    return TagComponent(std::string(reader.GetString(record.Offset, record.Length)));
+                });
+                break;
+            case Transform:
+                reader.ReadRawBlock<TransformComponent>(block);
+                break;
+            case Hierarchy:
+                reader.ReadRawBlock<HierarchyComponent>(block);
+                break;
+            case Camera:
+                reader.ReadCerealBlock<CameraComponent>(block);
+                break;
+            case Mesh:
+                reader.ReadRawBlock<MeshComponent, MeshRecord>(block, [](const MeshRecord& record) {
+                    MeshComponent mesh(record.Mesh != 0 ? ResourceRegistry::Get<Coffee::Mesh>(record.Mesh) : nullptr);
+                    mesh.drawAABB = record.DrawAABB != 0;
+                    return mesh;
+                });
+                break;
+            case Material:
+                // Built from the resource directly, the default constructor would create a default material each time
+                reader.ReadRawBlock<MaterialComponent, MaterialRecord>(block, [](const MaterialRecord& record) {
+                    return MaterialComponent(record.Material != 0 ? ResourceRegistry::Get<Coffee::Material>(record.Material) : nullptr);
+                });
+                break;
+            case Light:
+                reader.ReadRawBlock<LightComponent>(block);
+                break;
+            case Script:
+                reader.ReadCerealBlock<ScriptComponent>(block);
+                break;
+            case AudioSource:
+                reader.ReadCerealBlock<AudioSourceComponent>(block);
+                break;
+            case AudioListener:
+                reader.ReadCerealBlock<AudioListenerComponent>(block);
+                break;
+            case AudioZone:
+                reader.ReadCerealBlock<AudioZoneComponent>(block);
+                break;
+            default:
+                COFFEE_CORE_WARN("BinarySceneSerializer::Load: Skipping unknown block {0}", (uint32_t)block.Type);
+                break;
+            }
+        }
+
+        if (reader.HasFailed())
+            return nullptr;
+
+        registry.on_construct<HierarchyComponent>().connect<&HierarchyComponent::OnConstruct>();
+
+        scene->m_FilePath = path;
+
+        for (auto& audioSource : Audio::audioSources)
+        {
+            Audio::SetVolume(audioSource->gameObjectID, audioSource->mute ? 0.f : audioSource->volume);
+        }
+
+        return scene;
+    }
+
+}
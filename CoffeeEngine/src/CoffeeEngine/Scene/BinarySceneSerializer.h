@@ -0,0 +1,114 @@
+#pragma once
+
+#include "CoffeeEngine/Core/Base.h"
+
+#include <cstdint>
+#include <filesystem>
+
+namespace Coffee {
+
+    class Scene;
+
+    /**
+     * @defgroup scene Scene
+     * @{
+     */
+
+    /**
+     * @brief The first bytes of a binary scene file.
+     */
+    struct BinarySceneHeader
+    {
+        char Magic[8]; ///< BinarySceneSerializer::Magic.
+        uint32_t Version; ///< The version of the format.
+        uint32_t BlockCount; ///< The number of entries in the block table.
+        uint64_t BlockTableOffset; ///< Offset of the block table from the start of the file.
+        uint64_t StringTableOffset; ///< Offset of the string table from the start of the file.
+        uint64_t StringTableSize; ///< Size of the string table in bytes.
+    };
+
+    /**
+     * @brief The contents of a block. New types are added at the end; readers skip the types they don't know.
+     */
+    enum class BinarySceneBlockType : uint32_t
+    {
+        Entities = 0,
+        Tag,
+        Transform,
+        Hierarchy,
+        Camera,
+        Mesh,
+        Material,
+        Light,
+        Script,
+        AudioSource,
+        AudioListener,
+        AudioZone
+    };
+
+    /**
+     * @brief How the components of a block are stored.
+     */
+    enum class BinarySceneEncoding : uint32_t
+    {
+        Raw = 0, ///< An array of Count elements of ElementSize bytes, loaded straight from the mapped file.
+        Cereal = 1 ///< A cereal binary archive with Count components, for the components that hold resources or scripts.
+    };
+
+    /**
+     * @brief An entry of the block table.
+     *
+     * A block starts with the Count entities that own its components, followed by the components at the next
+     * 16-byte boundary. The Entities block only has the entities.
+     */
+    struct BinarySceneBlock
+    {
+        BinarySceneBlockType Type;
+        BinarySceneEncoding Encoding;
+        uint32_t Count; ///< The number of entities of the block.
+        uint32_t ElementSize; ///< The size of a raw element, checked against the running build. 0 for cereal blocks.
+        uint32_t LayoutVersion; ///< The version of the raw element layout, checked against the running build. 0 for cereal blocks.
+        uint32_t Reserved;
+        uint64_t Offset; ///< Offset of the block from the start of the file, 16-byte aligned.
+        uint64_t Size; ///< Size of the block in bytes.
+    };
+
+    /**
+     * @brief Saves and loads scenes in the binary scene format.
+     *
+     * The file is a BinarySceneHeader, one block per component type, the string table with the entity names and the
+     * block table. Loading maps the file and inserts each block into the registry in bulk, the plain components
+     * (transforms, hierarchy, lights) are copied straight from the mapping. Raw blocks are only readable by builds
+     * with the same component layout; keep the JSON scenes in version control and convert them for shipping.
+     */
+    class BinarySceneSerializer
+    {
+    public:
+        static constexpr char Magic[8] = {'T', 'E', 'A', 'S', 'C', 'E', 'N', 'E'};
+        static constexpr uint32_t Version = 2;
+
+        /**
+         * @brief Checks whether a file is a binary scene, from its first bytes.
+         * @param path The path to the file.
+         * @return True if the file starts with the binary scene magic.
+         */
+        static bool IsBinaryScene(const std::filesystem::path& path);
+
+        /**
+         * @brief Saves a scene to a binary file.
+         * @param path The path to the file.
+         * @param scene The scene to save.
+         * @return True if the file was written.
+         */
+        static bool Save(const std::filesystem::path& path, const Ref<Scene>& scene);
+
+        /**
+         * @brief Loads a scene from a binary file.
+         * @param path The path to the file.
+         * @return The loaded scene, or nullptr if the file is not a valid binary scene.
+         */
+        static Ref<Scene> Load(const std::filesystem::path& path);
+    };
+
+    /** @} */ // end of scene group
+}
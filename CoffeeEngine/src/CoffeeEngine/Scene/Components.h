@@ -18,6 +18,7 @@
 #include <glm/fwd.hpp>
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include <atomic>
 #include "CoffeeEngine/Scripting/Script.h"
 #include "CoffeeEngine/Scripting/ScriptManager.h"
 #include "src/CoffeeEngine/IO/Serialization/GLMSerialization.h"
@@ -60,12 +61,22 @@ namespace Coffee {
 
     /**
      * @brief Component representing a transform.
+     *
+     * The world matrix is only recomputed by the SceneTree when the transform is dirty or its parent changed.
+     * Position, Rotation and Scale are public for the editor and the serializer; code that writes them directly
+     * has to call MarkDirty, the setters do it themselves.
+     *
      * @ingroup scene
      */
     struct TransformComponent
     {
     private:
         glm::mat4 worldMatrix = glm::mat4(1.0f); ///< The world transformation matrix.
+        bool dirty = true; ///< Whether the local transform changed since the world matrix was computed.
+
+        static inline std::atomic<uint32_t> s_DirtyCount = 0; ///< Bumped every time a clean transform becomes dirty.
+
+        friend class SceneTree; ///< Writes the world matrices computed in its TransformStore.
     public:
         glm::vec3 Position = { 0.0f, 0.0f, 0.0f }; ///< The position vector.
         glm::vec3 Rotation = { 0.0f, 0.0f, 0.0f }; ///< The rotation vector.
@@ -82,11 +93,13 @@ namespace Coffee {
          */
         glm::mat4 GetLocalTransform() const
         {
-            glm::mat4 rotation = glm::toMat4(glm::quat(glm::radians(Rotation)));
-
-            return glm::translate(glm::mat4(1.0f), Position)
-                    * rotation
-                    * glm::scale(glm::mat4(1.0f), Scale);
+            // Same as translate * rotate * scale, without the two matrix products
+            glm::mat4 transform = glm::toMat4(glm::quat(glm::radians(Rotation)));
+            transform[0] *= Scale.x;
+            transform[1] *= Scale.y;
+            transform[2] *= Scale.z;
+            transform[3] = glm::vec4(Position, 1.0f);
+            return transform;
         }
 
         /**
@@ -101,6 +114,71 @@ namespace Coffee {
 
             glm::decompose(transform, Scale, orientation, Position, skew, perspective);
             Rotation = glm::degrees(glm::eulerAngles(orientation));
+            MarkDirty();
+        }
+
+        /**
+         * @brief Sets the position and marks the transform dirty.
+         * @param position The new position.
+         */
+        void SetPosition(const glm::vec3& position)
+        {
+            Position = position;
+            MarkDirty();
+        }
+
+        /**
+         * @brief Sets the rotation and marks the transform dirty.
+         * @param rotation The new rotation, in degrees.
+         */
+        void SetRotation(const glm::vec3& rotation)
+        {
+            Rotation = rotation;
+            MarkDirty();
+        }
+
+        /**
+         * @brief Sets the scale and marks the transform dirty.
+         * @param scale The new scale.
+         */
+        void SetScale(const glm::vec3& scale)
+        {
+            Scale = scale;
+            MarkDirty();
+        }
+
+        /**
+         * @brief Marks the transform dirty, so its world matrix is recomputed on the next SceneTree update.
+         */
+        void MarkDirty()
+        {
+            if (!dirty)
+            {
+                dirty = true;
+                s_DirtyCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Checks whether the world matrix is outdated.
+         * @return True if the local transform changed since the last update.
+         */
+        bool IsDirty() const
+        {
+            return dirty;
+        }
+
+        /**
+         * @brief Gets how many times a transform of any scene went from clean to dirty.
+         *
+         * The SceneTree compares it with the value it saw on its last update to skip frames where nothing moved,
+         * without scanning the components.
+         *
+         * @return The number of clean to dirty transitions so far.
+         */
+        static uint32_t GetDirtyCount()
+        {
+            return s_DirtyCount.load(std::memory_order_relaxed);
         }
 
         /**
@@ -113,12 +191,16 @@ namespace Coffee {
         }
 
         /**
-         * @brief Sets the world transformation matrix.
-         * @param transform The transformation matrix to set.
+         * @brief Moves the transform so its world matrix becomes the given one, by setting the local transform.
+         *
+         * The world matrix itself is written by the next SceneTree update, with the descendants.
+         *
+         * @param transform The new world transformation matrix.
+         * @param parentWorld The world transformation matrix of the parent, identity for roots.
          */
-        void SetWorldTransform(const glm::mat4& transform)
+        void SetWorldTransform(const glm::mat4& transform, const glm::mat4& parentWorld)
         {
-            worldMatrix = transform * GetLocalTransform();
+            SetLocalTransform(glm::inverse(parentWorld) * transform);
         }
 
         /**
@@ -325,7 +407,7 @@ namespace Coffee {
                 isPaused = other.isPaused;
                 toDelete = other.toDelete;
 
-                if (!toDelete)
+                if (!toDelete && Audio::IsRegistrationEnabled())
                 {
                     Audio::RegisterAudioSourceComponent(*this);
                     AudioZone::RegisterObject(gameObjectID, transform[3]);
@@ -384,7 +466,7 @@ namespace Coffee {
                 transform = other.transform;
                 toDelete = other.toDelete;
 
-                if (!toDelete)
+                if (!toDelete && Audio::IsRegistrationEnabled())
                     Audio::RegisterAudioListenerComponent(*this);
             }
             return *this;
@@ -430,7 +512,8 @@ namespace Coffee {
                 position = other.position;
                 radius = other.radius;
 
-                AudioZone::CreateZone(*this);
+                if (Audio::IsRegistrationEnabled())
+                    AudioZone::CreateZone(*this);
             }
             return *this;
         }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CoffeeEngine/Core/Assert.h"
+#include "CoffeeEngine/Scene/Components.h"
 #include "CoffeeEngine/Scene/Scene.h"
 #include "CoffeeEngine/Scene/SceneTree.h"
 #include "entt/entity/entity.hpp"
@@ -135,6 +136,26 @@ namespace Coffee {
            HierarchyComponent::Reparent(m_Scene->m_Registry, m_EntityHandle, entity);
         }
 
+        /**
+         * @brief Set the name (the TagComponent) of the entity, and update the scene's tag index.
+         * @param name The new name.
+         */
+        void SetName(const std::string& name)
+        {
+            m_Scene->m_Registry.patch<TagComponent>(m_EntityHandle, [&name](TagComponent& tag) { tag.Tag = name; });
+        }
+
+        /**
+         * @brief Moves the entity so its world transform becomes the given one. Applied on the next scene tree update.
+         * @param transform The new world transformation matrix.
+         */
+        void SetWorldTransform(const glm::mat4& transform)
+        {
+            const entt::entity parent = GetComponent<HierarchyComponent>().m_Parent;
+            const glm::mat4 parentWorld = parent != entt::null ? m_Scene->m_Registry.get<TransformComponent>(parent).GetWorldTransform() : glm::mat4(1.0f);
+            GetComponent<TransformComponent>().SetWorldTransform(transform, parentWorld);
+        }
+
         Entity GetParent()
         {
             const auto& hierarchyComponent = GetComponent<HierarchyComponent>();
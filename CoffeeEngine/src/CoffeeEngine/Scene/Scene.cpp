@@ -2,13 +2,16 @@
 
 #include "CoffeeEngine/Core/Base.h"
 #include "CoffeeEngine/Core/DataStructures/Octree.h"
+#include "CoffeeEngine/Core/FrameProfiler.h"
 #include "CoffeeEngine/Core/Log.h"
+#include "CoffeeEngine/Core/MemoryTracker.h"
 #include "CoffeeEngine/Math/Frustum.h"
 #include "CoffeeEngine/Renderer/DebugRenderer.h"
 #include "CoffeeEngine/Renderer/EditorCamera.h"
 #include "CoffeeEngine/Renderer/Material.h"
 #include "CoffeeEngine/Renderer/Mesh.h"
 #include "CoffeeEngine/Renderer/Renderer.h"
+#include "CoffeeEngine/Scene/BinarySceneSerializer.h"
 #include "CoffeeEngine/Scene/Components.h"
 #include "CoffeeEngine/Scene/Entity.h"
 #include "CoffeeEngine/Scene/PrimitiveMesh.h"
@@ -25,7 +28,8 @@
 #include <glm/fwd.hpp>
 #include <memory>
 #include <string>
-#include <tracy/Tracy.hpp>
+#include <unordered_map>
+#include <vector>
 
 #include <CoffeeEngine/Scripting/Script.h>
 #include <cereal/archives/json.hpp>
@@ -33,64 +37,71 @@
 
 namespace Coffee {
 
-    Scene::Scene() : m_Octree({glm::vec3(-50.0f), glm::vec3(50.0f)}, 10, 5)
+    // Components that only follow changed transforms need one update when they're added
+    static void MarkTransformDirty(entt::registry& registry, entt::entity entity)
     {
-        m_SceneTree = CreateScope<SceneTree>(this);
+        if(auto transformComponent = registry.try_get<TransformComponent>(entity))
+        {
+            transformComponent->MarkDirty();
+        }
     }
 
-/*     Scene::Scene(Ref<Scene> other)
+    Scene::Scene() : m_Octree({glm::vec3(-50.0f), glm::vec3(50.0f)}, 10, 5)
     {
-        auto& srcRegistry = other->m_Registry;
-        auto& dstRegistry = m_Registry;
+        COFFEE_MEMORY_TAG(MemoryTag::Scene);
 
-        auto view = srcRegistry.view<entt::entity>();
-        dstRegistry.insert(view->data(), view->data() + view->size(), view->raw(), view->raw() + view.size());
-    } */
+        m_SceneTree = CreateScope<SceneTree>(this);
+        m_TagIndex = CreateScope<TagIndex>(m_Registry);
+
+        m_Registry.on_construct<AudioSourceComponent>().connect<&MarkTransformDirty>();
+        m_Registry.on_construct<AudioListenerComponent>().connect<&MarkTransformDirty>();
+    }
 
     Entity Scene::CreateEntity(const std::string& name)
     {
         ZoneScoped;
+        COFFEE_MEMORY_TAG(MemoryTag::Scene);
 
         Entity entity = { m_Registry.create(), this };
         entity.AddComponent<TransformComponent>();
-        auto& nameTag = entity.AddComponent<TagComponent>();
-        nameTag.Tag = name.empty() ? "Entity" : name;
+        // Set the name on construction, the tag index reads it from the construct signal
+        entity.AddComponent<TagComponent>(name.empty() ? "Entity" : name);
         entity.AddComponent<HierarchyComponent>();
         return entity;
     }
 
     void Scene::DestroyEntity(Entity entity)
     {
-        auto& hierarchyComponent = m_Registry.get<HierarchyComponent>(entity);
-        auto curr = hierarchyComponent.m_First;
+        COFFEE_MEMORY_TAG(MemoryTag::Scene);
+
+        auto& hierarchies = m_Registry.storage<HierarchyComponent>();
 
-        while(curr != entt::null)
+        // Collect the subtree parents first, then destroy it backwards so every entity is unlinked from a parent
+        // that is still alive
+        std::vector<entt::entity> subtree;
+        subtree.push_back(entity);
+        for(size_t i = 0; i < subtree.size(); i++)
         {
-            Entity e{curr, this};
-            curr = m_Registry.get<HierarchyComponent>(curr).m_Next;
-            DestroyEntity(e);
+            for(entt::entity child = hierarchies.get(subtree[i]).m_First; child != entt::null; child = hierarchies.get(child).m_Next)
+            {
+                subtree.push_back(child);
+            }
         }
 
-        m_Registry.destroy((entt::entity)entity);
-    }
-
-    Entity Scene::GetEntityByName(const std::string& name)
-    {
-        auto view = m_Registry.view<TagComponent>();
-
-        for(auto entity : view)
+        for(auto it = subtree.rbegin(); it != subtree.rend(); ++it)
         {
-            auto& tag = view.get<TagComponent>(entity).Tag;
-            if(tag == name)
-                return Entity{entity, this};
+            m_Registry.destroy(*it);
         }
+    }
 
-        return Entity{entt::null, this};
+    Entity Scene::GetEntityByName(std::string_view name)
+    {
+        return Entity{m_TagIndex->Find(name), this};
     }
 
-    std::vector<Entity> Scene::GetAllEntities()
+    FrameVector<Entity> Scene::GetAllEntities()
     {
-        std::vector<Entity> entities;
+        FrameVector<Entity> entities;
 
         auto view = m_Registry.view<entt::entity>();
 
@@ -105,6 +116,7 @@ namespace Coffee {
     void Scene::OnInitEditor()
     {
         ZoneScoped;
+        COFFEE_MEMORY_TAG(MemoryTag::Scene);
 
        /*  Entity light = CreateEntity("Directional Light");
         light.AddComponent<LightComponent>().Color = {1.0f, 0.9f, 0.85f};
@@ -130,6 +142,7 @@ namespace Coffee {
     void Scene::OnInitRuntime()
     {
         ZoneScoped;
+        COFFEE_MEMORY_TAG(MemoryTag::Scene);
 
         m_SceneTree->Update();
 
@@ -167,6 +180,7 @@ namespace Coffee {
     void Scene::OnUpdateEditor(EditorCamera& camera, float dt)
     {
         ZoneScoped;
+        COFFEE_MEMORY_TAG(MemoryTag::Scene);
 
         m_SceneTree->Update();
 
@@ -216,6 +230,7 @@ namespace Coffee {
     void Scene::OnUpdateRuntime(float dt)
     {
         ZoneScoped;
+        COFFEE_MEMORY_TAG(MemoryTag::Scene);
 
         m_SceneTree->Update();
 
@@ -305,11 +320,6 @@ namespace Coffee {
         Renderer::EndScene();
     }
 
-    void Scene::OnEvent(Event& e)
-    {
-        ZoneScoped;
-    }
-
     void Scene::OnExitEditor()
     {
         ZoneScoped;
@@ -318,17 +328,39 @@ namespace Coffee {
     void Scene::OnExitRuntime()
     {
         Audio::StopAllEvents();
+
+        // Timers scheduled by the scripts must not fire once the runtime is stopped
+        auto scriptView = m_Registry.view<ScriptComponent>();
+
+        for (auto& entity : scriptView)
+        {
+            auto& scriptComponent = scriptView.get<ScriptComponent>(entity);
+
+            if(auto luaScript = std::dynamic_pointer_cast<LuaScript>(scriptComponent.script))
+            {
+                luaScript->CancelTimers();
+            }
+        }
     }
 
     Ref<Scene> Scene::Load(const std::filesystem::path& path)
     {
         ZoneScoped;
+        COFFEE_MEMORY_TAG(MemoryTag::Scene);
+
+        if(BinarySceneSerializer::IsBinaryScene(path))
+        {
+            return BinarySceneSerializer::Load(path);
+        }
 
         Ref<Scene> scene = CreateRef<Scene>();
 
         std::ifstream sceneFile(path);
         cereal::JSONInputArchive archive(sceneFile);
 
+        // The files store the child lists, don't let OnConstruct append the entities to their parents again
+        scene->m_Registry.on_construct<HierarchyComponent>().disconnect<&HierarchyComponent::OnConstruct>();
+
         entt::snapshot_loader{scene->m_Registry}
             .get<entt::entity>(archive)
             .get<TagComponent>(archive)
@@ -342,6 +374,9 @@ namespace Coffee {
             .get<AudioSourceComponent>(archive)
             .get<AudioListenerComponent>(archive)
             .get<AudioZoneComponent>(archive);
+
+        scene->m_Registry.on_construct<HierarchyComponent>().connect<&HierarchyComponent::OnConstruct>();
+        HierarchyComponent::RebuildChildLinks(scene->m_Registry);
         
         scene->m_FilePath = path;
 
@@ -362,11 +397,190 @@ namespace Coffee {
         return scene;
     }
 
-    void Scene::Save(const std::filesystem::path& path, Ref<Scene> scene)
+    // Copies a component for Scene::Copy. Resources behind a Ref are immutable at runtime, so sharing them is enough
+    template<typename Component>
+    static Component CloneComponent(const Component& component)
+    {
+        return component;
+    }
+
+    // Scripts hold their Lua state, the runtime scene needs its own
+    static ScriptComponent CloneComponent(const ScriptComponent& component)
+    {
+        ScriptComponent clone;
+        if(component.script)
+        {
+            clone.script = ScriptManager::CreateScript(component.script->GetPath(), ScriptingLanguage::Lua);
+        }
+        return clone;
+    }
+
+    /**
+     * @brief In-memory archive for entt::snapshot and entt::snapshot_loader.
+     *
+     * The entity identifiers and counts go to a flat array and every component type gets its own array of copies,
+     * read back in the order they were written.
+     */
+    class SceneCloneArchive
+    {
+      public:
+        using EntityType = entt::entt_traits<entt::entity>::entity_type;
+
+        class Writer
+        {
+          public:
+            Writer(SceneCloneArchive& archive) : m_Archive(archive) {}
+
+            void operator()(EntityType value) { m_Archive.m_Values.push_back(value); }
+            void operator()(entt::entity entity) { m_Archive.m_Values.push_back(entt::to_integral(entity)); }
+
+            template<typename Component>
+            void operator()(const Component& component)
+            {
+                m_Archive.GetBuffer<Component>().Components.push_back(CloneComponent(component));
+            }
+
+            template<typename First, typename... Others>
+                requires(sizeof...(Others) > 0)
+            void operator()(const First& first, const Others&... others)
+            {
+                (*this)(first);
+                ((*this)(others), ...);
+            }
+
+          private:
+            SceneCloneArchive& m_Archive;
+        };
+
+        class Reader
+        {
+          public:
+            Reader(SceneCloneArchive& archive) : m_Archive(archive) {}
+
+            void operator()(EntityType& value) { value = m_Archive.m_Values[m_NextValue++]; }
+            void operator()(entt::entity& entity) { entity = entt::entity{m_Archive.m_Values[m_NextValue++]}; }
+
+            template<typename Component>
+            void operator()(Component& component)
+            {
+                auto& buffer = m_Archive.GetBuffer<Component>();
+                component = std::move(buffer.Components[buffer.Next++]);
+            }
+
+            // The loader reads an entity and its component in one call
+            template<typename First, typename... Others>
+                requires(sizeof...(Others) > 0)
+            void operator()(First& first, Others&... others)
+            {
+                (*this)(first);
+                ((*this)(others), ...);
+            }
+
+          private:
+            SceneCloneArchive& m_Archive;
+            size_t m_NextValue = 0;
+        };
+
+      private:
+        struct BufferBase
+        {
+            virtual ~BufferBase() = default;
+        };
+
+        template<typename Component>
+        struct Buffer : BufferBase
+        {
+            std::vector<Component> Components;
+            size_t Next = 0;
+        };
+
+        template<typename Component>
+        Buffer<Component>& GetBuffer()
+        {
+            auto& buffer = m_Buffers[entt::type_hash<Component>::value()];
+            if(!buffer)
+            {
+                buffer = CreateScope<Buffer<Component>>();
+            }
+            return static_cast<Buffer<Component>&>(*buffer);
+        }
+
+        std::vector<EntityType> m_Values;
+        std::unordered_map<entt::id_type, Scope<BufferBase>> m_Buffers;
+    };
+
+    Ref<Scene> Scene::Copy(const Ref<Scene>& other)
     {
         ZoneScoped;
+        COFFEE_MEMORY_TAG(MemoryTag::Scene);
+
+        Ref<Scene> scene = CreateRef<Scene>();
+
+        SceneCloneArchive archive;
+        SceneCloneArchive::Writer writer(archive);
+
+        entt::snapshot{other->m_Registry}
+            .get<entt::entity>(writer)
+            .get<TagComponent>(writer)
+            .get<TransformComponent>(writer)
+            .get<HierarchyComponent>(writer)
+            .get<CameraComponent>(writer)
+            .get<MeshComponent>(writer)
+            .get<MaterialComponent>(writer)
+            .get<LightComponent>(writer)
+            .get<ScriptComponent>(writer)
+            .get<AudioSourceComponent>(writer)
+            .get<AudioListenerComponent>(writer)
+            .get<AudioZoneComponent>(writer);
+
+        // The child lists are copied whole, don't let OnConstruct append the entities to their parents again
+        scene->m_Registry.on_construct<HierarchyComponent>().disconnect<&HierarchyComponent::OnConstruct>();
+
+        SceneCloneArchive::Reader reader(archive);
+
+        entt::snapshot_loader{scene->m_Registry}
+            .get<entt::entity>(reader)
+            .get<TagComponent>(reader)
+            .get<TransformComponent>(reader)
+            .get<HierarchyComponent>(reader)
+            .get<CameraComponent>(reader)
+            .get<MeshComponent>(reader)
+            .get<MaterialComponent>(reader)
+            .get<LightComponent>(reader)
+            .get<ScriptComponent>(reader)
+            .get<AudioSourceComponent>(reader)
+            .get<AudioListenerComponent>(reader)
+            .get<AudioZoneComponent>(reader);
+
+        scene->m_Registry.on_construct<HierarchyComponent>().connect<&HierarchyComponent::OnConstruct>();
+
+        scene->m_FilePath = other->m_FilePath;
+
+        for (auto& audioSource : Audio::audioSources)
+        {
+            Audio::SetVolume(audioSource->gameObjectID, audioSource->mute ? 0.f : audioSource->volume);
+        }
+
+        return scene;
+    }
+
+    bool Scene::Save(const std::filesystem::path& path, Ref<Scene> scene, ResourceFormat format)
+    {
+        ZoneScoped;
+        COFFEE_MEMORY_TAG(MemoryTag::Scene);
+
+        if(format == ResourceFormat::Binary)
+        {
+            return BinarySceneSerializer::Save(path, scene);
+        }
 
         std::ofstream sceneFile(path);
+        if(!sceneFile)
+        {
+            COFFEE_CORE_ERROR("Scene::Save: Could not write {0}", path.string());
+            return false;
+        }
+
         cereal::JSONOutputArchive archive(sceneFile);
 
         //archive(*scene);
@@ -396,79 +610,114 @@ namespace Coffee {
 
             COFFEE_INFO("Entity {0}, {1}", (uint32_t)entity, tag.Tag);
         }
+
+        return true;
+    }
+
+    bool Scene::Convert(const std::filesystem::path& source, const std::filesystem::path& destination, ResourceFormat format)
+    {
+        ZoneScoped;
+
+        // The scene is dropped once saved, its audio components must not leave pointers in the audio system
+        Audio::SuspendRegistration();
+
+        bool saved = false;
+        Ref<Scene> scene = Load(source);
+        if(!scene)
+        {
+            COFFEE_CORE_ERROR("Scene::Convert: Could not load {0}", source.string());
+        }
+        else
+        {
+            saved = Save(destination, scene, format);
+            scene.reset();
+        }
+
+        Audio::ResumeRegistration();
+        return saved;
     }
 
     // Is possible that this function will be moved to the SceneTreePanel but for now it will stay here
     void AddModelToTheSceneTree(Scene* scene, Ref<Model> model)
     {
-        static Entity parent;
-
-        Entity modelEntity = scene->CreateEntity(model->GetName());
+        ZoneScoped;
+        COFFEE_MEMORY_TAG(MemoryTag::Scene);
 
-        if((entt::entity)parent != entt::null)modelEntity.SetParent(parent);
-        modelEntity.GetComponent<TransformComponent>().SetLocalTransform(model->GetTransform());
+        struct PendingModel
+        {
+            Ref<Model> Source;
+            entt::entity Parent;
+        };
 
-        auto& meshes = model->GetMeshes();
-        bool hasMultipleMeshes = meshes.size() > 1;
+        // Walk the model tree with an explicit stack; deep imported hierarchies would overflow the call stack
+        std::vector<PendingModel> stack;
+        stack.push_back({model, entt::null});
+        std::vector<entt::entity> children;
 
-        for(auto& mesh : meshes)
+        while(!stack.empty())
         {
-            Entity entity = hasMultipleMeshes ? scene->CreateEntity(mesh->GetName()) : modelEntity;
+            PendingModel current = std::move(stack.back());
+            stack.pop_back();
+
+            Entity modelEntity = scene->CreateEntity(current.Source->GetName());
 
-            entity.AddComponent<MeshComponent>(mesh);
+            if(current.Parent != entt::null) modelEntity.SetParent(Entity{current.Parent, scene});
+            modelEntity.GetComponent<TransformComponent>().SetLocalTransform(current.Source->GetTransform());
 
-            if(mesh->GetMaterial())
+            auto& meshes = current.Source->GetMeshes();
+            bool hasMultipleMeshes = meshes.size() > 1;
+
+            children.clear();
+            for(auto& mesh : meshes)
             {
-                entity.AddComponent<MaterialComponent>(mesh->GetMaterial());
+                Entity entity = hasMultipleMeshes ? scene->CreateEntity(mesh->GetName()) : modelEntity;
+
+                entity.AddComponent<MeshComponent>(mesh);
+
+                if(mesh->GetMaterial())
+                {
+                    entity.AddComponent<MaterialComponent>(mesh->GetMaterial());
+                }
+
+                if(hasMultipleMeshes)
+                {
+                    children.push_back((entt::entity)entity);
+                }
             }
+            HierarchyComponent::AttachChildren(scene->m_Registry, (entt::entity)modelEntity, children);
 
-            if(hasMultipleMeshes)
+            // Pushed backwards, so the child models are created (and attached) in their original order
+            const auto& childModels = current.Source->GetChildren();
+            for(auto it = childModels.rbegin(); it != childModels.rend(); ++it)
             {
-                entity.SetParent(modelEntity);
+                stack.push_back({*it, (entt::entity)modelEntity});
             }
         }
-
-        for(auto& c : model->GetChildren())
-        {
-            parent = modelEntity;
-            AddModelToTheSceneTree(scene, c);
-        }
     }
 
     void Scene::UpdateAudioComponentsPositions()
     {
-        auto audioSourceView = m_Registry.view<AudioSourceComponent, TransformComponent>();
-
-        for (auto& entity : audioSourceView)
+        for (auto entity : m_SceneTree->GetChangedTransforms())
         {
-            auto& audioSourceComponent = audioSourceView.get<AudioSourceComponent>(entity);
-            auto& transformComponent = audioSourceView.get<TransformComponent>(entity);
+            const auto& transformComponent = m_Registry.get<TransformComponent>(entity);
 
-            if (audioSourceComponent.transform != transformComponent.GetWorldTransform())
+            if (auto audioSourceComponent = m_Registry.try_get<AudioSourceComponent>(entity))
             {
-                audioSourceComponent.transform = transformComponent.GetWorldTransform();
+                audioSourceComponent->transform = transformComponent.GetWorldTransform();
 
-                Audio::Set3DPosition(audioSourceComponent.gameObjectID,
+                Audio::Set3DPosition(audioSourceComponent->gameObjectID,
                 transformComponent.GetWorldTransform()[3],
                 glm::normalize(glm::vec3(transformComponent.GetWorldTransform()[2])),
                 glm::normalize(glm::vec3(transformComponent.GetWorldTransform()[1]))
                 );
-                AudioZone::UpdateObjectPosition(audioSourceComponent.gameObjectID, transformComponent.GetWorldTransform()[3]);
+                AudioZone::UpdateObjectPosition(audioSourceComponent->gameObjectID, transformComponent.GetWorldTransform()[3]);
             }
-        }
-
-        auto audioListenerView = m_Registry.view<AudioListenerComponent, TransformComponent>();
-
-        for (auto& entity : audioListenerView)
-        {
-            auto& audioListenerComponent = audioListenerView.get<AudioListenerComponent>(entity);
-            auto& transformComponent = audioListenerView.get<TransformComponent>(entity);
 
-            if (audioListenerComponent.transform != transformComponent.GetWorldTransform())
+            if (auto audioListenerComponent = m_Registry.try_get<AudioListenerComponent>(entity))
             {
-                audioListenerComponent.transform = transformComponent.GetWorldTransform();
+                audioListenerComponent->transform = transformComponent.GetWorldTransform();
 
-                Audio::Set3DPosition(audioListenerComponent.gameObjectID,
+                Audio::Set3DPosition(audioListenerComponent->gameObjectID,
                     transformComponent.GetWorldTransform()[3],
                     glm::normalize(glm::vec3(transformComponent.GetWorldTransform()[2])),
                     glm::normalize(glm::vec3(transformComponent.GetWorldTransform()[1]))
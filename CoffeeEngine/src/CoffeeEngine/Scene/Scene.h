@@ -1,14 +1,19 @@
 #pragma once
 
 #include "CoffeeEngine/Core/DataStructures/Octree.h"
+#include "CoffeeEngine/Core/FrameAllocator.h"
 #include "CoffeeEngine/Events/Event.h"
+#include "CoffeeEngine/IO/ResourceFormat.h"
 #include "CoffeeEngine/Renderer/EditorCamera.h"
 #include "CoffeeEngine/Scene/SceneTree.h"
+#include "CoffeeEngine/Scene/TagIndex.h"
 #include "entt/entity/fwd.hpp"
 
 #include <entt/entt.hpp>
 #include <filesystem>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace Coffee {
@@ -38,7 +43,16 @@ namespace Coffee {
          */
         ~Scene() = default;
 
-        //Scene(Ref<Scene> other);
+        /**
+         * @brief Copy a scene in memory, for entering play mode without touching the edited scene.
+         *
+         * The registry goes through an in-memory EnTT snapshot, so the copy keeps the same entity identifiers.
+         * Components are copied one by one; meshes, materials and audio banks are shared, scripts are created again.
+         *
+         * @param other The scene to copy.
+         * @return The copy.
+         */
+        static Ref<Scene> Copy(const Ref<Scene>& other);
 
         /**
          * @brief Create an entity in the scene.
@@ -53,9 +67,36 @@ namespace Coffee {
          */
         void DestroyEntity(Entity entity);
 
-        Entity GetEntityByName(const std::string& name);
+        /**
+         * @brief Get the first entity with a name. Looked up in the tag index, so it costs the same in any scene.
+         * @param name The name.
+         * @return The entity, or an invalid entity if no entity has that name.
+         */
+        Entity GetEntityByName(std::string_view name);
+
+        /**
+         * @brief Get every entity with a name.
+         * @param name The name.
+         * @return The entities, in the order of TagIndex::FindAll. Valid until the next entity creation, destruction or rename.
+         */
+        std::span<const entt::entity> GetEntitiesByName(std::string_view name) const { return m_TagIndex->FindAll(name); }
 
-        std::vector<Entity> GetAllEntities();
+        /**
+         * @brief Call a function for every entity whose name starts with a prefix.
+         * @param prefix The prefix.
+         * @param function The function, called with the entt::entity of every match, in name order.
+         */
+        template<typename Function>
+        void ForEachEntityWithNamePrefix(std::string_view prefix, Function&& function) const
+        {
+            m_TagIndex->ForEachWithPrefix(prefix, std::forward<Function>(function));
+        }
+
+        /**
+         * @brief Get every entity of the scene.
+         * @return The entities. Allocated from the frame arena, so don't keep it beyond the next frame.
+         */
+        FrameVector<Entity> GetAllEntities();
 
         template<typename... Components>
         auto GetAllEntitiesWithComponents()
@@ -82,12 +123,6 @@ namespace Coffee {
          */
         void OnUpdateRuntime(float dt);
 
-        /**
-         * @brief Handle an event in the scene.
-         * @param e The event.
-         */
-        void OnEvent(Event& e);
-
         /**
          * @brief Exit the scene.
          */
@@ -95,9 +130,9 @@ namespace Coffee {
         void OnExitRuntime();
 
         /**
-         * @brief Load a scene from a file.
+         * @brief Load a scene from a file, JSON or binary (detected from the first bytes).
          * @param path The path to the file.
-         * @return The loaded scene.
+         * @return The loaded scene, or nullptr if a binary file can't be read.
          */
         static Ref<Scene> Load(const std::filesystem::path& path);
 
@@ -105,18 +140,42 @@ namespace Coffee {
          * @brief Save a scene to a file.
          * @param path The path to the file.
          * @param scene The scene to save.
+         * @param format JSON to keep scenes diffable in version control, Binary for fast loading.
+         * @return True if the file was written.
+         */
+        static bool Save(const std::filesystem::path& path, Ref<Scene> scene, ResourceFormat format = ResourceFormat::JSON);
+
+        /**
+         * @brief Convert a scene file between the JSON and the binary formats.
+         * @param source The scene to convert, in either format.
+         * @param destination The path of the converted scene.
+         * @param format The format of the converted scene.
+         * @return True if the scene was converted.
          */
-        static void Save(const std::filesystem::path& path, Ref<Scene> scene);
+        static bool Convert(const std::filesystem::path& source, const std::filesystem::path& destination, ResourceFormat format);
 
         /**
-         * @brief Update the positions of the audio components.
+         * @brief Update the positions of the audio components whose transform changed this frame.
          */
         void UpdateAudioComponentsPositions();
 
+        /**
+         * @brief Get the entities whose world transform changed in the last scene tree update.
+         * @return The entities. Valid until the next update.
+         */
+        const std::vector<entt::entity>& GetChangedTransforms() const { return m_SceneTree->GetChangedTransforms(); }
+
+        /**
+         * @brief Get the scene tree, which updates the world transforms.
+         * @return The scene tree.
+         */
+        SceneTree& GetSceneTree() { return *m_SceneTree; }
+
         const std::filesystem::path& GetFilePath() { return m_FilePath; }
     private:
         entt::registry m_Registry;
         Scope<SceneTree> m_SceneTree;
+        Scope<TagIndex> m_TagIndex;
         Octree<Ref<Mesh>> m_Octree;
 
         // Temporal: Scenes should be Resources and the Base Resource class already has a path variable.
@@ -124,7 +183,9 @@ namespace Coffee {
 
         friend class Entity;
         friend class SceneTree;
+        friend class BinarySceneSerializer;
         friend class SceneTreePanel;
+        friend void AddModelToTheSceneTree(Scene* scene, Ref<Model> model);
 
         //REMOVE PLEASE, THIS IS ONLY TO TEST THE OCTREE!!!!
         friend class EditorLayer;
@@ -1,10 +1,14 @@
 #include "SceneTree.h"
+#include "CoffeeEngine/Core/FrameProfiler.h"
+#include "CoffeeEngine/Core/JobSystem.h"
 #include "CoffeeEngine/Core/Log.h"
+#include "CoffeeEngine/Core/MemoryTracker.h"
 #include "CoffeeEngine/Scene/Components.h"
 #include "CoffeeEngine/Scene/Scene.h"
 #include "entt/entity/entity.hpp"
 #include "entt/entity/fwd.hpp"
-#include <tracy/Tracy.hpp>
+
+#include <span>
 
 namespace Coffee {
 
@@ -12,95 +16,75 @@ namespace Coffee {
     {
         m_Parent = parent;
         m_First = entt::null;
+        m_Last = entt::null;
         m_Next = entt::null;
         m_Prev = entt::null;
+        m_ChildCount = 0;
     }
     HierarchyComponent::HierarchyComponent()
     {
         m_Parent = entt::null;
         m_First = entt::null;
+        m_Last = entt::null;
         m_Next = entt::null;
         m_Prev = entt::null;
+        m_ChildCount = 0;
     }
 
     void HierarchyComponent::OnConstruct(entt::registry& registry, entt::entity entity)
     {
         auto& hierarchy = registry.get<HierarchyComponent>(entity);
 
-        if(hierarchy.m_Parent != entt::null)
+        if(hierarchy.m_Parent == entt::null)
         {
-            auto& parentHierarchy = registry.get<HierarchyComponent>(hierarchy.m_Parent);
-
-            if(parentHierarchy.m_First == entt::null)
-            {
-                parentHierarchy.m_First = entity;
-            }
-            else
-            {
-                //Get the last child of the parent
-                auto lastEntity = parentHierarchy.m_First;
-                auto lastHierarchy = registry.try_get<HierarchyComponent>(lastEntity);
-                while(lastHierarchy != nullptr && lastHierarchy->m_Next != entt::null)
-                {
-                    auto nextEntity = lastHierarchy->m_Next;
-                    auto nextHierarchy = registry.try_get<HierarchyComponent>(nextEntity);
-
-                    if(nextHierarchy == nullptr)
-                    {
-                        break;
-                    }
+            return;
+        }
 
-                    lastEntity = nextEntity;
-                    lastHierarchy = nextHierarchy;
-                }
-                if (lastEntity == entity)
-                {
-                    return;
-                }
-                lastHierarchy->m_Next = entity;
-                lastHierarchy->m_Prev = lastEntity;
-            }
+        // Append after the last child
+        auto& parentHierarchy = registry.get<HierarchyComponent>(hierarchy.m_Parent);
+        if(parentHierarchy.m_Last == entt::null)
+        {
+            parentHierarchy.m_First = entity;
+        }
+        else
+        {
+            registry.get<HierarchyComponent>(parentHierarchy.m_Last).m_Next = entity;
+            hierarchy.m_Prev = parentHierarchy.m_Last;
         }
+        parentHierarchy.m_Last = entity;
+        parentHierarchy.m_ChildCount++;
     }
 
     void HierarchyComponent::OnDestroy(entt::registry& registry, entt::entity entity)
     {
         auto& hierarchy = registry.get<HierarchyComponent>(entity);
-        // if is the first child
-        if(hierarchy.m_Prev == entt::null || !registry.valid(hierarchy.m_Prev))
+
+        auto parentHierarchy = (hierarchy.m_Parent != entt::null && registry.valid(hierarchy.m_Parent)) ? registry.try_get<HierarchyComponent>(hierarchy.m_Parent) : nullptr;
+        auto prevHierarchy = (hierarchy.m_Prev != entt::null && registry.valid(hierarchy.m_Prev)) ? registry.try_get<HierarchyComponent>(hierarchy.m_Prev) : nullptr;
+        auto nextHierarchy = (hierarchy.m_Next != entt::null && registry.valid(hierarchy.m_Next)) ? registry.try_get<HierarchyComponent>(hierarchy.m_Next) : nullptr;
+
+        // Unlink from the siblings, or from the ends of the parent's list
+        if(prevHierarchy != nullptr)
         {
-            if(hierarchy.m_Parent != entt::null && registry.valid(hierarchy.m_Parent))
-            {
-                auto parent_hierarchy = registry.try_get<HierarchyComponent>(hierarchy.m_Parent);
-                if(parent_hierarchy != nullptr)
-                {
-                    parent_hierarchy->m_First = hierarchy.m_Next;
-                    if(hierarchy.m_Next != entt::null)
-                    {
-                        auto next_hierarchy = registry.try_get<HierarchyComponent>(hierarchy.m_Next);
-                        if(next_hierarchy != nullptr)
-                        {
-                            next_hierarchy->m_Prev = entt::null;
-                        }
-                    }
-                }
-            }
+            prevHierarchy->m_Next = hierarchy.m_Next;
         }
-        else
+        else if(parentHierarchy != nullptr)
         {
-            auto prev_hierarchy = registry.try_get<HierarchyComponent>(hierarchy.m_Prev);
-            if(prev_hierarchy != nullptr)
-            {
-                prev_hierarchy->m_Next = hierarchy.m_Next;
-            }
-            if(hierarchy.m_Next != entt::null)
-            {
-                auto next_hierarchy = registry.try_get<HierarchyComponent>(hierarchy.m_Next);
-                if(next_hierarchy != nullptr)
-                {
-                    next_hierarchy->m_Prev = hierarchy.m_Prev;
-                }
-            }
+            parentHierarchy->m_First = hierarchy.m_Next;
+        }
+
+        if(nextHierarchy != nullptr)
+        {
+            nextHierarchy->m_Prev = hierarchy.m_Prev;
+        }
+        else if(parentHierarchy != nullptr)
+        {
+            parentHierarchy->m_Last = hierarchy.m_Prev;
+        }
+
+        if(parentHierarchy != nullptr && parentHierarchy->m_ChildCount > 0)
+        {
+            parentHierarchy->m_ChildCount--;
         }
     }
     void HierarchyComponent::OnUpdate(entt::registry& registry, entt::entity entity)
@@ -108,10 +92,30 @@ namespace Coffee {
         
     }
 
+    // Reparenting an entity under one of its descendants would turn the hierarchy into a cycle
+    static bool IsDescendantOrSelf(entt::registry& registry, entt::entity entity, entt::entity ancestor)
+    {
+        while(entity != entt::null)
+        {
+            if(entity == ancestor)
+            {
+                return true;
+            }
+            entity = registry.get<HierarchyComponent>(entity).m_Parent;
+        }
+        return false;
+    }
+
     void HierarchyComponent::Reparent(entt::registry& registry, entt::entity entity, entt::entity parent)
     {
         ZoneScoped;
-        
+
+        if(parent != entt::null && IsDescendantOrSelf(registry, parent, entity))
+        {
+            COFFEE_CORE_ERROR("HierarchyComponent::Reparent: Cannot make an entity a child of itself or of one of its descendants");
+            return;
+        }
+
         auto hierarchyComponent = registry.try_get<HierarchyComponent>(entity);
 
         HierarchyComponent::OnDestroy(registry, entity);
@@ -125,6 +129,90 @@ namespace Coffee {
             hierarchyComponent->m_Parent = parent;
             HierarchyComponent::OnConstruct(registry, entity);
         }
+
+        // Let the listeners (the SceneTree) know the hierarchy changed.
+        registry.patch<HierarchyComponent>(entity);
+    }
+
+    void HierarchyComponent::AttachChildren(entt::registry& registry, entt::entity parent, std::span<const entt::entity> children)
+    {
+        ZoneScoped;
+
+        auto& parentHierarchy = registry.get<HierarchyComponent>(parent);
+
+        for(entt::entity child : children)
+        {
+            if(IsDescendantOrSelf(registry, parent, child))
+            {
+                COFFEE_CORE_ERROR("HierarchyComponent::AttachChildren: Cannot make an entity a child of itself or of one of its descendants");
+                continue;
+            }
+
+            auto& hierarchy = registry.get<HierarchyComponent>(child);
+            if(hierarchy.m_Parent != entt::null)
+            {
+                OnDestroy(registry, child);
+            }
+
+            hierarchy.m_Parent = parent;
+            hierarchy.m_Next = entt::null;
+            hierarchy.m_Prev = parentHierarchy.m_Last;
+
+            if(parentHierarchy.m_Last == entt::null)
+            {
+                parentHierarchy.m_First = child;
+            }
+            else
+            {
+                registry.get<HierarchyComponent>(parentHierarchy.m_Last).m_Next = child;
+            }
+            parentHierarchy.m_Last = child;
+            parentHierarchy.m_ChildCount++;
+
+            registry.patch<HierarchyComponent>(child);
+        }
+    }
+
+    void HierarchyComponent::DetachChildren(entt::registry& registry, std::span<const entt::entity> children)
+    {
+        ZoneScoped;
+
+        for(entt::entity child : children)
+        {
+            auto& hierarchy = registry.get<HierarchyComponent>(child);
+            if(hierarchy.m_Parent == entt::null)
+            {
+                continue;
+            }
+
+            OnDestroy(registry, child);
+
+            hierarchy.m_Parent = entt::null;
+            hierarchy.m_Next = entt::null;
+            hierarchy.m_Prev = entt::null;
+
+            registry.patch<HierarchyComponent>(child);
+        }
+    }
+
+    void HierarchyComponent::RebuildChildLinks(entt::registry& registry)
+    {
+        ZoneScoped;
+
+        auto& hierarchies = registry.storage<HierarchyComponent>();
+
+        for(auto [entity, hierarchy] : hierarchies.each())
+        {
+            hierarchy.m_Last = entt::null;
+            hierarchy.m_ChildCount = 0;
+
+            for(entt::entity child = hierarchy.m_First; child != entt::null; child = hierarchies.get(child).m_Next)
+            {
+                hierarchies.get(child).m_Prev = hierarchy.m_Last;
+                hierarchy.m_Last = child;
+                hierarchy.m_ChildCount++;
+            }
+        }
     }
 
     SceneTree::SceneTree(Scene* scene) : m_Context(scene)
@@ -133,51 +221,198 @@ namespace Coffee {
         registry.on_construct<HierarchyComponent>().connect<&HierarchyComponent::OnConstruct>();
         registry.on_update<HierarchyComponent>().connect<&HierarchyComponent::OnUpdate>();
         registry.on_destroy<HierarchyComponent>().connect<&HierarchyComponent::OnDestroy>();
+
+        registry.on_construct<HierarchyComponent>().connect<&SceneTree::OnHierarchyChanged>(this);
+        registry.on_update<HierarchyComponent>().connect<&SceneTree::OnHierarchyChanged>(this);
+        registry.on_destroy<HierarchyComponent>().connect<&SceneTree::OnHierarchyChanged>(this);
+
+        registry.on_construct<TransformComponent>().connect<&SceneTree::OnTransformChanged>(this);
+        registry.on_update<TransformComponent>().connect<&SceneTree::OnTransformChanged>(this);
     }
 
-    void SceneTree::Update()
+    SceneTree::~SceneTree()
     {
         auto& registry = m_Context->m_Registry;
-        auto view = registry.view<HierarchyComponent>();
-        for(auto entity : view)
-        {
-            const auto hierarchy = registry.get<HierarchyComponent>(entity);
+        registry.on_construct<HierarchyComponent>().disconnect(this);
+        registry.on_update<HierarchyComponent>().disconnect(this);
+        registry.on_destroy<HierarchyComponent>().disconnect(this);
+        registry.on_construct<TransformComponent>().disconnect(this);
+        registry.on_update<TransformComponent>().disconnect(this);
+    }
+
+    void SceneTree::OnHierarchyChanged(entt::registry& registry, entt::entity entity)
+    {
+        m_NodesDirty = true;
+    }
+
+    void SceneTree::OnTransformChanged(entt::registry& registry, entt::entity entity)
+    {
+        m_TransformsDirty = true;
+    }
+
+    void SceneTree::RebuildNodes()
+    {
+        ZoneScoped;
+
+        auto& registry = m_Context->m_Registry;
+        auto& hierarchies = registry.storage<HierarchyComponent>();
 
+        m_Nodes.clear();
+        m_Nodes.reserve(hierarchies.size());
+
+        for(auto [entity, hierarchy] : hierarchies.each())
+        {
             if(hierarchy.m_Parent == entt::null)
             {
-                UpdateTransform(entity);
+                m_Nodes.push_back({entity, InvalidIndex});
             }
         }
+
+        // Breadth first, one level at a time: the children of a level are appended after it, so parents always
+        // come before their children and every level is a contiguous range of the array.
+        m_Levels.clear();
+        m_Levels.push_back(0);
+
+        uint32_t levelBegin = 0;
+        uint32_t levelEnd = static_cast<uint32_t>(m_Nodes.size());
+        while(levelBegin < levelEnd)
+        {
+            m_Levels.push_back(levelEnd);
+
+            for(uint32_t i = levelBegin; i < levelEnd; i++)
+            {
+                entt::entity child = hierarchies.get(m_Nodes[i].Entity).m_First;
+                while(child != entt::null)
+                {
+                    m_Nodes.push_back({child, i});
+                    child = hierarchies.get(child).m_Next;
+                }
+            }
+
+            levelBegin = levelEnd;
+            levelEnd = static_cast<uint32_t>(m_Nodes.size());
+        }
+
+        m_Store.Resize(m_Nodes.size());
+        m_LocalDirty.assign(m_Store.GetSize() + TransformStore::BlockSize, 0);
+        m_NodeChanged.resize(m_Nodes.size());
+        m_NodesDirty = false;
     }
 
-    void SceneTree::UpdateTransform(entt::entity entity)
+    void SceneTree::Update()
     {
+        ZoneScoped;
+        COFFEE_MEMORY_TAG(MemoryTag::Scene);
+
         auto& registry = m_Context->m_Registry;
-        
-        auto& hierarchyComponent = registry.get<HierarchyComponent>(entity);
-        auto& transformComponent = registry.get<TransformComponent>(entity);
 
-        // Update the world transform of the entity
+        m_ChangedTransforms.clear();
 
-        if(hierarchyComponent.m_Parent != entt::null)
+        // The size check catches hierarchies changed without going through the signals, e.g. a registry clear.
+        const bool rebuilt = m_NodesDirty || m_Nodes.size() != registry.storage<HierarchyComponent>().size();
+        if(rebuilt)
         {
-            auto& parentTransformComponent = registry.get<TransformComponent>(hierarchyComponent.m_Parent);
-
-            transformComponent.SetWorldTransform(parentTransformComponent.GetWorldTransform());
+            RebuildNodes();
         }
-        else
+
+        // Nothing moved: no transform became dirty since the last update, in this scene or any other. Read before
+        // the pass, so a transform dirtied while it runs is picked up next frame.
+        const uint32_t dirtyCount = TransformComponent::GetDirtyCount();
+        if(!rebuilt && !m_TransformsDirty && dirtyCount == m_SeenDirtyCount)
         {
-            transformComponent.SetWorldTransform(glm::mat4(1.0f));
+            return;
         }
+        m_SeenDirtyCount = dirtyCount;
+        m_TransformsDirty = false;
+
+        auto& transforms = registry.storage<TransformComponent>();
+
+        const uint32_t nodeCount = static_cast<uint32_t>(m_Nodes.size());
+        const bool parallel = m_Parallel && JobSystem::GetWorkerCount() > 0;
+
+        // Runs a function over batches of a range, across the job system when it is worth it
+        const auto forRange = [parallel](uint32_t count, const JobSystem::RangeFn& func) {
+            if(parallel && count >= ParallelMinLevelSize)
+            {
+                JobSystem::DispatchAndWait(count, ParallelBatchSize, func);
+            }
+            else
+            {
+                func(0, count);
+            }
+        };
+
+        // Copy the dirty façades into the store. Euler angles are only converted to quaternions here.
+        forRange(nodeCount, [&](uint32_t begin, uint32_t end) {
+            for(uint32_t i = begin; i < end; i++)
+            {
+                const auto& transformComponent = transforms.get(m_Nodes[i].Entity);
+                const bool dirty = rebuilt || transformComponent.IsDirty();
+
+                m_LocalDirty[i] = dirty;
+                if(dirty)
+                {
+                    m_Store.SetLocal(i, transformComponent.Position, glm::quat(glm::radians(transformComponent.Rotation)), transformComponent.Scale);
+                }
+            }
+        });
+
+        // The batches start on multiples of ParallelBatchSize, so they never split a SIMD block
+        forRange(nodeCount, [&](uint32_t begin, uint32_t end) {
+            m_Store.ComposeLocalMatrices(m_LocalDirty.data(), begin, end);
+        });
 
-        // Recursively update all the children
+        // Every node only writes its own transform and flag, and only reads its parent's, which belongs to an
+        // earlier level. So the nodes of a level can be updated in any order and on any thread without locks.
+        const auto updateNodes = [&](uint32_t begin, uint32_t end) {
+            for(uint32_t i = begin; i < end; i++)
+            {
+                const Node& node = m_Nodes[i];
+                const bool changed = m_LocalDirty[i] || (node.Parent != InvalidIndex && m_NodeChanged[node.Parent]);
+
+                m_NodeChanged[i] = changed;
+                if(!changed)
+                {
+                    continue;
+                }
+
+                if(node.Parent == InvalidIndex)
+                {
+                    m_Store.SetWorldFromLocal(i);
+                }
+                else
+                {
+                    m_Store.SetWorldFromParent(i, node.Parent);
+                }
+
+                auto& transformComponent = transforms.get(node.Entity);
+                transformComponent.worldMatrix = m_Store.GetWorldMatrix(i);
+                transformComponent.dirty = false;
+            }
+        };
 
-        entt::entity child = hierarchyComponent.m_First;
-        while(child != entt::null)
+        for(size_t level = 0; level + 1 < m_Levels.size(); level++)
         {
-            UpdateTransform(child);
-            child = registry.get<HierarchyComponent>(child).m_Next;
+            const uint32_t begin = m_Levels[level];
+            const uint32_t end = m_Levels[level + 1];
+
+            // Small levels cost less than waking the workers
+            forRange(end - begin, [&](uint32_t first, uint32_t last) { updateNodes(begin + first, begin + last); });
+        }
+
+        for(size_t i = 0; i < m_Nodes.size(); i++)
+        {
+            if(m_NodeChanged[i])
+            {
+                m_ChangedTransforms.push_back(m_Nodes[i].Entity);
+            }
         }
     }
 
+    void SceneTree::UpdateTransform(entt::entity entity)
+    {
+        // The world matrices are only written by Update, which keeps the TransformStore in sync with the components
+        m_Context->m_Registry.get<TransformComponent>(entity).MarkDirty();
+    }
+
 }
\ No newline at end of file
@@ -1,9 +1,13 @@
 #pragma once
 
 #include "CoffeeEngine/Core/Base.h"
+#include "CoffeeEngine/Scene/TransformStore.h"
 #include "entt/entity/fwd.hpp"
 #include <cereal/cereal.hpp>
 #include <entt/entt.hpp>
+#include <cstdint>
+#include <span>
+#include <vector>
 
 namespace Coffee {
 
@@ -60,10 +64,34 @@ namespace Coffee {
          */
         static void Reparent(entt::registry& registry, entt::entity entity, entt::entity parent);
 
+        /**
+         * @brief Append many entities to the children of a parent, detaching them from their current parent first.
+         * @param registry The entity registry.
+         * @param parent The new parent entity.
+         * @param children The entities to attach, in order.
+         */
+        static void AttachChildren(entt::registry& registry, entt::entity parent, std::span<const entt::entity> children);
+
+        /**
+         * @brief Detach many entities from their parents, turning them into roots.
+         * @param registry The entity registry.
+         * @param children The entities to detach.
+         */
+        static void DetachChildren(entt::registry& registry, std::span<const entt::entity> children);
+
+        /**
+         * @brief Recompute the last child, child count and previous sibling links from the first child and next
+         * sibling links, which are the only ones stored in scene files.
+         * @param registry The entity registry.
+         */
+        static void RebuildChildLinks(entt::registry& registry);
+
         entt::entity m_Parent;
         entt::entity m_First;
+        entt::entity m_Last; ///< The last child, so appending a child doesn't walk the list. Not serialized.
         entt::entity m_Next;
         entt::entity m_Prev;
+        uint32_t m_ChildCount; ///< Not serialized.
 
         /**
          * @brief Serialize the component.
@@ -101,23 +129,95 @@ namespace Coffee {
         SceneTree(Scene* scene);
 
         /**
-         * @brief Default destructor.
+         * @brief Destructor. Disconnects from the registry signals.
          */
-        ~SceneTree() = default;
+        ~SceneTree();
 
         /**
-         * @brief Update the scene tree.
+         * @brief Update the world transform of every entity in the scene tree.
+         *
+         * The nodes are kept in a flat array sorted by depth, so every parent is updated before its children in one
+         * linear pass. The array is only rebuilt when a HierarchyComponent is added, removed or reparented.
+         * Only dirty transforms and the descendants of changed nodes are recomputed.
+         *
+         * The dirty transforms are copied into a TransformStore, their local matrices are composed several at a
+         * time with SIMD kernels and the world matrices are copied back to the TransformComponents.
+         *
+         * In parallel mode, the levels of the hierarchy are processed one after the other and the nodes of each
+         * large level are split across the job system.
          */
         void Update();
 
         /**
-         * @brief Update the transform of an entity.
+         * @brief Enable or disable the parallel update. Enabled by default.
+         * @param parallel True to split large hierarchy levels across the job system workers.
+         */
+        void SetParallel(bool parallel) { m_Parallel = parallel; }
+
+        /**
+         * @brief Check whether the parallel update is enabled.
+         * @return True if large hierarchy levels are updated across the job system workers.
+         */
+        bool IsParallel() const { return m_Parallel; }
+
+        /**
+         * @brief Get the entities whose world transform changed in the last Update.
+         * @return The entities, parents before their children.
+         */
+        const std::vector<entt::entity>& GetChangedTransforms() const { return m_ChangedTransforms; }
+
+        /**
+         * @brief Mark the transform of an entity dirty, so it and its descendants are recomputed on the next Update.
          * @param entity The entity to update.
          */
         void UpdateTransform(entt::entity entity);
 
     private:
+        /**
+         * @brief Marks the flat node array as outdated. Connected to the HierarchyComponent signals.
+         * @param registry The entity registry.
+         * @param entity The entity whose hierarchy changed.
+         */
+        void OnHierarchyChanged(entt::registry& registry, entt::entity entity);
+
+        /**
+         * @brief Forces the next Update to look at the transforms. Connected to the TransformComponent signals, for
+         * components that are added or replaced already dirty.
+         * @param registry The entity registry.
+         * @param entity The entity whose transform was added or replaced.
+         */
+        void OnTransformChanged(entt::registry& registry, entt::entity entity);
+
+        /**
+         * @brief Rebuilds the flat node array from the hierarchy, breadth first from the roots.
+         */
+        void RebuildNodes();
+
+    private:
+        static constexpr uint32_t InvalidIndex = UINT32_MAX;
+        static constexpr uint32_t ParallelMinLevelSize = 4096; ///< Smaller levels are updated on the calling thread.
+        static constexpr uint32_t ParallelBatchSize = 1024; ///< Nodes per job in parallel mode.
+
+        /**
+         * @brief An entity of the flattened hierarchy.
+         */
+        struct Node
+        {
+            entt::entity Entity;
+            uint32_t Parent; ///< Index of the parent node, always lower than the node's own index. InvalidIndex for roots.
+        };
+
         Scene* m_Context;
+        std::vector<Node> m_Nodes; ///< Parents come before their children.
+        std::vector<uint32_t> m_Levels; ///< Index of the first node of every depth, followed by the node count.
+        TransformStore m_Store; ///< The transform of every node, in node order.
+        std::vector<uint8_t> m_LocalDirty; ///< Whether the local transform of each node changed, padded like the store.
+        std::vector<uint8_t> m_NodeChanged; ///< Whether the world transform of each node changed in the last Update.
+        std::vector<entt::entity> m_ChangedTransforms;
+        bool m_NodesDirty = true;
+        bool m_TransformsDirty = true; ///< Whether a transform was added or replaced since the last Update.
+        uint32_t m_SeenDirtyCount = 0; ///< TransformComponent::GetDirtyCount() at the start of the last Update.
+        bool m_Parallel = true;
     };
 
     /** @} */ // end of scene group
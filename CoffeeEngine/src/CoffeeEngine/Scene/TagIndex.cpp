@@ -0,0 +1,105 @@
+#include "TagIndex.h"
+
+#include "CoffeeEngine/Scene/Components.h"
+
+namespace Coffee {
+
+    TagIndex::TagIndex(entt::registry& registry) : m_Registry(registry)
+    {
+        for(auto [entity, tag] : registry.storage<TagComponent>().each())
+        {
+            Insert(entity, tag.Tag);
+        }
+
+        registry.on_construct<TagComponent>().connect<&TagIndex::OnConstruct>(this);
+        registry.on_update<TagComponent>().connect<&TagIndex::OnUpdate>(this);
+        registry.on_destroy<TagComponent>().connect<&TagIndex::OnDestroy>(this);
+    }
+
+    TagIndex::~TagIndex()
+    {
+        m_Registry.on_construct<TagComponent>().disconnect(this);
+        m_Registry.on_update<TagComponent>().disconnect(this);
+        m_Registry.on_destroy<TagComponent>().disconnect(this);
+    }
+
+    entt::entity TagIndex::Find(std::string_view name) const
+    {
+        auto it = m_Entities.find(name);
+        return it != m_Entities.end() ? it->second.front() : entt::null;
+    }
+
+    std::span<const entt::entity> TagIndex::FindAll(std::string_view name) const
+    {
+        auto it = m_Entities.find(name);
+        if(it == m_Entities.end())
+        {
+            return {};
+        }
+        return it->second;
+    }
+
+    void TagIndex::Insert(entt::entity entity, const std::string& name)
+    {
+        auto [it, inserted] = m_Entities.try_emplace(name);
+        if(inserted)
+        {
+            // The keys of an unordered_map don't move on rehash, so the views stay valid until the name is erased
+            m_SortedNames.insert(it->first);
+        }
+        m_IndexedNames[entity] = IndexedName{it->first, it->second.size()};
+        it->second.push_back(entity);
+    }
+
+    void TagIndex::Remove(entt::entity entity)
+    {
+        auto indexed = m_IndexedNames.find(entity);
+        if(indexed == m_IndexedNames.end())
+        {
+            return;
+        }
+
+        auto it = m_Entities.find(indexed->second.Name);
+        auto& entities = it->second;
+        // Swap with the last entity, so many entities sharing a name don't make removals quadratic
+        const size_t position = indexed->second.Position;
+        if(position + 1 != entities.size())
+        {
+            entities[position] = entities.back();
+            m_IndexedNames[entities[position]].Position = position;
+        }
+        entities.pop_back();
+
+        if(entities.empty())
+        {
+            m_SortedNames.erase(it->first);
+            m_Entities.erase(it);
+        }
+        m_IndexedNames.erase(indexed);
+    }
+
+    void TagIndex::OnConstruct(entt::registry& registry, entt::entity entity)
+    {
+        Insert(entity, registry.get<TagComponent>(entity).Tag);
+    }
+
+    void TagIndex::OnUpdate(entt::registry& registry, entt::entity entity)
+    {
+        const std::string& name = registry.get<TagComponent>(entity).Tag;
+
+        auto indexed = m_IndexedNames.find(entity);
+        if(indexed != m_IndexedNames.end() && indexed->second.Name == name)
+        {
+            return;
+        }
+
+        Remove(entity);
+        Insert(entity, name);
+    }
+
+    void TagIndex::OnDestroy(entt::registry& registry, entt::entity entity)
+    {
+        Remove(entity);
+    }
+
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include <functional>
+#include <set>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Coffee {
+
+    /**
+     * @defgroup scene Scene
+     * @{
+     */
+
+    /**
+     * @brief Index from TagComponent names to the entities that carry them.
+     *
+     * Kept current by the TagComponent construct, update and destroy signals, so a tag must be changed with
+     * registry.patch (or Entity::SetName) to be reindexed. Several entities may share a name; they are kept in the
+     * order they got it, except that when one loses it (rename or destruction) the last one takes its place, so
+     * removals stay O(1). Lookups take string views and return views into the index, so they don't allocate.
+     */
+    class TagIndex
+    {
+      public:
+        /**
+         * @brief Connects to the TagComponent signals and indexes the tags already in the registry.
+         * @param registry The entity registry.
+         */
+        TagIndex(entt::registry& registry);
+
+        /**
+         * @brief Destructor. Disconnects from the registry signals.
+         */
+        ~TagIndex();
+
+        TagIndex(const TagIndex&) = delete;
+        TagIndex& operator=(const TagIndex&) = delete;
+
+        /**
+         * @brief Finds the first entity with a name, in FindAll order.
+         * @param name The name.
+         * @return The entity, or entt::null if no entity has that name.
+         */
+        entt::entity Find(std::string_view name) const;
+
+        /**
+         * @brief Gets every entity with a name.
+         * @param name The name.
+         * @return The entities, in the order described in the class comment. Valid until the next tag change.
+         */
+        std::span<const entt::entity> FindAll(std::string_view name) const;
+
+        /**
+         * @brief Calls a function for every entity whose name starts with a prefix, in name order.
+         * @param prefix The prefix.
+         * @param function The function, called with the entity.
+         */
+        template<typename Function>
+        void ForEachWithPrefix(std::string_view prefix, Function&& function) const
+        {
+            for(auto it = m_SortedNames.lower_bound(prefix); it != m_SortedNames.end() && it->starts_with(prefix); ++it)
+            {
+                for(entt::entity entity : m_Entities.find(*it)->second)
+                {
+                    function(entity);
+                }
+            }
+        }
+
+      private:
+        /**
+         * @brief Where an entity is indexed.
+         */
+        struct IndexedName
+        {
+            std::string_view Name; ///< View of the m_Entities key.
+            size_t Position; ///< Index of the entity in the vector of that name.
+        };
+
+        struct NameHash
+        {
+            using is_transparent = void;
+            size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+        };
+
+        void Insert(entt::entity entity, const std::string& name);
+        void Remove(entt::entity entity);
+
+        void OnConstruct(entt::registry& registry, entt::entity entity);
+        void OnUpdate(entt::registry& registry, entt::entity entity);
+        void OnDestroy(entt::registry& registry, entt::entity entity);
+
+      private:
+        entt::registry& m_Registry;
+
+        std::unordered_map<std::string, std::vector<entt::entity>, NameHash, std::equal_to<>> m_Entities;
+        std::set<std::string_view, std::less<>> m_SortedNames; ///< Views of the m_Entities keys, for prefix queries.
+        std::unordered_map<entt::entity, IndexedName> m_IndexedNames; ///< Where each entity is indexed.
+    };
+
+    /** @} */ // end of scene group
+}
@@ -0,0 +1,265 @@
+#include "TransformStore.h"
+
+#include "SDL3/SDL_cpuinfo.h"
+
+#include <algorithm>
+
+// SSE2 is part of x86-64, AVX is only used when the CPU reports it
+#if defined(__x86_64__) || defined(_M_X64)
+#define COFFEE_TRANSFORM_SIMD 1
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define COFFEE_TARGET_AVX __attribute__((target("avx")))
+#else
+#define COFFEE_TARGET_AVX
+#endif
+
+namespace Coffee {
+
+    namespace
+    {
+        struct TRSArrays
+        {
+            const float* PositionX;
+            const float* PositionY;
+            const float* PositionZ;
+            const float* RotationX;
+            const float* RotationY;
+            const float* RotationZ;
+            const float* RotationW;
+            const float* ScaleX;
+            const float* ScaleY;
+            const float* ScaleZ;
+            glm::mat4* Local;
+        };
+
+        // Every kernel uses the expressions of glm::mat3_cast, so they match GetLocalTransform
+
+#ifdef COFFEE_TRANSFORM_SIMD
+        // Turns one column of 4 transforms, given as 4 registers holding one row each, into 4 stored columns
+        inline void StoreColumn(glm::mat4* out, int column, __m128 r0, __m128 r1, __m128 r2, __m128 r3)
+        {
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            _mm_storeu_ps(&out[0][column][0], r0);
+            _mm_storeu_ps(&out[1][column][0], r1);
+            _mm_storeu_ps(&out[2][column][0], r2);
+            _mm_storeu_ps(&out[3][column][0], r3);
+        }
+
+        void ComposeSSE(const TRSArrays& a, size_t i, glm::mat4* out)
+        {
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 two = _mm_set1_ps(2.0f);
+            const __m128 zero = _mm_setzero_ps();
+
+            const __m128 x = _mm_loadu_ps(a.RotationX + i);
+            const __m128 y = _mm_loadu_ps(a.RotationY + i);
+            const __m128 z = _mm_loadu_ps(a.RotationZ + i);
+            const __m128 w = _mm_loadu_ps(a.RotationW + i);
+            const __m128 sx = _mm_loadu_ps(a.ScaleX + i);
+            const __m128 sy = _mm_loadu_ps(a.ScaleY + i);
+            const __m128 sz = _mm_loadu_ps(a.ScaleZ + i);
+
+            const __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+            const __m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+            const __m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+
+            StoreColumn(out, 0,
+                        _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx),
+                        _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx),
+                        _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx),
+                        zero);
+            StoreColumn(out, 1,
+                        _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy),
+                        _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy),
+                        _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy),
+                        zero);
+            StoreColumn(out, 2,
+                        _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz),
+                        _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz),
+                        _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz),
+                        zero);
+            StoreColumn(out, 3, _mm_loadu_ps(a.PositionX + i), _mm_loadu_ps(a.PositionY + i),
+                        _mm_loadu_ps(a.PositionZ + i), one);
+        }
+
+        COFFEE_TARGET_AVX inline void StoreColumnAVX(glm::mat4* out, int column, __m256 r0, __m256 r1, __m256 r2, __m256 r3)
+        {
+            StoreColumn(out, column, _mm256_castps256_ps128(r0), _mm256_castps256_ps128(r1),
+                        _mm256_castps256_ps128(r2), _mm256_castps256_ps128(r3));
+            StoreColumn(out + 4, column, _mm256_extractf128_ps(r0, 1), _mm256_extractf128_ps(r1, 1),
+                        _mm256_extractf128_ps(r2, 1), _mm256_extractf128_ps(r3, 1));
+        }
+
+        COFFEE_TARGET_AVX void ComposeAVX(const TRSArrays& a, size_t i, glm::mat4* out)
+        {
+            const __m256 one = _mm256_set1_ps(1.0f);
+            const __m256 two = _mm256_set1_ps(2.0f);
+            const __m256 zero = _mm256_setzero_ps();
+
+            const __m256 x = _mm256_loadu_ps(a.RotationX + i);
+            const __m256 y = _mm256_loadu_ps(a.RotationY + i);
+            const __m256 z = _mm256_loadu_ps(a.RotationZ + i);
+            const __m256 w = _mm256_loadu_ps(a.RotationW + i);
+            const __m256 sx = _mm256_loadu_ps(a.ScaleX + i);
+            const __m256 sy = _mm256_loadu_ps(a.ScaleY + i);
+            const __m256 sz = _mm256_loadu_ps(a.ScaleZ + i);
+
+            const __m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y), zz = _mm256_mul_ps(z, z);
+            const __m256 xy = _mm256_mul_ps(x, y), xz = _mm256_mul_ps(x, z), yz = _mm256_mul_ps(y, z);
+            const __m256 wx = _mm256_mul_ps(w, x), wy = _mm256_mul_ps(w, y), wz = _mm256_mul_ps(w, z);
+
+            StoreColumnAVX(out, 0,
+                           _mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(yy, zz))), sx),
+                           _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xy, wz)), sx),
+                           _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xz, wy)), sx),
+                           zero);
+            StoreColumnAVX(out, 1,
+                           _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xy, wz)), sy),
+                           _mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, zz))), sy),
+                           _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(yz, wx)), sy),
+                           zero);
+            StoreColumnAVX(out, 2,
+                           _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xz, wy)), sz),
+                           _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(yz, wx)), sz),
+                           _mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, yy))), sz),
+                           zero);
+            StoreColumnAVX(out, 3, _mm256_loadu_ps(a.PositionX + i), _mm256_loadu_ps(a.PositionY + i),
+                           _mm256_loadu_ps(a.PositionZ + i), one);
+        }
+
+        void ComposeBlocksSSE(const TRSArrays& a, const uint8_t* dirty, size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i += 4)
+            {
+                if (dirty[i] | dirty[i + 1] | dirty[i + 2] | dirty[i + 3])
+                    ComposeSSE(a, i, a.Local + i);
+            }
+        }
+
+        COFFEE_TARGET_AVX void ComposeBlocksAVX(const TRSArrays& a, const uint8_t* dirty, size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i += 8)
+            {
+                if (dirty[i] | dirty[i + 1] | dirty[i + 2] | dirty[i + 3] | dirty[i + 4] | dirty[i + 5] | dirty[i + 6] | dirty[i + 7])
+                    ComposeAVX(a, i, a.Local + i);
+            }
+        }
+#else
+        void ComposeScalar(const TRSArrays& a, size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                const float x = a.RotationX[i], y = a.RotationY[i], z = a.RotationZ[i], w = a.RotationW[i];
+                const float xx = x * x, yy = y * y, zz = z * z;
+                const float xy = x * y, xz = x * z, yz = y * z;
+                const float wx = w * x, wy = w * y, wz = w * z;
+
+                glm::mat4& m = a.Local[i];
+                m[0] = glm::vec4((1.0f - 2.0f * (yy + zz)) * a.ScaleX[i], 2.0f * (xy + wz) * a.ScaleX[i], 2.0f * (xz - wy) * a.ScaleX[i], 0.0f);
+                m[1] = glm::vec4(2.0f * (xy - wz) * a.ScaleY[i], (1.0f - 2.0f * (xx + zz)) * a.ScaleY[i], 2.0f * (yz + wx) * a.ScaleY[i], 0.0f);
+                m[2] = glm::vec4(2.0f * (xz + wy) * a.ScaleZ[i], 2.0f * (yz - wx) * a.ScaleZ[i], (1.0f - 2.0f * (xx + yy)) * a.ScaleZ[i], 0.0f);
+                m[3] = glm::vec4(a.PositionX[i], a.PositionY[i], a.PositionZ[i], 1.0f);
+            }
+        }
+
+        void ComposeBlocksScalar(const TRSArrays& a, const uint8_t* dirty, size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                if (dirty[i])
+                    ComposeScalar(a, i, i + 1);
+            }
+        }
+#endif
+
+        using ComposeBlocksFn = void (*)(const TRSArrays&, const uint8_t*, size_t, size_t);
+
+        struct Kernel
+        {
+            ComposeBlocksFn Compose;
+            const char* Name;
+        };
+
+        const Kernel& GetKernel()
+        {
+            static const Kernel kernel = []() -> Kernel {
+#ifdef COFFEE_TRANSFORM_SIMD
+                if (SDL_HasAVX())
+                    return {&ComposeBlocksAVX, "AVX"};
+                return {&ComposeBlocksSSE, "SSE"};
+#else
+                return {&ComposeBlocksScalar, "Scalar"};
+#endif
+            }();
+            return kernel;
+        }
+    } // namespace
+
+    void TransformStore::Resize(size_t count)
+    {
+        m_Size = count;
+
+        // Padding entries are composed with the rest of their block, keep them a valid identity transform
+        const size_t padded = (count + BlockSize - 1) / BlockSize * BlockSize;
+        m_PositionX.resize(padded, 0.0f);
+        m_PositionY.resize(padded, 0.0f);
+        m_PositionZ.resize(padded, 0.0f);
+        m_RotationX.resize(padded, 0.0f);
+        m_RotationY.resize(padded, 0.0f);
+        m_RotationZ.resize(padded, 0.0f);
+        m_RotationW.resize(padded, 1.0f);
+        m_ScaleX.resize(padded, 1.0f);
+        m_ScaleY.resize(padded, 1.0f);
+        m_ScaleZ.resize(padded, 1.0f);
+        m_LocalMatrices.resize(padded, glm::mat4(1.0f));
+        m_WorldMatrices.resize(padded, glm::mat4(1.0f));
+    }
+
+    void TransformStore::ComposeLocalMatrices(const uint8_t* dirty, size_t begin, size_t end)
+    {
+        const TRSArrays arrays = {m_PositionX.data(), m_PositionY.data(), m_PositionZ.data(),
+                                  m_RotationX.data(), m_RotationY.data(), m_RotationZ.data(), m_RotationW.data(),
+                                  m_ScaleX.data(), m_ScaleY.data(), m_ScaleZ.data(), m_LocalMatrices.data()};
+
+        end = std::min(end, m_LocalMatrices.size());
+        if (begin < end)
+            GetKernel().Compose(arrays, dirty, begin, end);
+    }
+
+    void TransformStore::SetWorldFromParent(size_t index, size_t parent)
+    {
+#ifdef COFFEE_TRANSFORM_SIMD
+        // Column j of the result is the parent's columns weighted by column j of the local matrix,
+        // in the same order as glm's operator*
+        const float* a = &m_WorldMatrices[parent][0][0];
+        const float* b = &m_LocalMatrices[index][0][0];
+        float* out = &m_WorldMatrices[index][0][0];
+
+        const __m128 a0 = _mm_loadu_ps(a);
+        const __m128 a1 = _mm_loadu_ps(a + 4);
+        const __m128 a2 = _mm_loadu_ps(a + 8);
+        const __m128 a3 = _mm_loadu_ps(a + 12);
+
+        for (int j = 0; j < 4; j++)
+        {
+            const float* column = b + j * 4;
+            __m128 result = _mm_mul_ps(a0, _mm_set1_ps(column[0]));
+            result = _mm_add_ps(result, _mm_mul_ps(a1, _mm_set1_ps(column[1])));
+            result = _mm_add_ps(result, _mm_mul_ps(a2, _mm_set1_ps(column[2])));
+            result = _mm_add_ps(result, _mm_mul_ps(a3, _mm_set1_ps(column[3])));
+            _mm_storeu_ps(out + j * 4, result);
+        }
+#else
+        m_WorldMatrices[index] = m_WorldMatrices[parent] * m_LocalMatrices[index];
+#endif
+    }
+
+    const char* TransformStore::GetKernelName()
+    {
+        return GetKernel().Name;
+    }
+
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Coffee {
+
+    /**
+     * @defgroup scene Scene
+     * @{
+     */
+
+    /**
+     * @brief Structure-of-arrays storage of the transforms updated by the SceneTree.
+     *
+     * Positions, rotations (as quaternions) and scales are kept one array per component, so the kernels can load
+     * the same component of 4 (SSE) or 8 (AVX) transforms with one instruction. The local and world matrices are
+     * packed contiguously. The TransformComponent stays the editable façade: the SceneTree copies its dirty values
+     * in with SetLocal and copies the world matrices back out.
+     *
+     * Every array is padded to a multiple of BlockSize, so the kernels never need a scalar tail.
+     */
+    class TransformStore
+    {
+      public:
+        static constexpr size_t BlockSize = 8; ///< The widest kernel, in transforms.
+
+        /**
+         * @brief Resizes the store. The contents of the existing entries are kept.
+         * @param count The number of transforms.
+         */
+        void Resize(size_t count);
+
+        /**
+         * @brief Gets the number of transforms.
+         * @return The number of transforms, without the padding.
+         */
+        size_t GetSize() const { return m_Size; }
+
+        /**
+         * @brief Sets the local components of a transform. The local matrix is updated by ComposeLocalMatrices.
+         * @param index The index of the transform.
+         * @param position The position.
+         * @param rotation The rotation.
+         * @param scale The scale.
+         */
+        void SetLocal(size_t index, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale)
+        {
+            m_PositionX[index] = position.x;
+            m_PositionY[index] = position.y;
+            m_PositionZ[index] = position.z;
+            m_RotationX[index] = rotation.x;
+            m_RotationY[index] = rotation.y;
+            m_RotationZ[index] = rotation.z;
+            m_RotationW[index] = rotation.w;
+            m_ScaleX[index] = scale.x;
+            m_ScaleY[index] = scale.y;
+            m_ScaleZ[index] = scale.z;
+        }
+
+        /**
+         * @brief Builds the local matrices (translate * rotate * scale) of a range of transforms.
+         *
+         * Blocks of BlockSize transforms without any flagged entry are skipped, the others are composed whole.
+         *
+         * @param dirty One flag per transform, non-zero for the transforms to compose, padded like the store.
+         * @param begin The first transform, a multiple of BlockSize.
+         * @param end One past the last transform, clamped to the padded size.
+         */
+        void ComposeLocalMatrices(const uint8_t* dirty, size_t begin, size_t end);
+
+        const glm::mat4& GetLocalMatrix(size_t index) const { return m_LocalMatrices[index]; }
+        const glm::mat4& GetWorldMatrix(size_t index) const { return m_WorldMatrices[index]; }
+
+        /**
+         * @brief Sets the world matrix of a transform to its local matrix, for roots.
+         * @param index The index of the transform.
+         */
+        void SetWorldFromLocal(size_t index) { m_WorldMatrices[index] = m_LocalMatrices[index]; }
+
+        /**
+         * @brief Sets the world matrix of a transform to the world matrix of its parent times its local matrix.
+         * @param index The index of the transform.
+         * @param parent The index of the parent, already up to date.
+         */
+        void SetWorldFromParent(size_t index, size_t parent);
+
+        /**
+         * @brief Tells which kernel ComposeLocalMatrices uses on this CPU.
+         * @return "AVX", "SSE" or "Scalar".
+         */
+        static const char* GetKernelName();
+
+      private:
+        size_t m_Size = 0;
+
+        std::vector<float> m_PositionX, m_PositionY, m_PositionZ;
+        std::vector<float> m_RotationX, m_RotationY, m_RotationZ, m_RotationW;
+        std::vector<float> m_ScaleX, m_ScaleY, m_ScaleZ;
+
+        std::vector<glm::mat4> m_LocalMatrices;
+        std::vector<glm::mat4> m_WorldMatrices;
+    };
+
+    /** @} */ // end of scene group
+}
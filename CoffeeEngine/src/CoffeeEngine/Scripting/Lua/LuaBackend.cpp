@@ -4,7 +4,10 @@
 #include "CoffeeEngine/Core/KeyCodes.h"
 #include "CoffeeEngine/Core/ControllerCodes.h"
 #include "CoffeeEngine/Core/Log.h"
+#include "CoffeeEngine/Core/MemoryTracker.h"
 #include "CoffeeEngine/Core/MouseCodes.h"
+#include "CoffeeEngine/Core/TimerWheel.h"
+#include <cstdlib>
 #include <fstream>
 #include <lua.h>
 #include <regex>
@@ -19,7 +22,51 @@
 
 namespace Coffee {
 
-    sol::state LuaBackend::luaState;
+    // Lua allocates through this instead of operator new, so the state is charged to Scripting here.
+    static void* LuaAllocate(void*, void* ptr, size_t oldSize, size_t newSize)
+    {
+        // Without a block, oldSize is the type of the object being created, not a size.
+        if (!ptr)
+            oldSize = 0;
+
+        if (newSize == 0)
+        {
+            if (ptr)
+                MemoryTracker::OnFree(MemoryTag::Scripting, ptr, oldSize);
+            std::free(ptr);
+            return nullptr;
+        }
+
+        void* newPtr = std::realloc(ptr, newSize);
+        if (!newPtr)
+            return nullptr; // Lua keeps the old block.
+
+        if (ptr)
+            MemoryTracker::OnFree(MemoryTag::Scripting, ptr, oldSize);
+        MemoryTracker::OnAllocate(MemoryTag::Scripting, newPtr, newSize);
+        return newPtr;
+    }
+
+    sol::state LuaBackend::luaState(sol::default_at_panic, &LuaAllocate);
+
+    // What the transform getters hand to scripts: a copy of the vector that also writes its members through to the
+    // component, so transform.position.x = 1 moves the entity and marks it dirty. Reading never marks it dirty.
+    struct TransformVector3 : glm::vec3
+    {
+        TransformComponent* Owner;
+        glm::vec3 TransformComponent::* Member;
+
+        TransformVector3(TransformComponent& owner, glm::vec3 TransformComponent::* member)
+            : glm::vec3(owner.*member), Owner(&owner), Member(member) {}
+
+        template<glm::length_t Index>
+        static void Set(TransformVector3& self, float value)
+        {
+            self[Index] = value;
+            (self.Owner->*self.Member)[Index] = value;
+            self.Owner->MarkDirty();
+        }
+    };
 
     void BindKeyCodesToLua(sol::state& lua, sol::table& inputTable)
     {
@@ -355,6 +402,8 @@ namespace Coffee {
 
 
     void LuaBackend::Initialize() {
+        COFFEE_MEMORY_TAG(MemoryTag::Scripting);
+
         luaState.open_libraries(sol::lib::base, sol::lib::math, sol::lib::string, sol::lib::table);
 
         # pragma region Bind Log Functions
@@ -406,9 +455,6 @@ namespace Coffee {
         luaState["Input"] = inputTable;
         # pragma endregion
 
-        # pragma region Bind Timer Functions
-        # pragma endregion
-
         # pragma region Bind GLM Functions
         luaState.new_usertype<glm::vec2>("Vector2",
             sol::constructors<glm::vec2(), glm::vec2(float), glm::vec2(float, float)>(),
@@ -449,6 +495,15 @@ namespace Coffee {
             //TODO: Add more functions
         );
 
+        // Usable anywhere a Vector3 is expected; only the member writes differ
+        luaState.new_usertype<TransformVector3>("TransformVector3",
+            sol::no_constructor,
+            sol::base_classes, sol::bases<glm::vec3>(),
+            "x", sol::property([](const TransformVector3& self) { return self.x; }, &TransformVector3::Set<0>),
+            "y", sol::property([](const TransformVector3& self) { return self.y; }, &TransformVector3::Set<1>),
+            "z", sol::property([](const TransformVector3& self) { return self.z; }, &TransformVector3::Set<2>)
+        );
+
         luaState.new_usertype<glm::vec4>("Vector4",
             sol::constructors<glm::vec4(), glm::vec4(float), glm::vec4(float, float, float, float)>(),
             "x", &glm::vec4::x,
@@ -576,6 +631,9 @@ namespace Coffee {
             "get_prev_sibling", &Entity::GetPrevSibling,
             "get_child", &Entity::GetChild,
             "get_children", &Entity::GetChildren,
+            "set_name", &Entity::SetName,
+            // On the entity, the local transform is computed from the parent's world transform
+            "set_world_transform", &Entity::SetWorldTransform,
             "is_valid", [](Entity* self) { return static_cast<bool>(*self); }
         );
         #pragma endregion
@@ -583,18 +641,18 @@ namespace Coffee {
         # pragma region Bind Components Functions
         luaState.new_usertype<TagComponent>("TagComponent",
             sol::constructors<TagComponent(), TagComponent(const std::string&)>(),
-            "tag", &TagComponent::Tag
+            // Read only, renames go through entity:set_name so the scene's tag index sees them
+            "tag", sol::readonly(&TagComponent::Tag)
         );
 
         luaState.new_usertype<TransformComponent>("TransformComponent",
             sol::constructors<TransformComponent(), TransformComponent(const glm::vec3&)>(),
-            "position", &TransformComponent::Position,
-            "rotation", &TransformComponent::Rotation,
-            "scale", &TransformComponent::Scale,
+            "position", sol::property([](TransformComponent& self) { return TransformVector3(self, &TransformComponent::Position); }, &TransformComponent::SetPosition),
+            "rotation", sol::property([](TransformComponent& self) { return TransformVector3(self, &TransformComponent::Rotation); }, &TransformComponent::SetRotation),
+            "scale", sol::property([](TransformComponent& self) { return TransformVector3(self, &TransformComponent::Scale); }, &TransformComponent::SetScale),
             "get_local_transform", &TransformComponent::GetLocalTransform,
             "set_local_transform", &TransformComponent::SetLocalTransform,
-            "get_world_transform", &TransformComponent::GetWorldTransform,
-            "set_world_transform", &TransformComponent::SetWorldTransform
+            "get_world_transform", &TransformComponent::GetWorldTransform
         );
 
         luaState.new_usertype<CameraComponent>("CameraComponent",
@@ -646,18 +704,96 @@ namespace Coffee {
             "create_entity", &Scene::CreateEntity,
             "destroy_entity", &Scene::DestroyEntity,
             "get_entity_by_name", &Scene::GetEntityByName,
-            "get_all_entities", &Scene::GetAllEntities
+            "get_entities_by_name", [](Scene& self, std::string_view name) {
+                std::vector<Entity> entities;
+                for(entt::entity entity : self.GetEntitiesByName(name))
+                    entities.push_back(Entity{entity, &self});
+                return entities;
+            },
+            "get_entities_by_name_prefix", [](Scene& self, std::string_view prefix) {
+                std::vector<Entity> entities;
+                self.ForEachEntityWithNamePrefix(prefix, [&](entt::entity entity) { entities.push_back(Entity{entity, &self}); });
+                return entities;
+            },
+            "get_all_entities", [](Scene& self) {
+                // Scripts may keep the result around, so copy it out of the frame arena.
+                FrameVector<Entity> entities = self.GetAllEntities();
+                return std::vector<Entity>(entities.begin(), entities.end());
+            }
         );
 
         # pragma endregion
 
     }
 
+    sol::table LuaBackend::CreateTimerTable(std::vector<TimerWheel::TimerID>& timers) const
+    {
+        sol::table timerTable = luaState.create_table();
+
+        // Timers fire on the main thread once per frame, before the scripts update. Errors are logged instead of
+        // propagated, as the callback runs outside of any script call.
+        auto makeTimerCallback = [](sol::protected_function callback) {
+            return [callback]() {
+                sol::protected_function_result result = callback();
+                if (!result.valid())
+                {
+                    sol::error error = result;
+                    COFFEE_CORE_ERROR("Lua: Timer callback failed: {0}", error.what());
+                }
+            };
+        };
+
+        // The script cancels the timers it scheduled when it is destroyed or the runtime stops. Finished timers are
+        // dropped whenever the list would grow, so scripts that keep scheduling don't accumulate ids.
+        auto track = [&timers](TimerWheel::TimerID id) {
+            if (timers.size() == timers.capacity())
+                std::erase_if(timers, [](TimerWheel::TimerID timer) { return !TimerWheel::IsActive(timer); });
+            timers.push_back(id);
+            return id;
+        };
+
+        timerTable.set_function("after", [makeTimerCallback, track](double delay, sol::protected_function callback) {
+            return track(TimerWheel::Schedule(delay, makeTimerCallback(callback)));
+        });
+
+        timerTable.set_function("every", [makeTimerCallback, track](double period, sol::protected_function callback) {
+            return track(TimerWheel::Schedule(period, makeTimerCallback(callback), period));
+        });
+
+        timerTable.set_function("cancel", [](TimerWheel::TimerID id) {
+            TimerWheel::Cancel(id);
+        });
+
+        timerTable.set_function("pause", [](TimerWheel::TimerID id) {
+            TimerWheel::Pause(id);
+        });
+
+        timerTable.set_function("resume", [](TimerWheel::TimerID id) {
+            TimerWheel::Resume(id);
+        });
+
+        timerTable.set_function("is_active", [](TimerWheel::TimerID id) {
+            return TimerWheel::IsActive(id);
+        });
+
+        timerTable.set_function("is_paused", [](TimerWheel::TimerID id) {
+            return TimerWheel::IsPaused(id);
+        });
+
+        timerTable.set_function("get_time_left", [](TimerWheel::TimerID id) {
+            return TimerWheel::GetTimeLeft(id);
+        });
+
+        return timerTable;
+    }
+
     Ref<Script> LuaBackend::CreateScript(const std::filesystem::path& path) {
+        COFFEE_MEMORY_TAG(MemoryTag::Scripting);
         return CreateRef<LuaScript>(path);
     }
 
     void LuaBackend::ExecuteScript(Script& script) {
+        COFFEE_MEMORY_TAG(MemoryTag::Scripting);
         LuaScript& luaScript = static_cast<LuaScript&>(const_cast<Script&>(script));
         try {
             luaState.script_file(luaScript.GetPath().string(), luaScript.GetEnvironment());
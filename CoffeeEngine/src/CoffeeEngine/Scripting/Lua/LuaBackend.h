@@ -1,8 +1,10 @@
 #pragma once
+#include "CoffeeEngine/Core/TimerWheel.h"
 #include "CoffeeEngine/Scripting/IScriptingBackend.h"
 
 #include <sol/sol.hpp>
 #include <string>
+#include <vector>
 
 namespace Coffee {
 
@@ -17,6 +19,13 @@ namespace Coffee {
 
             sol::state& GetLuaState() const { return luaState; }
 
+            /**
+             * @brief Creates the Timer table of a script.
+             * @param timers The list the IDs of the timers scheduled from the table are added to. Must outlive the table.
+             * @return The table, with the after, every, cancel, pause, resume, is_active, is_paused and get_time_left functions.
+             */
+            sol::table CreateTimerTable(std::vector<TimerWheel::TimerID>& timers) const;
+
             void Shutdown() override {}
         private:
             static sol::state luaState;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CoffeeEngine/Core/Log.h"
+#include "CoffeeEngine/Core/MemoryTracker.h"
 #include "CoffeeEngine/Scene/Entity.h"
 #include "CoffeeEngine/Scripting/Lua/LuaBackend.h"
 #include "CoffeeEngine/Scripting/Script.h"
@@ -21,11 +22,25 @@ namespace Coffee {
             //TODO: Think if this is a good way or store it in another way is better
             const LuaBackend& backend = static_cast<const LuaBackend&>(ScriptManager::GetBackend(ScriptingLanguage::Lua));
             m_Environment = sol::environment(backend.GetLuaState(), sol::create, backend.GetLuaState().globals());
+            m_Environment["Timer"] = backend.CreateTimerTable(m_Timers);
+        }
+        ~LuaScript() { CancelTimers(); }
+
+        LuaScript(const LuaScript&) = delete;
+        LuaScript& operator=(const LuaScript&) = delete;
+
+        // Cancels every timer the script scheduled, so no callback runs after the script stops
+        void CancelTimers()
+        {
+            for (TimerWheel::TimerID id : m_Timers)
+                TimerWheel::Cancel(id);
+            m_Timers.clear();
         }
-        ~LuaScript() = default;
 
         void OnReady() override
         {
+            COFFEE_MEMORY_TAG(MemoryTag::Scripting);
+
             ScriptManager::ExecuteScript(*this, ScriptingLanguage::Lua);
             const sol::protected_function& onReady = m_Environment["on_ready"];
             if (!onReady.valid()) {
@@ -44,6 +59,8 @@ namespace Coffee {
 
         void OnUpdate(float dt) override
         {
+            COFFEE_MEMORY_TAG(MemoryTag::Scripting);
+
             const sol::protected_function& onUpdate = m_Environment["on_update"];
             if (!onUpdate.valid()) {
                 COFFEE_CORE_ERROR("Lua: on_update function is not valid.");
@@ -59,6 +76,8 @@ namespace Coffee {
 
         void OnExit() override
         {
+            COFFEE_MEMORY_TAG(MemoryTag::Scripting);
+
             const sol::protected_function& onExit = m_Environment["on_exit"];
             if (!onExit.valid()) {
                 COFFEE_CORE_ERROR("Lua: on_exit function is not valid.");
@@ -220,6 +239,7 @@ namespace Coffee {
         }
     private:
         sol::environment m_Environment;
+        std::vector<TimerWheel::TimerID> m_Timers; // Timers scheduled from the script's Timer table
     };
 
 }
\ No newline at end of file
@@ -297,6 +297,7 @@ TagComponent = {
     Tag = ""
 }
 
+-- position, rotation and scale return copies, but writing their x, y or z also updates the transform
 TransformComponent = {
     Position = {0.0, 0.0, 0.0},
     Rotation = {0.0, 0.0, 0.0},
@@ -311,9 +312,6 @@ TransformComponent = {
     GetWorldTransform = function()
         -- Implementation here
         return {}
-    end,
-    SetWorldTransform = function(transform)
-        -- Implementation here
     end
 }
 
@@ -364,6 +362,9 @@ Entity = {
     SetParent = function(self, parent)
         -- Implementation here
     end,
+    SetWorldTransform = function(self, transform)
+        -- Implementation here
+    end,
     IsValid = function(self)
         -- Implementation here
         return true
@@ -4,9 +4,57 @@
 #include <cstring>
 
 #ifdef __linux__
+#include <dirent.h>
+#include <sys/resource.h>
+#include <unistd.h>
 
 namespace Coffee {
 
+    /**
+     * Reads a /proc/.../stat file.
+     *
+     * @param path The path of the file.
+     * @param name Receives the command name, which may contain spaces and parentheses.
+     * @param fields Receives the fields after the name, starting with the state (field 3 in proc(5)).
+     * @param count The number of fields to read.
+     * @return True if the file could be read.
+     */
+    static bool ReadStatFile(const char* path, std::string* name, uint64_t* fields, int count)
+    {
+        FILE* file = fopen(path, "r");
+        if (file == nullptr)
+            return false;
+
+        char buffer[1024];
+        const size_t length = fread(buffer, 1, sizeof(buffer) - 1, file);
+        fclose(file);
+        buffer[length] = '\0';
+
+        // The name is between the first '(' and the last ')'.
+        const char* open = strchr(buffer, '(');
+        const char* close = strrchr(buffer, ')');
+        if (open == nullptr || close == nullptr || close < open)
+            return false;
+
+        if (name != nullptr)
+            name->assign(open + 1, close);
+
+        // Skip the state, which is a letter, then parse the numeric fields.
+        const char* p = close + 2;
+        while (*p != '\0' && *p != ' ')
+            p++;
+        fields[0] = 0;
+        for (int i = 1; i < count; i++)
+        {
+            char* end;
+            fields[i] = strtoull(p, &end, 10);
+            if (end == p)
+                return false;
+            p = end;
+        }
+        return true;
+    }
+
     uint32_t LinuxSystemInfo::GetPhysicalProcessorCountImpl() const
     {
         return 0;
@@ -50,5 +98,62 @@ namespace Coffee {
         return result;
     }
 
+
+    bool LinuxSystemInfo::GetProcessStatsImpl(ProcessStats& stats) const
+    {
+        // Indices are proc(5) field numbers minus 3: minflt (10), majflt (12), utime (14), stime (15), rss (24).
+        uint64_t fields[22];
+        if (!ReadStatFile("/proc/self/stat", nullptr, fields, 22))
+            return false;
+
+        static const double ticksPerSecond = static_cast<double>(sysconf(_SC_CLK_TCK));
+        static const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+
+        stats.PageFaults = fields[7];
+        stats.MajorPageFaults = fields[9];
+        stats.CPUTime = (fields[11] + fields[12]) / ticksPerSecond;
+        stats.ResidentBytes = fields[21] * pageSize;
+
+        // /proc/self/status only counts the context switches of the main thread, getrusage sums all of them.
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) == 0)
+        {
+            stats.ContextSwitches = usage.ru_nvcsw;
+            stats.InvoluntaryContextSwitches = usage.ru_nivcsw;
+        }
+        return true;
+    }
+
+    void LinuxSystemInfo::GetThreadCPUTimesImpl(std::vector<ThreadCPUTime>& threads) const
+    {
+        threads.clear();
+
+        DIR* directory = opendir("/proc/self/task");
+        if (directory == nullptr)
+            return;
+
+        static const double ticksPerSecond = static_cast<double>(sysconf(_SC_CLK_TCK));
+
+        while (dirent* entry = readdir(directory))
+        {
+            if (entry->d_name[0] < '0' || entry->d_name[0] > '9')
+                continue;
+
+            ThreadCPUTime thread;
+            thread.ThreadID = strtoull(entry->d_name, nullptr, 10);
+
+            char path[64];
+            snprintf(path, sizeof(path), "/proc/self/task/%llu/stat", static_cast<unsigned long long>(thread.ThreadID));
+
+            uint64_t fields[13];
+            if (!ReadStatFile(path, &thread.Name, fields, 13))
+                continue; // The thread exited in the meantime.
+
+            thread.CPUTime = (fields[11] + fields[12]) / ticksPerSecond;
+            threads.push_back(std::move(thread));
+        }
+        closedir(directory);
+    }
+
 }
 #endif
\ No newline at end of file
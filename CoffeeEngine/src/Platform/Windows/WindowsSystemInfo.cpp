@@ -3,6 +3,7 @@
 #ifdef _WIN32
 #include <Windows.h>
 #include <Psapi.h>
+#include <TlHelp32.h>
 
 namespace Coffee {
 
@@ -28,5 +29,73 @@ namespace Coffee {
         return pmc.WorkingSetSize / 1024 / 1024; // Convert from Bytes to MB
     }
 
+
+    static double FileTimeToSeconds(const FILETIME& time)
+    {
+        // FILETIMEs count 100 ns intervals.
+        return ((static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime) / 1e7;
+    }
+
+    bool WindowsSystemInfo::GetProcessStatsImpl(ProcessStats& stats) const
+    {
+        PROCESS_MEMORY_COUNTERS pmc;
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+            return false;
+
+        // Windows doesn't tell soft and hard faults apart, nor expose context switch counts per process.
+        stats.ResidentBytes = pmc.WorkingSetSize;
+        stats.PageFaults = pmc.PageFaultCount;
+
+        FILETIME creation, exit, kernel, user;
+        if (GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+            stats.CPUTime = FileTimeToSeconds(kernel) + FileTimeToSeconds(user);
+        return true;
+    }
+
+    void WindowsSystemInfo::GetThreadCPUTimesImpl(std::vector<ThreadCPUTime>& threads) const
+    {
+        threads.clear();
+
+        HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+        if (snapshot == INVALID_HANDLE_VALUE)
+            return;
+
+        const DWORD processID = GetCurrentProcessId();
+        THREADENTRY32 entry;
+        entry.dwSize = sizeof(entry);
+        for (BOOL found = Thread32First(snapshot, &entry); found; found = Thread32Next(snapshot, &entry))
+        {
+            if (entry.th32OwnerProcessID != processID)
+                continue;
+
+            HANDLE handle = OpenThread(THREAD_QUERY_LIMITED_INFORMATION, FALSE, entry.th32ThreadID);
+            if (handle == nullptr)
+                continue;
+
+            ThreadCPUTime thread;
+            thread.ThreadID = entry.th32ThreadID;
+
+            FILETIME creation, exit, kernel, user;
+            if (GetThreadTimes(handle, &creation, &exit, &kernel, &user))
+                thread.CPUTime = FileTimeToSeconds(kernel) + FileTimeToSeconds(user);
+
+            PWSTR description = nullptr;
+            if (SUCCEEDED(GetThreadDescription(handle, &description)) && description != nullptr)
+            {
+                char name[64];
+                const int length = WideCharToMultiByte(CP_UTF8, 0, description, -1, name, sizeof(name), nullptr, nullptr);
+                if (length > 0)
+                    thread.Name = name;
+                LocalFree(description);
+            }
+            if (thread.Name.empty())
+                thread.Name = std::to_string(entry.th32ThreadID);
+
+            CloseHandle(handle);
+            threads.push_back(std::move(thread));
+        }
+        CloseHandle(snapshot);
+    }
+
 }
 #endif
\ No newline at end of file
@@ -11,6 +11,8 @@ namespace Coffee {
         uint64_t GetAvailableMemoryImpl() const override;
         uint64_t GetUsedMemoryImpl() const override;
         uint64_t GetProcessMemoryUsageImpl() const override;
+        bool GetProcessStatsImpl(ProcessStats& stats) const override;
+        void GetThreadCPUTimesImpl(std::vector<ThreadCPUTime>& threads) const override;
     };
 
 }
\ No newline at end of file
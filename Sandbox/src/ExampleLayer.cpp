@@ -183,6 +183,19 @@ void ExampleLayer::OnUpdate(float dt)
     model = glm::mat4(1.0f);
 }
 
+void ExampleLayer::OnAttach()
+{
+    m_EventSubscription = Coffee::Application::Get().GetEventBus().Subscribe(Coffee::EventType::MouseScrolled, [this](Coffee::Event& event) {
+        OnEvent(event);
+        return event.Handled;
+    });
+}
+
+void ExampleLayer::OnDetach()
+{
+    Coffee::Application::Get().GetEventBus().Unsubscribe(m_EventSubscription);
+}
+
 void ExampleLayer::OnEvent(Coffee::Event& event)
 {
     //COFFEE_TRACE("{0}", event);
@@ -7,15 +7,19 @@
 #include <CoffeeEngine/Renderer/Shader.h>
 #include <CoffeeEngine/Renderer/Texture.h>
 #include <CoffeeEngine/Core/Layer.h>
+#include <CoffeeEngine/Events/EventBus.h>
 
 class ExampleLayer : public Coffee::Layer
 {
 public:
     ExampleLayer();
 
+    void OnAttach() override;
+    void OnDetach() override;
+
     void OnUpdate(float dt) override;
 
-    void OnEvent(Coffee::Event& event);
+    void OnEvent(Coffee::Event& event) override;
 
     void OnImGuiRender();
 private:
@@ -32,4 +36,6 @@ private:
 
     Coffee::EditorCamera m_EditorCamera;
 
+    Coffee::EventBus::SubscriptionID m_EventSubscription = 0;
+
 };
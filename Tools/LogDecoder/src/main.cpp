@@ -0,0 +1,273 @@
+// Decodes the binary log files written by the engine when built with COFFEE_BINARY_LOG.
+//
+// Usage: LogDecoder <input.clog> [output.txt]
+
+#include "CoffeeEngine/Core/BinaryLogFormat.h"
+
+#include <fmt/args.h>
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace Coffee::BinaryLogFormat;
+
+namespace
+{
+    const char* LevelNames[] = {"trace", "debug", "info", "warning", "error", "critical", "off"};
+
+    // Format IDs are handed out in order and their records written soon after, so an ID far beyond the number of
+    // format records seen so far can only come from a corrupted block.
+    constexpr uint32_t FormatIDSlack = 4096;
+
+    struct Format
+    {
+        uint8_t Level = 0;
+        std::string LoggerName;
+        std::string Text;
+    };
+
+    struct Message
+    {
+        int64_t Time;
+        uint16_t Thread;
+        std::string Text;
+    };
+
+    /**
+     * Bounds-checked reader over a byte buffer. Reads past the end set Failed instead of throwing, so a
+     * truncated file (the engine crashed) still decodes up to its last complete record.
+     */
+    class Reader
+    {
+      public:
+        Reader(const char* data, size_t size) : m_Data(data), m_Size(size) {}
+
+        template<typename T>
+        T Read()
+        {
+            T value{};
+            if (!Check(sizeof(T)))
+                return value;
+
+            std::memcpy(&value, m_Data + m_Offset, sizeof(T));
+            m_Offset += sizeof(T);
+            return value;
+        }
+
+        std::string ReadString(size_t size)
+        {
+            if (!Check(size))
+                return {};
+
+            std::string text(m_Data + m_Offset, size);
+            m_Offset += size;
+            return text;
+        }
+
+        bool AtEnd() const { return m_Offset >= m_Size; }
+        bool Failed() const { return m_Failed; }
+
+      private:
+        bool Check(size_t size)
+        {
+            if (m_Failed || m_Size - m_Offset < size)
+                m_Failed = true;
+            return !m_Failed;
+        }
+
+        const char* m_Data;
+        size_t m_Size;
+        size_t m_Offset = 0;
+        bool m_Failed = false;
+    };
+
+    bool DecodeRecord(Reader& reader, const std::vector<Format>& formats, uint16_t thread, Message& message)
+    {
+        const uint32_t formatID = reader.Read<uint32_t>();
+        message.Time = reader.Read<int64_t>();
+        message.Thread = thread;
+        const uint8_t argCount = reader.Read<uint8_t>();
+
+        fmt::dynamic_format_arg_store<fmt::format_context> args;
+        for (uint8_t i = 0; i < argCount && !reader.Failed(); i++)
+        {
+            switch (reader.Read<ArgType>())
+            {
+                case ArgType::Bool: args.push_back(reader.Read<uint8_t>() != 0); break;
+                case ArgType::Char: args.push_back(reader.Read<char>()); break;
+                case ArgType::Int32: args.push_back(reader.Read<int32_t>()); break;
+                case ArgType::Int64: args.push_back(reader.Read<int64_t>()); break;
+                case ArgType::UInt32: args.push_back(reader.Read<uint32_t>()); break;
+                case ArgType::UInt64: args.push_back(reader.Read<uint64_t>()); break;
+                case ArgType::Float: args.push_back(reader.Read<float>()); break;
+                case ArgType::Double: args.push_back(reader.Read<double>()); break;
+                case ArgType::Pointer:
+                    args.push_back(reinterpret_cast<const void*>(static_cast<uintptr_t>(reader.Read<uint64_t>())));
+                    break;
+                case ArgType::String: args.push_back(reader.ReadString(reader.Read<uint32_t>())); break;
+                default: return false;
+            }
+        }
+
+        if (reader.Failed())
+            return false;
+
+        if (formatID >= formats.size())
+        {
+            message.Text = fmt::format("[unknown] ?: <unknown format {}>", formatID);
+            return true;
+        }
+
+        const Format& format = formats[formatID];
+
+        std::string text;
+        try
+        {
+            text = fmt::vformat(format.Text, args);
+        }
+        catch (const fmt::format_error& e)
+        {
+            text = fmt::format("<could not format \"{}\": {}>", format.Text, e.what());
+        }
+
+        message.Text = fmt::format("[{}] {}: {}", LevelNames[std::min<uint8_t>(format.Level, 6)], format.LoggerName, text);
+        return true;
+    }
+} // namespace
+
+int main(int argc, const char** argv)
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "Usage: %s <input.clog> [output.txt]\n", argv[0]);
+        return 1;
+    }
+
+    std::ifstream input(argv[1], std::ios::binary);
+    if (!input)
+    {
+        std::fprintf(stderr, "Could not open %s\n", argv[1]);
+        return 1;
+    }
+    const std::vector<char> file((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+    Reader reader(file.data(), file.size());
+
+    char magic[sizeof(Magic)];
+    for (char& c : magic)
+        c = reader.Read<char>();
+    if (reader.Failed() || std::memcmp(magic, Magic, sizeof(Magic)) != 0)
+    {
+        std::fprintf(stderr, "%s is not a binary log file\n", argv[1]);
+        return 1;
+    }
+
+    const uint32_t version = reader.Read<uint32_t>();
+    if (version != Version)
+    {
+        std::fprintf(stderr, "Unsupported binary log version %u (expected %u)\n", version, Version);
+        return 1;
+    }
+
+    // Gather the record stream of every thread; a record can be split between two chunks.
+    std::vector<Format> formats;
+    uint32_t formatCount = 0;
+    std::map<uint16_t, std::string> streams;
+    uint64_t dropped = 0;
+    bool complete = false;
+
+    while (!reader.AtEnd() && !reader.Failed() && !complete)
+    {
+        switch (reader.Read<BlockType>())
+        {
+            case BlockType::Format:
+            {
+                const uint32_t id = reader.Read<uint32_t>();
+                Format format;
+                format.Level = reader.Read<uint8_t>();
+                format.LoggerName = reader.ReadString(reader.Read<uint16_t>());
+                format.Text = reader.ReadString(reader.Read<uint32_t>());
+
+                if (id > formatCount + FormatIDSlack)
+                {
+                    std::fprintf(stderr, "Corrupted block, stopping\n");
+                    complete = true;
+                    break;
+                }
+                formatCount++;
+
+                if (id >= formats.size())
+                    formats.resize(id + 1);
+                formats[id] = std::move(format);
+                break;
+            }
+            case BlockType::Chunk:
+            {
+                const uint16_t thread = reader.Read<uint16_t>();
+                streams[thread] += reader.ReadString(reader.Read<uint32_t>());
+                break;
+            }
+            case BlockType::End:
+                dropped = reader.Read<uint64_t>();
+                complete = true;
+                break;
+            default:
+                std::fprintf(stderr, "Corrupted block, stopping\n");
+                complete = true;
+                break;
+        }
+    }
+
+    if (!complete)
+        std::fprintf(stderr, "The file is truncated, decoding what was written\n");
+
+    std::vector<Message> messages;
+    for (const auto& [thread, stream] : streams)
+    {
+        Reader records(stream.data(), stream.size());
+        while (!records.AtEnd())
+        {
+            Message message;
+            if (!DecodeRecord(records, formats, thread, message))
+                break;
+            messages.push_back(std::move(message));
+        }
+    }
+
+    // Threads were written one after the other, put the messages back in time order.
+    std::stable_sort(messages.begin(), messages.end(),
+                     [](const Message& a, const Message& b) { return a.Time < b.Time; });
+
+    std::FILE* output = argc > 2 ? std::fopen(argv[2], "w") : stdout;
+    if (!output)
+    {
+        std::fprintf(stderr, "Could not open %s\n", argv[2]);
+        return 1;
+    }
+
+    for (const Message& message : messages)
+    {
+        const std::time_t seconds = static_cast<std::time_t>(message.Time / 1000000000);
+        const int64_t milliseconds = (message.Time / 1000000) % 1000;
+        fmt::print(output, "[{:%Y-%m-%d %H:%M:%S}.{:03}] [thread {}] {}\n", fmt::localtime(seconds), milliseconds,
+                   message.Thread, message.Text);
+    }
+
+    if (dropped > 0)
+        fmt::print(output, "{} records were dropped because a thread buffer was full\n", dropped);
+
+    if (output != stdout)
+        std::fclose(output);
+
+    return 0;
+}
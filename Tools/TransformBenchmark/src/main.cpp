@@ -0,0 +1,140 @@
+// Compares the serial and the parallel SceneTree transform update on synthetic hierarchies.
+//
+// Usage: TransformBenchmark [iterations] [branching] [node counts...]
+// Defaults to 20 iterations and a branching factor of 4, on 10k, 100k and 1M nodes.
+
+#include "CoffeeEngine/Core/JobSystem.h"
+#include "CoffeeEngine/Core/Log.h"
+#include "CoffeeEngine/Scene/Components.h"
+#include "CoffeeEngine/Scene/Entity.h"
+#include "CoffeeEngine/Scene/Scene.h"
+#include "CoffeeEngine/Scene/SceneTree.h"
+#include "CoffeeEngine/Scene/TransformStore.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace Coffee;
+
+namespace
+{
+    /**
+     * Builds a complete tree in heap order: node i is the child of node (i - 1) / branching.
+     */
+    std::vector<Entity> BuildHierarchy(Scene& scene, uint32_t nodeCount, uint32_t branching)
+    {
+        std::vector<Entity> entities;
+        entities.reserve(nodeCount);
+
+        for (uint32_t i = 0; i < nodeCount; i++)
+        {
+            Entity entity = scene.CreateEntity("Node");
+
+            auto& transform = entity.GetComponent<TransformComponent>();
+            transform.SetPosition({1.0f, 0.5f * (i % 7), 0.0f});
+            transform.SetRotation({0.0f, 10.0f * (i % 36), 5.0f});
+            transform.SetScale(glm::vec3(1.0f + 0.01f * (i % 3)));
+
+            if (i > 0)
+                entity.SetParent(entities[(i - 1) / branching]);
+
+            entities.push_back(entity);
+        }
+        return entities;
+    }
+
+    /**
+     * Runs full updates, moving the root every time so every node is recomputed.
+     * @return The average time of an update in milliseconds.
+     */
+    double Measure(Scene& scene, Entity root, uint32_t iterations)
+    {
+        auto& rootTransform = root.GetComponent<TransformComponent>();
+        SceneTree& sceneTree = scene.GetSceneTree();
+
+        // The first update rebuilds the node array, keep it out of the measurement
+        sceneTree.Update();
+
+        double total = 0.0;
+        for (uint32_t i = 0; i < iterations; i++)
+        {
+            rootTransform.SetRotation({0.0f, static_cast<float>(i), 0.0f});
+
+            const auto start = std::chrono::steady_clock::now();
+            sceneTree.Update();
+            total += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        return total / iterations;
+    }
+} // namespace
+
+int main(int argc, const char** argv)
+{
+    uint32_t iterations = 20;
+    uint32_t branching = 4;
+    std::vector<uint32_t> nodeCounts = {10'000, 100'000, 1'000'000};
+
+    if (argc > 1)
+        iterations = std::max(std::atoi(argv[1]), 1);
+    if (argc > 2)
+        branching = std::max(std::atoi(argv[2]), 1);
+    if (argc > 3)
+    {
+        nodeCounts.clear();
+        for (int i = 3; i < argc; i++)
+            nodeCounts.push_back(std::max(std::atoi(argv[i]), 1));
+    }
+
+    Log::Init();
+
+    const uint32_t logicalCores = std::thread::hardware_concurrency();
+    JobSystem::Init(logicalCores > 1 ? logicalCores - 1 : 0);
+
+    std::printf("%u worker threads, %s kernels, branching factor %u, %u iterations\n\n", JobSystem::GetWorkerCount(),
+                TransformStore::GetKernelName(), branching, iterations);
+    std::printf("%10s %12s %14s %8s\n", "Nodes", "Serial (ms)", "Parallel (ms)", "Speedup");
+
+    bool matches = true;
+    for (uint32_t nodeCount : nodeCounts)
+    {
+        Scene scene;
+        std::vector<Entity> entities = BuildHierarchy(scene, nodeCount, branching);
+        SceneTree& sceneTree = scene.GetSceneTree();
+
+        sceneTree.SetParallel(false);
+        const double serial = Measure(scene, entities[0], iterations);
+
+        std::vector<glm::mat4> serialTransforms;
+        serialTransforms.reserve(entities.size());
+        for (Entity entity : entities)
+            serialTransforms.push_back(entity.GetComponent<TransformComponent>().GetWorldTransform());
+
+        sceneTree.SetParallel(true);
+        const double parallel = Measure(scene, entities[0], iterations);
+
+        // Both modes end on the same root rotation, so they have to produce the same matrices
+        for (size_t i = 0; i < entities.size(); i++)
+        {
+            const glm::mat4& transform = entities[i].GetComponent<TransformComponent>().GetWorldTransform();
+            if (std::memcmp(&transform, &serialTransforms[i], sizeof(glm::mat4)) != 0)
+            {
+                std::fprintf(stderr, "Node %zu differs between the serial and the parallel update\n", i);
+                matches = false;
+                break;
+            }
+        }
+
+        std::printf("%10u %12.3f %14.3f %7.2fx\n", nodeCount, serial, parallel, serial / parallel);
+    }
+
+    JobSystem::Shutdown();
+    Log::Shutdown();
+
+    return matches ? 0 : 1;
+}